@@ -56,7 +56,7 @@ const uint64_t kTimeoutInfinite = 0xFFFFFFFFFFFFFFFF;
 
 enum class StructType
 {
-    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc, SlangSessionExtendedDesc, RayTracingValidationDesc
+    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc, SlangSessionExtendedDesc, RayTracingValidationDesc, CPUDeviceExtendedDesc, PipelineSpecializationDesc
 };
 
 // TODO: Rename to Stage
@@ -2636,6 +2636,56 @@ public:
           0x8eccc8ec, 0x5c04, 0x4a51, { 0x99, 0x75, 0x13, 0xf8, 0xfe, 0xa1, 0x59, 0xf3 } \
     }
 
+struct PipelineSpecializationStats
+{
+    /// Number of specializations that have been requested but are not compiled yet.
+    GfxCount pendingCount;
+    /// Number of specialized pipelines that have been created.
+    GfxCount completedCount;
+    /// Number of specializations that failed to compile.
+    GfxCount failedCount;
+    /// Number of draws and dispatches that used the dynamic dispatch pipeline because their
+    /// specialized pipeline was not ready.
+    GfxCount fallbackCount;
+    /// Number of draws and dispatches that were skipped because their specialized pipeline
+    /// was not ready.
+    GfxCount skippedCount;
+};
+
+/// Identifies a specialization of a pipeline. `specializationArgs` are the types bound to the
+/// specialization parameters of the pipeline's program, in the order expected by
+/// `slang::IComponentType::specialize`.
+struct SpecializedPipelineKey
+{
+    IPipelineState* pipeline = nullptr;
+    const slang::SpecializationArg* specializationArgs = nullptr;
+    GfxCount specializationArgCount = 0;
+};
+
+// Controls and monitors the specialization of pipelines whose programs have specialization
+// parameters. See `PipelineSpecializationDesc` for how specializations that are not ready
+// yet are handled.
+class IPipelineSpecializer : public ISlangUnknown
+{
+public:
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        getPipelineSpecializationStats(PipelineSpecializationStats* outStats) = 0;
+
+    /// Start specializing the given pipelines, so that they are ready by the time a draw or
+    /// dispatch needs them. With `PipelineSpecializationMode::Synchronous` the pipelines are
+    /// specialized before this call returns.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        prewarmSpecializedPipelines(const SpecializedPipelineKey* keys, GfxCount keyCount) = 0;
+
+    /// Block until all pending specializations have been compiled and their pipelines created.
+    virtual SLANG_NO_THROW Result SLANG_MCALL waitForPipelineSpecializations() = 0;
+};
+
+#define SLANG_UUID_IPipelineSpecializer                                                  \
+    {                                                                                    \
+          0xab42220c, 0xf427, 0x4e3e, { 0x90, 0x50, 0x44, 0x20, 0xe0, 0xb4, 0x35, 0xc8 } \
+    }
+
 class IPipelineCreationAPIDispatcher : public ISlangUnknown
 {
 public:
@@ -2745,4 +2795,49 @@ struct RayTracingValidationDesc
     bool enableRaytracingValidation = false;
 };
 
+/// Configuration for the CPU device
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// The number of threads used to execute the thread groups of a compute dispatch.
+    /// 1 runs the whole dispatch on the calling thread. 0 uses one thread per hardware thread.
+    /// NOTE! Groups executing in parallel share `groupshared` variables, so kernels that use
+    /// group shared memory must be dispatched with a thread count of 1.
+    GfxCount dispatchThreadCount = 1;
+};
+
+/// How a draw or dispatch handles a pipeline whose specialization has not been compiled yet.
+///
+/// In the asynchronous modes, a background worker owned by the device calls into the device's
+/// Slang session (as returned by `IDevice::getSlangSession`) while the application keeps using
+/// the device. gfx serializes its own calls into the session with the worker, but a Slang session
+/// is not thread safe, so the application must not call into the session, or into the components
+/// and reflection obtained from it (including `IShaderProgram::findTypeByName`), while
+/// specializations may be pending. Call `IPipelineSpecializer::waitForPipelineSpecializations`
+/// first, or do that work before any pipeline is specialized. The worker locks the session for
+/// one call at a time, so a draw or dispatch that calls into the session while the worker is
+/// busy waits for at most the specialization or code generation of a single entry point.
+enum class PipelineSpecializationMode
+{
+    /// Specialize and compile the pipeline on the calling thread.
+    Synchronous,
+    /// Compile the pipeline on the background worker, and block until it is ready.
+    AsyncWait,
+    /// Compile the pipeline on the background worker. Until it is ready, use the pipeline
+    /// specialized with `__Dynamic` arguments, which dispatches interface calls at run time.
+    AsyncFallbackToDynamic,
+    /// Compile the pipeline on the background worker. Until it is ready, the draw or
+    /// dispatch is not recorded and returns `SLANG_E_PENDING`.
+    AsyncSkip,
+};
+
+/// Configuration for the specialization of pipelines.
+/// The asynchronous modes are supported by the D3D12, Vulkan and Metal devices. Other devices
+/// always specialize synchronously.
+struct PipelineSpecializationDesc
+{
+    StructType structType = StructType::PipelineSpecializationDesc;
+    PipelineSpecializationMode mode = PipelineSpecializationMode::Synchronous;
+};
+
 }
@@ -948,6 +948,13 @@ extern "C"
             // Deprecated
             ParameterBlocksUseRegisterSpaces,
 
+            IncrementalSimplification,  // bool, only re-simplify functions that changed in the previous iteration.
+            ReportPerfTrace,       // stringValue0: path to write a Chrome trace JSON of the compilation to.
+            DownstreamCache,       // stringValue0: directory to cache the output of downstream compilers in.
+            ReportDownstreamPassTime, // bool
+            ParallelSPIRVOptimization, // bool
+            SpecializationCache,   // bool, reuse specialized generic functions across the links of a target program.
+
             CountOfParsableOptions,
 
             // Used in parsed options only.
@@ -1580,6 +1587,22 @@ extern "C"
     };
     #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
+    /** An extension of ISlangProfiler with microsecond timings and a trace of each invocation.
+    Can be obtained by `queryInterface` on a profiler returned by `getCompileTimeProfile`.
+    */
+    struct ISlangProfilerExt : public ISlangProfiler
+    {
+        SLANG_COM_INTERFACE(0x96e29c40, 0xf2f7, 0x4a8e, { 0xb8, 0x89, 0xf0, 0x15, 0x23, 0x0c, 0x7a, 0x75 })
+
+            /** Get the total time spent in the entry, in microseconds. */
+        virtual SLANG_NO_THROW double SLANG_MCALL getEntryTimeUS(uint32_t index) = 0;
+            /** Get every recorded invocation in the Chrome trace event JSON format (readable by chrome://tracing
+            and Perfetto). Invocations are only recorded when the compile was run with the `-report-perf-trace`
+            option, otherwise the trace will contain no events. */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getChromeTrace(ISlangBlob** outBlob) = 0;
+    };
+    #define SLANG_UUID_ISlangProfilerExt ISlangProfilerExt::getTypeGuid()
+
     namespace slang {
     struct IGlobalSession;
     struct ICompileRequest;
@@ -2727,6 +2750,131 @@ extern "C"
     SLANG_API SlangReflectionVariableLayout* spReflection_getGlobalParamsVarLayout(
         SlangReflection* reflection);
 
+    /* Flat Reflection
+
+    A flat reflection blob holds the layout of a whole program in a form that can be queried
+    without any further calls into Slang, so it can be cached alongside compiled code and
+    memory mapped.
+
+    The blob starts with a `SlangFlatReflectionHeader`. Each table described by the header
+    is an array of its entry struct, starting `offset` bytes from the start of the blob (and
+    aligned to 8 bytes). Entries refer to other entries by their index in a table, and to
+    strings by their byte offset in the string table, where every distinct string is stored
+    once with a terminating 0. References that are not present are
+    `SLANG_FLAT_REFLECTION_INVALID_INDEX`. Values are in the byte order of the machine
+    that wrote the blob.
+
+    Lists of entries (such as the fields of a struct) are given as a `first` index and a
+    `count` of consecutive entries in a table.
+    */
+
+#define SLANG_FLAT_REFLECTION_MAGIC 0x46524c53 /* 'SLRF' */
+#define SLANG_FLAT_REFLECTION_VERSION 1
+#define SLANG_FLAT_REFLECTION_INVALID_INDEX 0xffffffffu
+
+    typedef struct SlangFlatReflectionTable
+    {
+        uint32_t offset;
+        uint32_t count;
+    } SlangFlatReflectionTable;
+
+    typedef struct SlangFlatReflectionHeader
+    {
+        uint32_t magic;                         ///< SLANG_FLAT_REFLECTION_MAGIC
+        uint32_t version;                       ///< SLANG_FLAT_REFLECTION_VERSION
+        uint32_t size;                          ///< Size of the whole blob in bytes
+        uint32_t globalParamsVarLayout;         ///< Index into varLayouts
+
+        uint32_t firstParameter;                ///< Global parameters in varLayouts
+        uint32_t parameterCount;
+
+        SlangFlatReflectionTable strings;       ///< char
+        SlangFlatReflectionTable typeLayouts;   ///< SlangFlatReflectionTypeLayout
+        SlangFlatReflectionTable varLayouts;    ///< SlangFlatReflectionVarLayout
+        SlangFlatReflectionTable sizes;         ///< SlangFlatReflectionSize
+        SlangFlatReflectionTable offsets;       ///< SlangFlatReflectionOffset
+        SlangFlatReflectionTable bindingRanges; ///< SlangFlatReflectionBindingRange
+        SlangFlatReflectionTable entryPoints;   ///< SlangFlatReflectionEntryPoint
+    } SlangFlatReflectionHeader;
+
+        /// The size of a type layout for one parameter category
+    typedef struct SlangFlatReflectionSize
+    {
+        uint32_t category;                      ///< SlangParameterCategory
+        uint32_t padding;
+        uint64_t size;
+    } SlangFlatReflectionSize;
+
+        /// The offset of a variable layout for one parameter category
+    typedef struct SlangFlatReflectionOffset
+    {
+        uint32_t category;                      ///< SlangParameterCategory
+        uint32_t space;
+        uint64_t offset;
+    } SlangFlatReflectionOffset;
+
+    typedef struct SlangFlatReflectionTypeLayout
+    {
+        uint64_t elementCount;                  ///< For arrays
+        uint64_t uniformStride;
+        uint32_t kind;                          ///< SlangTypeKind
+        uint32_t name;                          ///< String
+        uint32_t scalarType;                    ///< SlangScalarType
+        uint32_t rowCount;
+        uint32_t columnCount;
+        uint32_t resourceShape;                 ///< SlangResourceShape
+        uint32_t resourceAccess;                ///< SlangResourceAccess
+        uint32_t parameterCategory;             ///< SlangParameterCategory
+        int32_t uniformAlignment;
+        uint32_t elementTypeLayout;             ///< Index into typeLayouts
+        uint32_t elementVarLayout;              ///< Index into varLayouts, for parameter groups
+        uint32_t containerVarLayout;            ///< Index into varLayouts, for parameter groups
+        uint32_t firstField;                    ///< Fields in varLayouts
+        uint32_t fieldCount;
+        uint32_t firstSize;                     ///< Sizes for each category in sizes
+        uint32_t sizeCount;
+        uint32_t firstBindingRange;             ///< Binding ranges in bindingRanges
+        uint32_t bindingRangeCount;
+    } SlangFlatReflectionTypeLayout;
+
+    typedef struct SlangFlatReflectionVarLayout
+    {
+        uint32_t name;                          ///< String
+        uint32_t typeLayout;                    ///< Index into typeLayouts
+        uint32_t stage;                         ///< SlangStage
+        uint32_t semanticName;                  ///< String
+        uint32_t semanticIndex;
+        uint32_t firstOffset;                   ///< Offsets for each category in offsets
+        uint32_t offsetCount;
+        uint32_t padding;
+    } SlangFlatReflectionVarLayout;
+
+    typedef struct SlangFlatReflectionBindingRange
+    {
+        int64_t bindingCount;
+        uint32_t bindingType;                   ///< SlangBindingType
+        uint32_t leafTypeLayout;                ///< Index into typeLayouts
+        uint32_t leafVariableName;              ///< String
+        int32_t descriptorSetIndex;
+    } SlangFlatReflectionBindingRange;
+
+    typedef struct SlangFlatReflectionEntryPoint
+    {
+        uint32_t name;                          ///< String
+        uint32_t nameOverride;                  ///< String
+        uint32_t stage;                         ///< SlangStage
+        uint32_t varLayout;                     ///< Index into varLayouts
+        uint32_t resultVarLayout;               ///< Index into varLayouts
+        uint32_t firstParameter;                ///< Parameters in varLayouts
+        uint32_t parameterCount;
+        uint32_t threadGroupSize[3];
+    } SlangFlatReflectionEntryPoint;
+
+        /// Write the layout of the whole program to a flat reflection blob (see above)
+    SLANG_API SlangResult spReflection_writeFlatBinary(
+        SlangReflection* reflection,
+        ISlangBlob** outBlob);
+
 }
 #ifdef __cplusplus
 
@@ -3835,6 +3983,11 @@ namespace slang
         {
             return (VariableLayoutReflection*) spReflection_getGlobalParamsVarLayout((SlangReflection*) this);
         }
+
+        SlangResult writeFlatBinary(ISlangBlob** outBlob)
+        {
+            return spReflection_writeFlatBinary((SlangReflection*) this, outBlob);
+        }
     };
 
     
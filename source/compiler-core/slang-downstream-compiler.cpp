@@ -11,6 +11,7 @@
 #include "../core/slang-shared-library.h"
 #include "../core/slang-blob.h"
 #include "../core/slang-char-util.h"
+#include "../core/slang-math.h"
 
 #include "../core/slang-castable.h"
 
@@ -21,9 +22,52 @@
 #include "slang-artifact-helper.h"
 #include "slang-artifact-desc-util.h"
 
+#include <thread>
+
 namespace Slang
 {
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamProcessPool !!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+DownstreamProcessPool::DownstreamProcessPool()
+{
+    // hardware_concurrency can return 0 if the amount of threads can't be determined
+    m_maxCount = Math::Max(Count(std::thread::hardware_concurrency()), Count(1));
+}
+
+void DownstreamProcessPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_usedCount < m_maxCount; });
+    m_usedCount++;
+}
+
+void DownstreamProcessPool::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SLANG_ASSERT(m_usedCount > 0);
+        m_usedCount--;
+    }
+    m_condition.notify_one();
+}
+
+void DownstreamProcessPool::setMaxProcessCount(Count count)
+{
+    SLANG_ASSERT(count >= 1);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxCount = Math::Max(count, Count(1));
+    }
+    m_condition.notify_all();
+}
+
+/* static */DownstreamProcessPool* DownstreamProcessPool::getSingleton()
+{
+    static DownstreamProcessPool pool;
+    return &pool;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamCompilerBase !!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 
 SlangResult DownstreamCompilerBase::convert(IArtifact* from, const ArtifactDesc& to, IArtifact** outArtifact)
@@ -147,7 +191,10 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     }
 #endif
 
-    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    {
+        DownstreamProcessPool::Slot slot(DownstreamProcessPool::getSingleton());
+        SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    }
 
 #if 0
     {
@@ -17,6 +17,8 @@
 #include "slang-artifact-associated.h"
 
 #include <type_traits>
+#include <mutex>
+#include <condition_variable>
 
 namespace Slang
 {
@@ -257,6 +259,15 @@ struct DownstreamCompileOptions
 
     // The debug info format to use. 
     SlangDebugInfoFormat m_debugInfoFormat = SLANG_DEBUG_INFO_FORMAT_DEFAULT;
+
+    /// Text that the source is expected to start with, and that is the same between compilations (such as the
+    /// language prelude). Compilers that support precompiled headers may precompile it once, and compile the rest
+    /// of the source against the result. Can be empty.
+    TerminatedCharSlice sourcePrelude;
+
+    /// If set, compilers that run a sequence of optimization passes (such as spirv-opt) add an
+    /// info diagnostic for each pass, with the time it took and how it changed the output size.
+    bool reportPassTimes = false;
 };
 static_assert(std::is_trivially_copyable_v<DownstreamCompileOptions>);
 
@@ -343,6 +354,46 @@ public:
     Desc m_desc;
 };
 
+/* Bounds the number of downstream compiler processes that run at the same time.
+
+Compilations can be issued from many threads at once. Starting more processes than there are cores only
+adds contention, so processes wait for a free slot (by default there is one per hardware thread) before starting. */
+class DownstreamProcessPool
+{
+public:
+        /// Holds a slot for as long as it is in scope
+    struct Slot
+    {
+        Slot(DownstreamProcessPool* pool) : m_pool(pool) { m_pool->acquire(); }
+        ~Slot() { m_pool->release(); }
+
+        Slot(const Slot&) = delete;
+        void operator=(const Slot&) = delete;
+
+        DownstreamProcessPool* m_pool;
+    };
+
+        /// Waits until a slot is free, and then takes it
+    void acquire();
+        /// Releases a slot taken with acquire
+    void release();
+
+        /// Set the maximum amount of processes that can run at the same time. Must be at least 1.
+    void setMaxProcessCount(Count count);
+    Count getMaxProcessCount() const { return m_maxCount; }
+
+        /// Get the pool shared by all downstream compilers
+    static DownstreamProcessPool* getSingleton();
+
+    DownstreamProcessPool();
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    Count m_usedCount = 0;
+    Count m_maxCount = 1;
+};
+
 class CommandLineDownstreamCompiler : public DownstreamCompilerBase
 {
 public:
@@ -9,6 +9,10 @@
 #include "../core/slang-shared-library.h"
 #include "../core/slang-char-util.h"
 #include "../core/slang-string-slice-pool.h"
+#include "../core/slang-blob.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-process.h"
+#include "../core/slang-string-escape-util.h"
 
 #include "slang-artifact-desc-util.h"
 #include "slang-artifact-diagnostic-util.h"
@@ -458,12 +462,10 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
-/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+/* static */void GCCDownstreamCompilerUtil::calcCodeGenArgs(const CompileOptions& options, CommandLine& cmdLine)
 {
-    SLANG_ASSERT(options.modulePath.count);
-
     PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
-        
+
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
     if (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP)
@@ -529,11 +531,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         cmdLine.addArg("-g");
     }
 
-    if (options.flags & CompileOptions::Flag::Verbose)
-    {
-        cmdLine.addArg("-v");
-    }
-
     switch (options.floatingPointMode)
     {
         case FloatingPointMode::Default: break;
@@ -551,20 +548,11 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         }
     }
 
-    StringBuilder moduleFilePath; 
-    SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(targetDesc, asStringSlice(options.modulePath), moduleFilePath));
-    
-    cmdLine.addArg("-o");
-    cmdLine.addArg(moduleFilePath);
-
     switch (options.targetType)
     {
         case SLANG_SHADER_SHARED_LIBRARY:
         case SLANG_HOST_SHARED_LIBRARY:
         {
-            // Shared library
-            cmdLine.addArg("-shared");
-
             if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
             {
                 // Position independent
@@ -572,17 +560,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
             }
             break;
         }
-        case SLANG_HOST_EXECUTABLE:
-        {
-            cmdLine.addArg("-rdynamic");
-            break;
-        }
-        case SLANG_OBJECT_CODE:
-        {
-            // Don't link, just produce object file
-            cmdLine.addArg("-c");
-            break;
-        }
         default: break;
     }
 
@@ -607,6 +584,51 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         cmdLine.addArg("-I");
         cmdLine.addArg(asString(include));
     }
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.modulePath.count);
+
+    PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
+        
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    calcCodeGenArgs(options, cmdLine);
+
+    if (options.flags & CompileOptions::Flag::Verbose)
+    {
+        cmdLine.addArg("-v");
+    }
+
+    StringBuilder moduleFilePath; 
+    SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(targetDesc, asStringSlice(options.modulePath), moduleFilePath));
+    
+    cmdLine.addArg("-o");
+    cmdLine.addArg(moduleFilePath);
+
+    switch (options.targetType)
+    {
+        case SLANG_SHADER_SHARED_LIBRARY:
+        case SLANG_HOST_SHARED_LIBRARY:
+        {
+            // Shared library
+            cmdLine.addArg("-shared");
+            break;
+        }
+        case SLANG_HOST_EXECUTABLE:
+        {
+            cmdLine.addArg("-rdynamic");
+            break;
+        }
+        case SLANG_OBJECT_CODE:
+        {
+            // Don't link, just produce object file
+            cmdLine.addArg("-c");
+            break;
+        }
+        default: break;
+    }
 
     // Link options
     if (0) // && options.targetType != TargetType::Object)
@@ -627,6 +649,12 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         }
     }
 
+    // Arguments that are specific to the compiler, such as a header to include before the source
+    for (const auto& arg : options.compilerSpecificArguments)
+    {
+        cmdLine.addArg(asString(arg));
+    }
+
     // Files to compile, need to be on the file system.
     for (IArtifact* sourceArtifact : options.sourceArtifacts)
     {
@@ -695,6 +723,215 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!*/
+
+SlangResult GCCDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(inOptions))
+    {
+        // Not possible to compile with this version of the interface.
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    CompileOptions options = getCompatibleVersion(&inOptions);
+
+    // If the source starts with the prelude, we compile the rest of the source, and make the
+    // compiler include the precompiled prelude ahead of it.
+    //
+    // If any step fails we just compile the source as is, as the precompiled header is only
+    // an optimization.
+    ComPtr<IArtifact> sourceArtifact;
+    String preludeHeaderPath;
+    List<TerminatedCharSlice> compilerSpecificArguments;
+
+    if (SLANG_SUCCEEDED(_removeSourcePrelude(options, sourceArtifact)) &&
+        SLANG_SUCCEEDED(_requirePrecompiledPrelude(options, preludeHeaderPath)))
+    {
+        compilerSpecificArguments.addRange(options.compilerSpecificArguments.data, options.compilerSpecificArguments.count);
+        compilerSpecificArguments.add(TerminatedCharSlice("-include"));
+        compilerSpecificArguments.add(SliceUtil::asTerminatedCharSlice(preludeHeaderPath));
+
+        options.compilerSpecificArguments = SliceUtil::asSlice(compilerSpecificArguments);
+        options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+    }
+
+    return Super::compile(options, outArtifact);
+}
+
+SlangResult GCCDownstreamCompiler::_removeSourcePrelude(const CompileOptions& options, ComPtr<IArtifact>& outSourceArtifact)
+{
+    if (options.sourcePrelude.count == 0 ||
+        options.sourceArtifacts.count != 1 ||
+        options.sourceLanguage != SLANG_SOURCE_LANGUAGE_CPP)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    IArtifact* sourceArtifact = options.sourceArtifacts[0];
+
+    ComPtr<ISlangBlob> sourceBlob;
+    SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::No, sourceBlob.writeRef()));
+
+    const auto source = StringUtil::getSlice(sourceBlob);
+    const auto prelude = asStringSlice(options.sourcePrelude);
+    if (!source.startsWith(prelude))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Keep the line numbers of the rest of the source the same as they were with the prelude
+    Index lineCount = 0;
+    for (const char c : prelude)
+    {
+        lineCount += Index(c == '\n');
+    }
+
+    // The line directive names the file the source would have been reported as, had it been
+    // compiled as is.
+    UnownedStringSlice fileName = ArtifactUtil::findName(sourceArtifact);
+    if (fileName.getLength() == 0)
+    {
+        fileName = toSlice("unknown");
+    }
+
+    StringBuilder builder;
+    builder << "#line " << (lineCount + 1) << " ";
+    StringEscapeUtil::appendQuoted(StringEscapeUtil::getHandler(StringEscapeUtil::Style::Cpp), fileName, builder);
+    builder << "\n";
+    builder << source.tail(prelude.getLength());
+
+    auto artifact = ArtifactUtil::createArtifact(sourceArtifact->getDesc());
+    artifact->setName(sourceArtifact->getName());
+    artifact->addRepresentationUnknown(StringBlob::moveCreate(builder));
+
+    outSourceArtifact = artifact;
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::_requirePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath)
+{
+    // The precompiled header can only be used by compilations with the same code generation arguments
+    CommandLine codeGenCmdLine;
+    Util::calcCodeGenArgs(options, codeGenCmdLine);
+
+    DigestBuilder<SHA1> builder;
+    builder.append(m_desc.type);
+    builder.append(m_desc.version.m_major);
+    builder.append(m_desc.version.m_minor);
+    builder.append(m_desc.version.m_patch);
+    builder.append(m_cmdLine.m_executableLocation.m_pathOrName);
+    for (const auto& arg : codeGenCmdLine.m_args)
+    {
+        builder.append(arg);
+    }
+    builder.append(asStringSlice(options.sourcePrelude));
+    const String key = builder.finalize().toString();
+
+    std::lock_guard<std::mutex> lock(m_precompiledPreludeMutex);
+
+    if (auto headerPath = m_precompiledPreludes.tryGetValue(key))
+    {
+        outHeaderPath = *headerPath;
+        return SLANG_OK;
+    }
+
+    // Precompiled headers are kept in a directory only this user can access, so that another user
+    // cannot supply a header (or precompiled header) that our compilations would then include.
+    String rootDirectory;
+    SLANG_RETURN_ON_FAIL(Path::getPrivateTemporaryDirectory(toSlice("slang-pch"), rootDirectory));
+
+    String headerPath;
+    SLANG_RETURN_ON_FAIL(_precompilePrelude(options, rootDirectory, key, headerPath));
+
+    m_precompiledPreludes.add(key, headerPath);
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
+static const char kPreludeHeaderName[] = "slang-prelude.h";
+// Written once everything else in the directory is complete
+static const char kPreludeReadyName[] = "ready";
+
+SlangResult GCCDownstreamCompiler::_precompilePrelude(const CompileOptions& options, const String& rootDirectory, const String& key, String& outHeaderPath)
+{
+    const String directory = Path::combine(rootDirectory, key);
+    const String readyPath = Path::combine(directory, kPreludeReadyName);
+
+    // A directory is only ever given its final name once it is complete. One without the ready
+    // file is stale, for example left by an earlier version or emptied by a temp file cleaner, so
+    // it is removed and produced again. If another process moves its directory into place first,
+    // ours is discarded, and we use theirs.
+    for (Index attempt = 0; attempt < 2; ++attempt)
+    {
+        if (File::exists(readyPath))
+        {
+            outHeaderPath = Path::combine(directory, kPreludeHeaderName);
+            return SLANG_OK;
+        }
+
+        if (File::exists(directory))
+        {
+            Path::removeRecursive(directory);
+        }
+
+        // Produce the directory under a name unique to this process. Only one thread of the
+        // process does so at a time, as m_precompiledPreludeMutex is held. Anything left with the
+        // same name is from an earlier process with the same id, that didn't complete.
+        StringBuilder buildDirectory;
+        buildDirectory << directory << "-" << Process::getId();
+
+        Path::removeRecursive(buildDirectory);
+        if (!Path::createDirectory(buildDirectory))
+        {
+            return SLANG_FAIL;
+        }
+
+        const SlangResult res = _writePrecompiledPrelude(options, buildDirectory);
+        if (SLANG_FAILED(res) || SLANG_FAILED(Path::rename(buildDirectory, directory)))
+        {
+            Path::removeRecursive(buildDirectory);
+        }
+        SLANG_RETURN_ON_FAIL(res);
+    }
+
+    if (File::exists(readyPath))
+    {
+        outHeaderPath = Path::combine(directory, kPreludeHeaderName);
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+}
+
+SlangResult GCCDownstreamCompiler::_writePrecompiledPrelude(const CompileOptions& options, const String& directory)
+{
+    const String headerPath = Path::combine(directory, kPreludeHeaderName);
+    // gcc looks for a '.gch' next to an included header, clang for a '.pch'
+    const String precompiledHeaderPath = headerPath + ((m_desc.type == SLANG_PASS_THROUGH_CLANG) ? ".pch" : ".gch");
+
+    SLANG_RETURN_ON_FAIL(File::writeAllText(headerPath, asString(options.sourcePrelude)));
+
+    CommandLine cmdLine(m_cmdLine);
+    Util::calcCodeGenArgs(options, cmdLine);
+    cmdLine.addArg("-x");
+    cmdLine.addArg("c++-header");
+    cmdLine.addArg(headerPath);
+    cmdLine.addArg("-o");
+    cmdLine.addArg(precompiledHeaderPath);
+
+    ExecuteResult exeRes;
+    {
+        DownstreamProcessPool::Slot slot(DownstreamProcessPool::getSingleton());
+        SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    }
+
+    if (exeRes.resultCode != 0 || !File::exists(precompiledHeaderPath))
+    {
+        return SLANG_FAIL;
+    }
+
+    return File::writeAllText(Path::combine(directory, kPreludeReadyName), String());
+}
+
 /* static */SlangResult GCCDownstreamCompilerUtil::createCompiler(const ExecutableLocation& exe, ComPtr<IDownstreamCompiler>& outCompiler)
 {
     DownstreamCompilerDesc desc;
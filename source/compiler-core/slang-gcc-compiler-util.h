@@ -3,6 +3,8 @@
 
 #include "slang-downstream-compiler-util.h"
 
+#include "../core/slang-dictionary.h"
+
 namespace Slang
 {
 
@@ -18,6 +20,10 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
         /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+        /// Calculate the subset of the cmdLine arguments from options that affect how source is compiled.
+        /// A precompiled header must be compiled with the same arguments as the compilations that use it.
+    static void calcCodeGenArgs(const CompileOptions& options, CommandLine& cmdLine);
+
         /// Parse ExecuteResult into diagnostics 
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
 
@@ -46,7 +52,35 @@ public:
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, IArtifactDiagnostics* diagnostics) SLANG_OVERRIDE { return Util::parseOutput(exeResult, diagnostics); }
     virtual SlangResult calcCompileProducts(const CompileOptions& options, DownstreamProductFlags flags, IOSFileArtifactRepresentation* lockFile, List<ComPtr<IArtifact>>& outArtifacts) SLANG_OVERRIDE { return Util::calcCompileProducts(options, flags, lockFile, outArtifacts); }
 
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+
     GCCDownstreamCompiler(const Desc& desc):Super(desc) {}
+
+protected:
+        /// If the source in options starts with options.sourcePrelude, creates an artifact holding the
+        /// rest of the source.
+    SlangResult _removeSourcePrelude(const CompileOptions& options, ComPtr<IArtifact>& outSourceArtifact);
+
+        /// Get the path to a header holding options.sourcePrelude, that has been precompiled for compilations
+        /// using options. The precompiled header is stored next to the header, and is shared between processes
+        /// of the same user through a directory named after a hash of the compiler, the prelude and the
+        /// arguments used. The directory is in a temporary directory only the user can access.
+    SlangResult _requirePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath);
+
+        /// Find or produce the precompiled prelude in `rootDirectory`/`key`.
+        ///
+        /// The header and precompiled header are produced in a directory unique to this process, which is
+        /// renamed to its final name once complete. Other compilations therefore never see a partially
+        /// written directory.
+    SlangResult _precompilePrelude(const CompileOptions& options, const String& rootDirectory, const String& key, String& outHeaderPath);
+
+        /// Write the prelude header, and precompile it, into `directory`
+    SlangResult _writePrecompiledPrelude(const CompileOptions& options, const String& directory);
+
+    std::mutex m_precompiledPreludeMutex;
+        /// Maps the hash of a prelude and the arguments it was compiled with, to the path of its header
+    Dictionary<String, String> m_precompiledPreludes;
 };
 
 }
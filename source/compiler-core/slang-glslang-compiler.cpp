@@ -253,12 +253,30 @@ SlangResult GlslangDownstreamCompiler::compile(const CompileOptions& inOptions,
 
     request.entryPointName = options.entryPointName.begin();
 
+    auto diagnostics = ArtifactDiagnostics::create();
+
+    auto passTimingFunc = [](const glslang_SPIRVPassTiming* timing, void* userData)
+    {
+        StringBuilder buf;
+        buf << "spirv-opt pass " << timing->passName << ": ";
+        buf << String(timing->seconds * 1000.0, "%.3f") << "ms, ";
+        buf << Int64(timing->wordCountBefore) << " -> " << Int64(timing->wordCountAfter) << " words";
+
+        ArtifactDiagnostic diagnostic;
+        diagnostic.severity = ArtifactDiagnostic::Severity::Info;
+        diagnostic.text = SliceUtil::asTerminatedCharSlice(buf);
+        ((IArtifactDiagnostics*)userData)->add(diagnostic);
+    };
+    if (options.reportPassTimes)
+    {
+        request.passTimingFunc = passTimingFunc;
+        request.passTimingUserData = diagnostics.get();
+    }
+
     const SlangResult invokeResult = _invoke(request);
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
 
-    auto diagnostics = ArtifactDiagnostics::create();
-
     // Set the diagnostics result
     diagnostics->setResult(invokeResult);
 
@@ -6,10 +6,15 @@
 //
 
 #include "core/slang-char-encode.h"
+#include "core/slang-uint-set.h"
 #include "slang-name.h"
 #include "slang-source-loc.h"
 #include "slang-core-diagnostics.h"
 
+#if SLANG_PROCESSOR_X86_64
+#include <emmintrin.h>
+#endif
+
 namespace Slang
 {
     Token TokenReader::getEndOfFileToken()
@@ -283,10 +288,85 @@ namespace Slang
         _handleNewLineInner(lexer, c);
     }
 
+    // The functions below consume runs of plain bytes directly, before falling back
+    // to `_peek`/`_advance` for the byte that stops the run. A `\` (which might escape
+    // a newline) always stops a run, and so do non-ASCII bytes where decoding matters,
+    // so the fallback sees exactly the input it would have without the fast path.
+
+    enum CharClassFlag : uint8_t
+    {
+        kCharClass_Identifier       = 0x1,
+        kCharClass_HorizontalSpace  = 0x2,
+    };
+
+    struct CharClassTable
+    {
+        constexpr CharClassTable()
+            : flags()
+        {
+            for (int c = 'a'; c <= 'z'; ++c)
+                flags[c] |= kCharClass_Identifier;
+            for (int c = 'A'; c <= 'Z'; ++c)
+                flags[c] |= kCharClass_Identifier;
+            for (int c = '0'; c <= '9'; ++c)
+                flags[c] |= kCharClass_Identifier;
+            flags['_'] |= kCharClass_Identifier;
+
+            flags[' '] |= kCharClass_HorizontalSpace;
+            flags['\t'] |= kCharClass_HorizontalSpace;
+        }
+
+        uint8_t flags[256];
+    };
+    static constexpr CharClassTable kCharClassTable;
+
+    // Skip bytes that have any of the `classFlags`
+    static const char* _skipCharClass(const char* cursor, const char* end, uint8_t classFlags)
+    {
+        while (cursor != end && (kCharClassTable.flags[Byte(*cursor)] & classFlags))
+            cursor++;
+        return cursor;
+    }
+
+    // Find the first byte that is one of `chars`, or return `end` if there isn't one
+    template <size_t N>
+    static const char* _findFirstOf(const char* cursor, const char* end, const char (&chars)[N])
+    {
+#if SLANG_PROCESSOR_X86_64
+        // SSE2 is always available on x86-64, so test 16 bytes at a time
+        while (end - cursor >= 16)
+        {
+            const __m128i bytes = _mm_loadu_si128((const __m128i*)cursor);
+            __m128i matches = _mm_setzero_si128();
+            for (size_t i = 0; i < N; ++i)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(chars[i])));
+
+            const int mask = _mm_movemask_epi8(matches);
+            if (mask)
+                return cursor + bitscanForward(uint64_t(mask));
+            cursor += 16;
+        }
+#endif
+        for (; cursor != end; ++cursor)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (*cursor == chars[i])
+                    return cursor;
+            }
+        }
+        return end;
+    }
+
     static void _lexLineComment(Lexer* lexer)
     {
+        // A line comment can only be ended by a newline, but a `\` may escape one
+        static const char kStopChars[] = { '\n', '\r', '\\' };
+
         for(;;)
         {
+            lexer->m_cursor = _findFirstOf(lexer->m_cursor, lexer->m_end, kStopChars);
+
             switch(_peek(lexer))
             {
             case '\n': case '\r': case kEOF:
@@ -301,8 +381,14 @@ namespace Slang
 
     static void _lexBlockComment(Lexer* lexer)
     {
+        // Only a `*` can start the end of a block comment, and it may be separated
+        // from the `/` by an escaped newline
+        static const char kStopChars[] = { '*', '\\' };
+
         for(;;)
         {
+            lexer->m_cursor = _findFirstOf(lexer->m_cursor, lexer->m_end, kStopChars);
+
             switch(_peek(lexer))
             {
             case kEOF:
@@ -336,6 +422,8 @@ namespace Slang
     {
         for(;;)
         {
+            lexer->m_cursor = _skipCharClass(lexer->m_cursor, lexer->m_end, kCharClass_HorizontalSpace);
+
             switch(_peek(lexer))
             {
             case ' ': case '\t':
@@ -357,6 +445,8 @@ namespace Slang
     {
         for(;;)
         {
+            lexer->m_cursor = _skipCharClass(lexer->m_cursor, lexer->m_end, kCharClass_Identifier);
+
             int c = _peek(lexer);
             if(('a' <= c ) && (c <= 'z')
                 || ('A' <= c) && (c <= 'Z')
@@ -33,6 +33,7 @@
 #   include <mach-o/dyld.h>
 #endif
 
+#include <errno.h>
 #include <limits.h> /* PATH_MAX */
 #include <stdio.h>
 #include <stdlib.h>
@@ -562,6 +563,66 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult Path::requirePrivateDirectory(const String& path)
+    {
+#if defined(_WIN32)
+        _wmkdir(path.toWString());
+
+        SlangPathType pathType;
+        SLANG_RETURN_ON_FAIL(getPathType(path, &pathType));
+        return pathType == SLANG_PATH_TYPE_DIRECTORY ? SLANG_OK : SLANG_FAIL;
+#else
+        if (mkdir(path.getBuffer(), 0700) != 0 && errno != EEXIST)
+        {
+            return SLANG_FAIL;
+        }
+
+        // The directory may have been created by someone else, so check it is one we can trust.
+        // lstat is used so that a symbolic link to another directory is not accepted.
+        struct stat info;
+        if (lstat(path.getBuffer(), &info) != 0 ||
+            !S_ISDIR(info.st_mode) ||
+            info.st_uid != geteuid() ||
+            (info.st_mode & (S_IRWXG | S_IRWXO)) != 0)
+        {
+            return SLANG_FAIL;
+        }
+        return SLANG_OK;
+#endif
+    }
+
+    /* static */SlangResult Path::getPrivateTemporaryDirectory(const UnownedStringSlice& name, String& outPath)
+    {
+#if defined(_WIN32)
+        // The temporary directory is specific to the user, so we just use the directory
+        // temporary files are created in.
+        String tempFileName;
+        SLANG_RETURN_ON_FAIL(File::generateTemporary(name, tempFileName));
+        File::remove(tempFileName);
+
+        const String path = Path::combine(Path::getParentDirectory(tempFileName), name);
+#else
+        // Same location as used by File::generateTemporary
+        StringBuilder builder;
+        builder << "/tmp/" << name << "-" << uint32_t(geteuid());
+        const String path = builder.produceString();
+#endif
+        SLANG_RETURN_ON_FAIL(requirePrivateDirectory(path));
+        outPath = path;
+        return SLANG_OK;
+    }
+
+    /* static */SlangResult Path::rename(const String& fromPath, const String& toPath)
+    {
+#if defined(_WIN32)
+        // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+        return MoveFileExW(fromPath.toWString(), toPath.toWString(), 0) ? SLANG_OK : SLANG_FAIL;
+#else
+        // https://man7.org/linux/man-pages/man2/rename.2.html
+        return ::rename(fromPath.getBuffer(), toPath.getBuffer()) == 0 ? SLANG_OK : SLANG_FAIL;
+#endif
+    }
+
     bool Path::createDirectoryRecursive(const String& path)
     {
         String finalPath = Path::simplify(path);
@@ -777,6 +838,13 @@ namespace Slang
 #endif
     }
 
+    SlangResult Path::removeRecursive(const String& path)
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(std::filesystem::path(path.getBuffer()), ec);
+        return ec ? SLANG_FAIL : SLANG_OK;
+    }
+
 #if defined(_WIN32)
     /* static */SlangResult Path::find(const String& directoryPath, const char* pattern, Visitor* visitor)
     {
@@ -147,6 +147,27 @@ namespace Slang
         static bool createDirectory(const String& path);
         static bool createDirectoryRecursive(const String& path);
 
+            /// Create a directory at `path` that only the current user can access, or check that the
+            /// existing directory at `path` is one.
+            ///
+            /// On POSIX systems the directory is created with mode 0700, and an existing directory is only
+            /// accepted if it isn't a symbolic link, is owned by the current user and grants no access to
+            /// the group or others. On Windows the directory is created with the default permissions.
+            /// @return SLANG_OK if there is such a directory at `path`
+        static SlangResult requirePrivateDirectory(const String& path);
+
+            /// Get the path of a directory named `name` in the temporary directory, that only the current
+            /// user can access. The directory is created if it doesn't exist (see requirePrivateDirectory).
+            ///
+            /// The temporary directory is shared between users on POSIX systems, so there the user id is
+            /// appended to `name`.
+        static SlangResult getPrivateTemporaryDirectory(const UnownedStringSlice& name, String& outPath);
+
+            /// Rename the file or directory at `fromPath` to `toPath`.
+            /// Fails if `toPath` is a directory that isn't empty. Whether any other existing file or
+            /// directory at `toPath` is replaced depends on the platform.
+        static SlangResult rename(const String& fromPath, const String& toPath);
+
             /// Accept either style of delimiter
         SLANG_FORCE_INLINE static bool isDelimiter(char c) { return c == '/' || c == '\\'; }
 
@@ -217,6 +238,10 @@ namespace Slang
             /// @return SLANG_OK if file or directory is removed
         static SlangResult remove(const String& path);
 
+            /// Remove a file, or a directory along with everything in it
+            /// @return SLANG_OK if there is nothing at `path` afterwards
+        static SlangResult removeRecursive(const String& path);
+
         static bool equals(String path1, String path2);
 
             /// Turn `path` into a relative path from base.
@@ -1,93 +1,506 @@
 #include "slang-performance-profiler.h"
+#include "slang-blob.h"
 #include "slang-dictionary.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace Slang
 {
-    class PerformanceProfilerImpl : public PerformanceProfiler
+    // Used as the zero time for trace events, so events from all threads share a time base.
+    static const auto g_profilerEpoch = std::chrono::high_resolution_clock::now();
+
+    // Profile data, either recorded by a single thread, or merged from the data of several threads
+    struct ProfileData
     {
-    public:
-        OrderedDictionary<const char*, FuncProfileInfo> data;
+        // A node in the call tree. Each node represents a distinct call stack.
+        struct CallNode
+        {
+            const char* funcName = nullptr;
+            Index parent = -1;
+            Index firstChild = -1;
+            Index nextSibling = -1;
+            FuncProfileInfo info;
+        };
 
-        virtual FuncProfileContext enterFunction(const char* funcName) override
+        // A single recorded invocation
+        struct TraceEvent
+        {
+            const char* funcName;
+            std::chrono::nanoseconds start;
+            std::chrono::nanoseconds duration;
+            uint32_t threadIndex;
+        };
+
+        // The number of times a pass was run and skipped
+        struct PassInfo
+        {
+            int runCount = 0;
+            int skipCount = 0;
+        };
+
+        ProfileData() { reset(); }
+
+        void reset()
+        {
+            funcs.clear();
+            passes.clear();
+            traceEvents.clear();
+            callNodes.clear();
+            callNodes.add(CallNode());
+        }
+            /// Like reset, but also frees the memory held
+        void dispose()
+        {
+            funcs = decltype(funcs)();
+            passes = decltype(passes)();
+            traceEvents = decltype(traceEvents)();
+            callNodes = decltype(callNodes)();
+            callNodes.add(CallNode());
+        }
+
+        FuncProfileInfo& getFunc(const char* funcName)
+        {
+            auto entry = funcs.tryGetValue(funcName);
+            if (!entry)
+            {
+                funcs.add(funcName, FuncProfileInfo());
+                entry = funcs.tryGetValue(funcName);
+            }
+            return *entry;
+        }
+
+        PassInfo& getPass(const char* passName)
         {
-            auto entry = data.tryGetValue(funcName);
+            auto entry = passes.tryGetValue(passName);
             if (!entry)
             {
-                data.add(funcName, FuncProfileInfo());
-                entry = data.tryGetValue(funcName);
+                passes.add(passName, PassInfo());
+                entry = passes.tryGetValue(passName);
+            }
+            return *entry;
+        }
+
+            /// Find or add the node for `funcName` called from `parentIndex`
+        Index getChildCallNode(Index parentIndex, const char* funcName)
+        {
+            Index childIndex = callNodes[parentIndex].firstChild;
+            while (childIndex >= 0 && callNodes[childIndex].funcName != funcName)
+            {
+                childIndex = callNodes[childIndex].nextSibling;
+            }
+            if (childIndex < 0)
+            {
+                childIndex = callNodes.getCount();
+
+                CallNode node;
+                node.funcName = funcName;
+                node.parent = parentIndex;
+                node.nextSibling = callNodes[parentIndex].firstChild;
+                callNodes.add(node);
+
+                callNodes[parentIndex].firstChild = childIndex;
+            }
+            return childIndex;
+        }
+
+            /// Add the contents of `other`. Call stacks that are the same are combined.
+        void merge(const ProfileData& other)
+        {
+            for (const auto& func : other.funcs)
+            {
+                auto& info = getFunc(func.key);
+                info.invocationCount += func.value.invocationCount;
+                info.duration += func.value.duration;
+            }
+            for (const auto& pass : other.passes)
+            {
+                auto& info = getPass(pass.key);
+                info.runCount += pass.value.runCount;
+                info.skipCount += pass.value.skipCount;
             }
-            entry->invocationCount++;
+            _mergeCallNodes(other, 0, 0);
+            traceEvents.addRange(other.traceEvents);
+        }
+
+        OrderedDictionary<const char*, FuncProfileInfo> funcs;
+        OrderedDictionary<const char*, PassInfo> passes;
+        List<CallNode> callNodes;
+        List<TraceEvent> traceEvents;
+
+    protected:
+        void _mergeCallNodes(const ProfileData& other, Index otherNodeIndex, Index nodeIndex)
+        {
+            // Siblings are held most recently added first, so gather them to add in the order they were first called
+            List<Index> otherChildren;
+            for (Index i = other.callNodes[otherNodeIndex].firstChild; i >= 0; i = other.callNodes[i].nextSibling)
+            {
+                otherChildren.add(i);
+            }
+            for (Index i = otherChildren.getCount() - 1; i >= 0; --i)
+            {
+                const auto& otherChild = other.callNodes[otherChildren[i]];
+                const Index childIndex = getChildCallNode(nodeIndex, otherChild.funcName);
+
+                auto& info = callNodes[childIndex].info;
+                info.invocationCount += otherChild.info.invocationCount;
+                info.duration += otherChild.info.duration;
+
+                _mergeCallNodes(other, otherChildren[i], childIndex);
+            }
+        }
+    };
+
+    class PerformanceProfilerImpl;
+
+    // Tracks the profilers of all threads
+    struct PerformanceProfilerRegistry
+    {
+        static PerformanceProfilerRegistry& get()
+        {
+            static PerformanceProfilerRegistry registry;
+            return registry;
+        }
+
+        std::mutex mutex;
+        List<PerformanceProfilerImpl*> profilers;
+            /// Data recorded by threads that have since exited
+        ProfileData retiredData;
+        uint32_t nextThreadIndex = 0;
+
+        std::atomic<bool> traceEnabled = false;
+    };
+
+    class PerformanceProfilerImpl : public PerformanceProfiler
+    {
+    public:
+        PerformanceProfilerImpl()
+            // Makes sure the registry is constructed first, so outlives the profiler
+            : m_registry(PerformanceProfilerRegistry::get())
+        {
+            std::lock_guard<std::mutex> lock(m_registry.mutex);
+            m_threadIndex = m_registry.nextThreadIndex++;
+            m_registry.profilers.add(this);
+        }
+
+        ~PerformanceProfilerImpl()
+        {
+            // Keep what the thread recorded, so it's included in results after the thread has gone
+            std::lock_guard<std::mutex> lock(m_registry.mutex);
+            m_registry.retiredData.merge(m_data);
+            m_registry.profilers.remove(this);
+        }
+
+        virtual FuncProfileContext enterFunction(const char* funcName) override
+        {
+            WriteScope writeScope(this);
+
+            m_data.getFunc(funcName).invocationCount++;
+
+            // Find or add the node for this call stack
+            const Index childIndex = m_data.getChildCallNode(m_currentCallNode, funcName);
+            m_data.callNodes[childIndex].info.invocationCount++;
+            m_currentCallNode = childIndex;
+
             FuncProfileContext ctx;
             ctx.funcName = funcName;
+            ctx.callNodeIndex = childIndex;
+            ctx.generation = m_generation;
             ctx.startTime = std::chrono::high_resolution_clock::now();
             return ctx;
         }
         virtual void exitFunction(FuncProfileContext ctx) override
         {
             auto endTime = std::chrono::high_resolution_clock::now();
+
+            WriteScope writeScope(this);
+            if (ctx.generation != m_generation)
+            {
+                return;
+            }
+
             auto duration = endTime - ctx.startTime;
-            auto entry = data.tryGetValue(ctx.funcName);
-            entry->duration += duration;
+            m_data.getFunc(ctx.funcName).duration += duration;
+
+            auto& node = m_data.callNodes[ctx.callNodeIndex];
+            node.info.duration += duration;
+            m_currentCallNode = node.parent;
+
+            if (m_registry.traceEnabled)
+            {
+                ProfileData::TraceEvent event;
+                event.funcName = ctx.funcName;
+                event.start = ctx.startTime - g_profilerEpoch;
+                event.duration = duration;
+                event.threadIndex = m_threadIndex;
+                m_data.traceEvents.add(event);
+            }
+        }
+        virtual void recordPass(const char* passName, bool wasRun) override
+        {
+            WriteScope writeScope(this);
+
+            auto& entry = m_data.getPass(passName);
+            if (wasRun)
+                entry.runCount++;
+            else
+                entry.skipCount++;
         }
         virtual void getResult(StringBuilder& out) override
         {
+            ProfileData data;
+            _mergeAll(data);
+
             char buffer[512];
-            for (const auto& func : data)
+            for (const auto& func : data.funcs)
             {
                 memset(buffer, 0, sizeof(buffer));
                 snprintf(buffer, sizeof(buffer), "[*] %30s", func.key);
                 out << buffer << " \t";
-                auto milliseconds = std::chrono::duration_cast< std::chrono::milliseconds >(func.value.duration);
-                out << func.value.invocationCount << " \t" << milliseconds.count() << "ms\n";
+                out << func.value.invocationCount << " \t" << _getMilliseconds(func.value.duration) << "ms\n";
+            }
+
+            if (data.callNodes[0].firstChild >= 0)
+            {
+                out << "\nCall tree:\n";
+                _appendCallTree(data, data.callNodes[0].firstChild, 1, out);
+            }
+
+            if (data.passes.getCount())
+            {
+                out << "\nPasses (run, skipped):\n";
+                for (const auto& pass : data.passes)
+                {
+                    memset(buffer, 0, sizeof(buffer));
+                    snprintf(buffer, sizeof(buffer), "[*] %30s", pass.key);
+                    out << buffer << " \t" << pass.value.runCount << " \t" << pass.value.skipCount << "\n";
+                }
+            }
+        }
+        virtual void getFuncTotals(List<FuncProfileTotal>& out) override
+        {
+            ProfileData data;
+            _mergeAll(data);
+
+            out.clear();
+            for (const auto& func : data.funcs)
+            {
+                FuncProfileTotal total;
+                total.funcName = func.key;
+                total.info = func.value;
+                out.add(total);
+            }
+        }
+        virtual void setTraceEnabled(bool enable) override
+        {
+            m_registry.traceEnabled = enable;
+        }
+        virtual void getChromeTrace(StringBuilder& out) override
+        {
+            ProfileData data;
+            _mergeAll(data);
+
+            out << "{\"traceEvents\":[";
+            for (Index i = 0; i < data.traceEvents.getCount(); ++i)
+            {
+                const auto& event = data.traceEvents[i];
+                out << (i ? ",\n" : "\n");
+                out << "{\"name\":\"";
+                _appendEscaped(event.funcName, out);
+                out << "\",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex;
+                out << ",\"ts\":" << String(event.start.count() / 1000.0, "%.3f");
+                out << ",\"dur\":" << String(event.duration.count() / 1000.0, "%.3f") << "}";
             }
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
         }
         virtual void clear() override
         {
-            data.clear();
+            std::lock_guard<std::mutex> lock(m_registry.mutex);
+            m_registry.retiredData.reset();
+            for (auto profiler : m_registry.profilers)
+            {
+                AccessScope accessScope(profiler);
+                profiler->m_data.reset();
+                profiler->_resetCallStack();
+            }
         }
         virtual void dispose() override
         {
-            data = decltype(data)();
+            std::lock_guard<std::mutex> lock(m_registry.mutex);
+            m_registry.retiredData.dispose();
+            for (auto profiler : m_registry.profilers)
+            {
+                AccessScope accessScope(profiler);
+                profiler->m_data.dispose();
+                profiler->_resetCallStack();
+            }
+        }
+
+    protected:
+        // The data of a thread is only written by that thread, and is only read or reset by other threads
+        // when the results are read or cleared. Rather than a mutex, the two sides use a handshake on a pair
+        // of flags, such that writing never blocks unless another thread is accessing the data.
+        //
+        // Each side sets its own flag before checking the other's (both sequentially consistent), so at
+        // least one of them sees the other. A writer that sees an access backs off until it's done.
+        // Accesses from other threads are serialized by the registry mutex.
+
+            /// Held by the thread that owns the profiler whilst it updates m_data
+        struct WriteScope
+        {
+            WriteScope(PerformanceProfilerImpl* profiler)
+                : m_profiler(profiler)
+            {
+                profiler->m_isWriting.store(true);
+                while (profiler->m_isAccessed.load())
+                {
+                    profiler->m_isWriting.store(false);
+                    while (profiler->m_isAccessed.load())
+                    {
+                        std::this_thread::yield();
+                    }
+                    profiler->m_isWriting.store(true);
+                }
+            }
+            ~WriteScope() { m_profiler->m_isWriting.store(false, std::memory_order_release); }
+            PerformanceProfilerImpl* m_profiler;
+        };
+
+            /// Held by another thread whilst it reads or resets m_data. Must be created with the registry mutex held.
+        struct AccessScope
+        {
+            AccessScope(PerformanceProfilerImpl* profiler)
+                : m_profiler(profiler)
+            {
+                profiler->m_isAccessed.store(true);
+                while (profiler->m_isWriting.load())
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ~AccessScope() { m_profiler->m_isAccessed.store(false, std::memory_order_release); }
+            PerformanceProfilerImpl* m_profiler;
+        };
+
+        static String _getMilliseconds(std::chrono::nanoseconds duration)
+        {
+            return String(duration.count() / 1000000.0, "%.3f");
         }
+
+            /// Must be called within an AccessScope, after the call tree has been reset
+        void _resetCallStack()
+        {
+            m_currentCallNode = 0;
+            // Invalidate any function that is currently active
+            m_generation++;
+        }
+
+            /// Merge the data of all threads into `out`
+        void _mergeAll(ProfileData& out)
+        {
+            std::lock_guard<std::mutex> lock(m_registry.mutex);
+            out.merge(m_registry.retiredData);
+            for (auto profiler : m_registry.profilers)
+            {
+                AccessScope accessScope(profiler);
+                out.merge(profiler->m_data);
+            }
+        }
+
+        static void _appendCallTree(const ProfileData& data, Index nodeIndex, Index depth, StringBuilder& out)
+        {
+            // Siblings are held most recently added first, so gather them to output in the order they were first called
+            List<Index> siblings;
+            for (Index i = nodeIndex; i >= 0; i = data.callNodes[i].nextSibling)
+            {
+                siblings.add(i);
+            }
+
+            for (Index i = siblings.getCount() - 1; i >= 0; --i)
+            {
+                const auto& node = data.callNodes[siblings[i]];
+                for (Index j = 0; j < depth; ++j)
+                {
+                    out << "  ";
+                }
+                out << node.funcName << " \t" << node.info.invocationCount << " \t" << _getMilliseconds(node.info.duration) << "ms\n";
+
+                if (node.firstChild >= 0)
+                {
+                    _appendCallTree(data, node.firstChild, depth + 1, out);
+                }
+            }
+        }
+
+        static void _appendEscaped(const char* text, StringBuilder& out)
+        {
+            for (const char* cur = text; *cur; ++cur)
+            {
+                const char c = *cur;
+                if (c == '"' || c == '\\')
+                {
+                    out.appendChar('\\');
+                }
+                out.appendChar(c);
+            }
+        }
+
+        PerformanceProfilerRegistry& m_registry;
+
+            /// Set whilst the owning thread is updating m_data
+        std::atomic<bool> m_isWriting = false;
+            /// Set whilst another thread is reading or resetting m_data
+        std::atomic<bool> m_isAccessed = false;
+        ProfileData m_data;
+        Index m_currentCallNode = 0;
+        uint32_t m_generation = 0;
+
+        uint32_t m_threadIndex = 0;
     };
 
     PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
     {
-        thread_local static PerformanceProfilerImpl profiler = PerformanceProfilerImpl();
+        thread_local static PerformanceProfilerImpl profiler;
         return &profiler;
     }
 
     SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
     {
-        PerformanceProfilerImpl* profilerImpl = static_cast<PerformanceProfilerImpl*>(profiler);
-        size_t entryCount = profilerImpl->data.getCount();
+        List<FuncProfileTotal> totals;
+        profiler->getFuncTotals(totals);
 
-        m_profilEntries.reserve(entryCount);
+        m_profilEntries.reserve(totals.getCount());
 
-        int index = 0;
-        for (auto func : profilerImpl->data)
+        for (const auto& total : totals)
         {
             ProfileInfo profileEntry {};
-            size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(func.key));
+            size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(total.funcName));
 
             if (strSize > 0)
             {
-                memcpy(profileEntry.funcName, func.key, strSize);
+                memcpy(profileEntry.funcName, total.funcName, strSize);
             }
-            profileEntry.invocationCount = func.value.invocationCount;
-            profileEntry.duration = func.value.duration;
+            profileEntry.invocationCount = total.info.invocationCount;
+            profileEntry.duration = total.info.duration;
 
-            m_profilEntries.insert(index, profileEntry);
-            index++;
+            m_profilEntries.add(profileEntry);
         }
+
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+        m_chromeTrace = trace.produceString();
     }
 
     ISlangUnknown* SlangProfiler::getInterface(const Guid& guid)
     {
-        if(guid == SlangProfiler::getTypeGuid())
+        if (guid == ISlangUnknown::getTypeGuid() ||
+            guid == ISlangProfiler::getTypeGuid() ||
+            guid == ISlangProfilerExt::getTypeGuid())
+        {
             return static_cast<ISlangUnknown*>(this);
-        else
-            return nullptr;
+        }
+        return nullptr;
     }
 
     size_t SlangProfiler::getEntryCount()
@@ -119,4 +532,21 @@ namespace Slang
 
         return m_profilEntries[index].invocationCount;
     }
+
+    double SlangProfiler::getEntryTimeUS(uint32_t index)
+    {
+        if (index >= (uint32_t)m_profilEntries.getCount())
+            return 0;
+
+        return m_profilEntries[index].duration.count() / 1000.0;
+    }
+
+    SlangResult SlangProfiler::getChromeTrace(ISlangBlob** outBlob)
+    {
+        if (!outBlob)
+            return SLANG_E_INVALID_ARG;
+
+        *outBlob = StringBlob::create(m_chromeTrace).detach();
+        return SLANG_OK;
+    }
 }
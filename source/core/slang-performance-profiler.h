@@ -20,17 +20,44 @@ struct FuncProfileContext
 {
     const char* funcName = nullptr;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+        /// The node in the call tree for this invocation
+    Index callNodeIndex = -1;
+        /// Identifies the state of the profiler when the function was entered. If the profiler is
+        /// cleared whilst the function is active, the exit is ignored.
+    uint32_t generation = 0;
 };
 
+struct FuncProfileTotal
+{
+    const char* funcName = nullptr;
+    FuncProfileInfo info;
+};
+
+    /// Each thread records into its own profiler (as returned by `getProfiler`), so entering and exiting
+    /// functions doesn't contend with other threads. Everything other than entering and exiting functions
+    /// and recording passes applies to the profilers of *all* threads, such that work done on other
+    /// threads (for example parallel checking or code generation) is included in the results.
 class PerformanceProfiler
 {
 public:
     virtual FuncProfileContext enterFunction(const char* funcName) = 0;
     virtual void exitFunction(FuncProfileContext context) = 0;
+        /// Record that the pass `passName` was run, or was skipped because it had nothing to do
+    virtual void recordPass(const char* passName, bool wasRun) = 0;
+        /// Writes the totals for each function, followed by the totals for each distinct call stack,
+        /// and the number of times each recorded pass was run and skipped
     virtual void getResult(StringBuilder& out) = 0;
+        /// Get the totals for each function
+    virtual void getFuncTotals(List<FuncProfileTotal>& out) = 0;
+        /// When enabled every function invocation is recorded, such that it can be output with `getChromeTrace`
+    virtual void setTraceEnabled(bool enable) = 0;
+        /// Writes the recorded invocations in the Chrome trace event JSON format, as can be read by
+        /// chrome://tracing or Perfetto. Each thread has its own track.
+    virtual void getChromeTrace(StringBuilder& out) = 0;
     virtual void clear() = 0;
     virtual void dispose() = 0;
 public:
+        /// Get the profiler for the current thread
     static PerformanceProfiler* getProfiler();
 };
 
@@ -47,7 +74,7 @@ struct PerformanceProfilerFuncRAIIContext
     }
 };
 
-struct SlangProfiler: public ISlangProfiler, public RefObject
+struct SlangProfiler: public ISlangProfilerExt, public RefObject
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -60,12 +87,18 @@ public:
     SlangProfiler(PerformanceProfiler * profiler);
     ISlangUnknown* getInterface(const Guid& guid);
 
+    // ISlangProfiler
     virtual SLANG_NO_THROW size_t SLANG_MCALL getEntryCount() override;
     virtual SLANG_NO_THROW const char* SLANG_MCALL getEntryName(uint32_t index) override;
     virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) override;
     virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) override;
+
+    // ISlangProfilerExt
+    virtual SLANG_NO_THROW double SLANG_MCALL getEntryTimeUS(uint32_t index) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getChromeTrace(ISlangBlob** outBlob) override;
 private:
     List<ProfileInfo> m_profilEntries;
+    String m_chromeTrace;
 };
 
 #define SLANG_PROFILE            PerformanceProfilerFuncRAIIContext _profileContext(__func__)
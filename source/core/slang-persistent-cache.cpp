@@ -4,6 +4,9 @@
 #include "../core/slang-stream.h"
 #include "../core/slang-string-util.h"
 #include "../core/slang-blob.h"
+#include "../core/slang-process.h"
+
+#include <stddef.h>
 
 namespace Slang
 {
@@ -27,6 +30,19 @@ PersistentCache::PersistentCache(const Desc& desc)
 
 PersistentCache::~PersistentCache()
 {
+    if (m_pendingAccesses.getCount() == 0 || !m_lockFile.isOpen())
+    {
+        return;
+    }
+
+    // Append any accesses that have not made it to the index yet.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    LockFileGuard fileLock(m_lockFile);
+
+    if (SLANG_SUCCEEDED(syncIndex()))
+    {
+        flushIndex();
+    }
 }
 
 SlangResult PersistentCache::clear()
@@ -63,13 +79,21 @@ SlangResult PersistentCache::clear()
     Visitor visitor(m_cacheDirectory, m_lockFileName);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
+    resetIndex();
     m_stats.entryCount = 0;
 
     return SLANG_OK;
 }
 
+PersistentCache::Stats PersistentCache::getStats() const
+{
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    return m_stats;
+}
+
 void PersistentCache::resetStats()
 {
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
     m_stats.entryCount = 0;
     m_stats.hitCount = 0;
     m_stats.missCount = 0;
@@ -77,6 +101,9 @@ void PersistentCache::resetStats()
 
 SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
 {
+    // Acquire the exclusive lock. The mutex is taken first, as it also guards the stats.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+
     // Be pessimistic and assume we have a cache miss.
     ++m_stats.missCount;
 
@@ -85,29 +112,15 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
-    {
-        return SLANG_E_NOT_FOUND;
-    }
-
-    // Read the cache index.
-    CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
-
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
-    {
-        ++entry.age;
-    }
+    // Bring the cache index up to date. This fails with SLANG_E_NOT_FOUND
+    // if the index does not exist.
+    SLANG_RETURN_ON_FAIL(syncIndex());
 
     // Find the entry.
-    Index entryIndex = cacheIndex.findFirstIndex([&key] (const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
+    Index* entryIndex = m_entryMap.tryGetValue(key);
+    if (!entryIndex)
     {
         return SLANG_E_NOT_FOUND;
     }
@@ -120,18 +133,28 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
     {
         --m_stats.missCount;
         ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
         auto blob = RawBlob::moveCreate(data);
         *outData = blob.detach();
+
+        // Record the access. This is only written to the index once enough
+        // accesses have accumulated, or with the next write to the cache.
+        touchEntry(*entryIndex);
+        m_pendingAccesses.add(key);
+        if (m_pendingAccesses.getCount() >= kMaxPendingAccessCount)
+        {
+            flushIndex();
+        }
     }
     else
     {
-        cacheIndex.removeAt(entryIndex);
+        removeEntry(*entryIndex);
+
+        // Record the removal in the cache index.
+        IndexRecord record = { key, IndexOp::Remove };
+        SLANG_RETURN_ON_FAIL(flushIndex(makeConstArrayViewSingle(record)));
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    m_stats.entryCount = m_index.getCount();
 
     return result;
 }
@@ -149,56 +172,51 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    // Read the cache index.
+    // Bring the cache index up to date.
     // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
-
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
-    {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
-        {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
-        }
-    }
+    syncIndex();
 
     // Write the cache entry.
     String entryFileName = getEntryFileName(key);
     SLANG_RETURN_ON_FAIL(File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
 
     // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+    IndexRecord records[2];
+    Count recordCount = 0;
+    if (Index* entryIndex = m_entryMap.tryGetValue(key))
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{ key, 0 };
+        // Entry has been rewritten.
+        touchEntry(*entryIndex);
     }
     else
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{ key, 0 });
+        if (m_maxEntryCount > 0 && m_index.getCount() >= m_maxEntryCount)
+        {
+            // Evict the least recently used entry.
+            SLANG_ASSERT(m_leastRecentlyUsed >= 0);
+            const Key evictedKey = m_index[m_leastRecentlyUsed].key;
+            File::remove(getEntryFileName(evictedKey));
+            removeEntry(m_leastRecentlyUsed);
+            records[recordCount++] = IndexRecord{ evictedKey, IndexOp::Remove };
+        }
+        addEntry(key);
     }
+    records[recordCount++] = IndexRecord{ key, IndexOp::Access };
 
     // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
-    if (result == SLANG_OK)
-    {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
-    }
-    else
+    SlangResult result = flushIndex(makeConstArrayView(records, recordCount));
+    if (result != SLANG_OK)
     {
         // If writing the index failed, remove the entry file to avoid growing the cache.
         Path::remove(entryFileName);
+        if (Index* entryIndex = m_entryMap.tryGetValue(key))
+        {
+            removeEntry(*entryIndex);
+        }
     }
 
+    m_stats.entryCount = m_index.getCount();
+
     return result;
 }
 
@@ -213,15 +231,125 @@ SlangResult PersistentCache::initialize()
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
+    if (SLANG_SUCCEEDED(syncIndex()))
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        m_stats.entryCount = m_index.getCount();
     }
 
     return SLANG_OK;
 }
 
+void PersistentCache::resetIndex()
+{
+    m_index.clear();
+    m_entryMap.clear();
+    m_leastRecentlyUsed = -1;
+    m_mostRecentlyUsed = -1;
+    m_indexId = 0;
+    m_indexRecordCount = 0;
+    m_pendingAccesses.clear();
+}
+
+void PersistentCache::applyRecord(const IndexRecord& record)
+{
+    Index* entryIndex = m_entryMap.tryGetValue(record.key);
+    if (record.op == IndexOp::Remove)
+    {
+        if (entryIndex)
+        {
+            removeEntry(*entryIndex);
+        }
+    }
+    else if (entryIndex)
+    {
+        touchEntry(*entryIndex);
+    }
+    else
+    {
+        addEntry(record.key);
+    }
+}
+
+void PersistentCache::linkEntry(Index entryIndex)
+{
+    // Entries are linked in as the most recently used one.
+    auto& entry = m_index[entryIndex];
+    entry.prev = m_mostRecentlyUsed;
+    entry.next = -1;
+    if (m_mostRecentlyUsed >= 0)
+    {
+        m_index[m_mostRecentlyUsed].next = entryIndex;
+    }
+    else
+    {
+        m_leastRecentlyUsed = entryIndex;
+    }
+    m_mostRecentlyUsed = entryIndex;
+}
+
+void PersistentCache::unlinkEntry(Index entryIndex)
+{
+    auto& entry = m_index[entryIndex];
+    if (entry.prev >= 0)
+    {
+        m_index[entry.prev].next = entry.next;
+    }
+    else
+    {
+        m_leastRecentlyUsed = entry.next;
+    }
+    if (entry.next >= 0)
+    {
+        m_index[entry.next].prev = entry.prev;
+    }
+    else
+    {
+        m_mostRecentlyUsed = entry.prev;
+    }
+}
+
+void PersistentCache::touchEntry(Index entryIndex)
+{
+    if (entryIndex == m_mostRecentlyUsed)
+    {
+        return;
+    }
+    unlinkEntry(entryIndex);
+    linkEntry(entryIndex);
+}
+
+void PersistentCache::addEntry(const Key& key)
+{
+    const Index entryIndex = m_index.getCount();
+    m_entryMap.add(key, entryIndex);
+    m_index.add(CacheEntry{ key, -1, -1 });
+    linkEntry(entryIndex);
+}
+
+void PersistentCache::removeEntry(Index entryIndex)
+{
+    unlinkEntry(entryIndex);
+    m_entryMap.remove(m_index[entryIndex].key);
+
+    // Move the last entry into the freed slot so removal is O(1).
+    const Index lastIndex = m_index.getCount() - 1;
+    if (entryIndex != lastIndex)
+    {
+        auto& entry = m_index[entryIndex];
+        entry = m_index[lastIndex];
+        m_entryMap[entry.key] = entryIndex;
+        if (entry.prev >= 0)
+            m_index[entry.prev].next = entryIndex;
+        else
+            m_leastRecentlyUsed = entryIndex;
+        if (entry.next >= 0)
+            m_index[entry.next].prev = entryIndex;
+        else
+            m_mostRecentlyUsed = entryIndex;
+    }
+    m_index.removeLast();
+}
+
 String PersistentCache::getEntryFileName(const Key& key)
 {
     StringBuilder str;
@@ -233,17 +361,24 @@ struct CacheIndexHeader
 {
     char magic[4];
     uint32_t version;
+    // Number of records following the header.
     uint32_t count;
     uint32_t reserved;
+    // Chosen randomly every time the index file is (re)written from scratch.
+    uint64_t indexId;
 };
 
 static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+static const uint32_t kVersion = 3;
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+SlangResult PersistentCache::syncIndex()
 {
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+    if (SLANG_FAILED(fs.init(m_indexFileName, FileMode::Open)))
+    {
+        resetIndex();
+        return SLANG_E_NOT_FOUND;
+    }
 
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
@@ -251,37 +386,127 @@ SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIn
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
     CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    if (fileSize < sizeof(header) ||
+        SLANG_FAILED(fs.readExactly(&header, sizeof(header))) ||
+        ::memcmp(header.magic, kMagic, 4) != 0 ||
+        header.version != kVersion ||
+        size_t(header.count) * sizeof(IndexRecord) != fileSize - sizeof(header))
     {
+        resetIndex();
         return SLANG_E_INTERNAL_FAIL;
     }
 
-    // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    // Nothing to do if no records have been appended since we last looked at the index.
+    if (header.indexId == m_indexId && Count(header.count) == m_indexRecordCount)
+    {
+        return SLANG_OK;
+    }
+
+    // Only the new records need to be applied, unless the index file has been rewritten.
+    List<Key> pendingAccesses = _Move(m_pendingAccesses);
+    if (header.indexId != m_indexId || Count(header.count) < m_indexRecordCount)
     {
+        resetIndex();
+    }
+
+    List<IndexRecord> records;
+    records.setCount(header.count - m_indexRecordCount);
+    if (SLANG_FAILED(fs.seek(SeekOrigin::Start, sizeof(header) + m_indexRecordCount * sizeof(IndexRecord))) ||
+        SLANG_FAILED(fs.readExactly(records.getBuffer(), records.getCount() * sizeof(IndexRecord))))
+    {
+        resetIndex();
         return SLANG_E_INTERNAL_FAIL;
     }
+    for (const auto& record : records)
+    {
+        applyRecord(record);
+    }
+    m_indexId = header.indexId;
+    m_indexRecordCount = header.count;
+
+    // Re-apply the accesses we have not written yet, so they are more recent than the
+    // ones made by others.
+    for (const auto& key : pendingAccesses)
+    {
+        if (Index* entryIndex = m_entryMap.tryGetValue(key))
+        {
+            touchEntry(*entryIndex);
+            m_pendingAccesses.add(key);
+        }
+    }
+
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::flushIndex(ConstArrayView<IndexRecord> records)
+{
+    List<IndexRecord> newRecords;
+    for (const auto& key : m_pendingAccesses)
+    {
+        newRecords.add(IndexRecord{ key, IndexOp::Access });
+    }
+    newRecords.addRange(records.getBuffer(), records.getCount());
+
+    const Count recordCount = m_indexRecordCount + newRecords.getCount();
+    if (m_indexId == 0 || recordCount > 2 * m_index.getCount() + kMinCompactionRecordCount)
+    {
+        return rewriteIndex();
+    }
+    if (newRecords.getCount() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    // Append the records first, and only then make them part of the index by updating the
+    // record count in the header.
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite));
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, sizeof(CacheIndexHeader) + m_indexRecordCount * sizeof(IndexRecord)));
+    SLANG_RETURN_ON_FAIL(fs.write(newRecords.getBuffer(), newRecords.getCount() * sizeof(IndexRecord)));
+    const uint32_t count = uint32_t(recordCount);
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, offsetof(CacheIndexHeader, count)));
+    SLANG_RETURN_ON_FAIL(fs.write(&count, sizeof(count)));
+
+    m_indexRecordCount = recordCount;
+    m_pendingAccesses.clear();
 
-    outIndex.setCount(header.count);
-    SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
-    
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+SlangResult PersistentCache::rewriteIndex()
 {
+    // Start a new index. The id makes sure that other cache instances holding on to
+    // the previous index will re-read all of it.
+    uint64_t indexId = (Process::getClockTick() << 16) ^ Process::getId() ^ uint64_t(uintptr_t(this));
+    if (indexId == 0 || indexId == m_indexId)
+    {
+        indexId++;
+    }
+
+    // Entries are written from the least to the most recently used one, which preserves
+    // their order.
+    List<IndexRecord> records;
+    for (Index entryIndex = m_leastRecentlyUsed; entryIndex >= 0; entryIndex = m_index[entryIndex].next)
+    {
+        records.add(IndexRecord{ m_index[entryIndex].key, IndexOp::Access });
+    }
+
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Create));
 
     CacheIndexHeader header;
     ::memcpy(header.magic, kMagic, 4);
     header.version = kVersion;
-    header.count = (uint32_t)index.getCount();
+    header.count = (uint32_t)records.getCount();
     header.reserved = 0;
+    header.indexId = indexId;
     SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
 
-    SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
+    SLANG_RETURN_ON_FAIL(fs.write(records.getBuffer(), records.getCount() * sizeof(IndexRecord)));
+
+    m_indexId = indexId;
+    m_indexRecordCount = records.getCount();
+    m_pendingAccesses.clear();
 
     return SLANG_OK;
 }
@@ -3,6 +3,7 @@
 #include "../core/slang-crypto.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
+#include "../core/slang-dictionary.h"
 
 #include <mutex>
 
@@ -14,6 +15,13 @@ namespace Slang
 /// The cache is save for concurrent access from multiple threads/processes by using
 /// a lock file within the cache directory. Furthermore, the cache implements a LRU
 /// eviction policy.
+///
+/// The index file is a journal of accesses and removals, which is appended to rather
+/// than rewritten, and is compacted once most of it is made up of stale records.
+/// Each cache instance keeps an in-memory copy of the index, and only reads the records
+/// other instances (or processes) have appended since it last looked at the file.
+/// Recording a hit only touches the in-memory copy; hits are appended lazily, together
+/// with the next modification of the index or once enough hits have accumulated.
 class PersistentCache : public RefObject
 {
 public:
@@ -43,7 +51,9 @@ public:
     /// Clear the contents of the cache by removing the cache index and all entry files.
     SlangResult clear();
 
-    const Stats& getStats() const { return m_stats; }
+    /// Get a copy of the stats. The cache may be used from multiple threads, so a reference
+    /// to the stats could be updated while it is read.
+    Stats getStats() const;
     void resetStats();
 
     /// Read an entry from the cache.
@@ -58,17 +68,57 @@ private:
     struct CacheEntry
     {
         Key key;
-        uint32_t age;
+        // Neighbours in the LRU list, which runs from the least to the most recently used
+        // entry.
+        Index prev;
+        Index next;
     };
 
-    using CacheIndex = List<CacheEntry>;
+    enum class IndexOp : uint32_t
+    {
+        // The entry was written or read, making it the most recently used one.
+        Access = 1,
+        // The entry was removed.
+        Remove = 2,
+    };
+
+    // A record of the index journal.
+    struct IndexRecord
+    {
+        Key key;
+        IndexOp op;
+    };
+
+    // Number of cache hits that are recorded in memory before they are appended to the
+    // index file.
+    static const Count kMaxPendingAccessCount = 64;
+    // The index is compacted once it holds more than twice as many records as entries,
+    // plus this many.
+    static const Count kMinCompactionRecordCount = 256;
 
     SlangResult initialize();
 
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    /// Make sure the in-memory index matches the index file.
+    /// Only the records appended since this instance last read or wrote the index file
+    /// are read, unless it has been compacted since.
+    /// Returns SLANG_E_NOT_FOUND if there is no index file. If the index file is
+    /// missing or corrupt, the in-memory index is cleared.
+    SlangResult syncIndex();
+    /// Append the pending accesses and `records` to the index file, compacting it if
+    /// it has grown too large.
+    SlangResult flushIndex(ConstArrayView<IndexRecord> records = ConstArrayView<IndexRecord>());
+    /// Replace the index file with one that holds an access record for each entry.
+    SlangResult rewriteIndex();
+
+    void resetIndex();
+    void applyRecord(const IndexRecord& record);
+    void linkEntry(Index entryIndex);
+    void unlinkEntry(Index entryIndex);
+    void touchEntry(Index entryIndex);
+    void addEntry(const Key& key);
+    void removeEntry(Index entryIndex);
 
     String m_cacheDirectory;
     String m_lockFileName;
@@ -77,11 +127,27 @@ private:
     // For exclusive locking we need both a mutex (acquired first)
     // followed by a a file lock. The mutex is needed because on Linux
     // the file lock is only locking between processes, not threads.
-    std::mutex m_mutex;
+    mutable std::mutex m_mutex;
     Slang::LockFile m_lockFile;
 
     Count m_maxEntryCount;
 
+    // In-memory copy of the index, a map from key to the position in it, and the
+    // ends of the LRU list.
+    List<CacheEntry> m_index;
+    Dictionary<Key, Index> m_entryMap;
+    Index m_leastRecentlyUsed = -1;
+    Index m_mostRecentlyUsed = -1;
+
+    // Identifies the index file the in-memory index corresponds to, and how many of its
+    // records have been applied. An id of 0 means no index file has been read or written
+    // yet.
+    uint64_t m_indexId = 0;
+    Count m_indexRecordCount = 0;
+
+    // Keys of entries that were hit since the index was last written.
+    List<Key> m_pendingAccesses;
+
     Stats m_stats;
 
     // Used for unit tests.
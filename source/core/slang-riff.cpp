@@ -207,16 +207,79 @@ struct DumpVisitor : public RiffContainer::Visitor
     chunk->visit(&visitor);
 }
 
-/* static */SlangResult RiffUtil::write(RiffContainer::ListChunk* list, bool isRoot, Stream* stream)
+/* static */size_t RiffUtil::calcAlignmentJunkSize(size_t offset)
+{
+    const size_t alignMask = RiffContainer::kPayloadMinAlignment - 1;
+    // Chunks always start on kRiffPadSize, so the misalignment is even
+    SLANG_ASSERT((offset & kRiffPadMask) == 0);
+
+    const size_t misalignment = (offset + sizeof(RiffHeader)) & alignMask;
+    if (misalignment == 0)
+    {
+        return 0;
+    }
+    // The junk chunk has a header of its own, so it moves the payload on by its header as well
+    // as the bytes needed to reach alignment.
+    return sizeof(RiffHeader) + (RiffContainer::kPayloadMinAlignment - misalignment);
+}
+
+/* static */size_t RiffUtil::calcAlignedListPayloadSize(RiffContainer::ListChunk* list, size_t offset)
+{
+    size_t pos = offset + sizeof(RiffListHeader);
+
+    Chunk* chunk = list->m_containedChunks;
+    while (chunk)
+    {
+        switch (chunk->m_kind)
+        {
+            case Chunk::Kind::List:
+            {
+                pos += sizeof(RiffHeader) + calcAlignedListPayloadSize(static_cast<ListChunk*>(chunk), pos);
+                break;
+            }
+            case Chunk::Kind::Data:
+            {
+                pos += calcAlignmentJunkSize(pos);
+                pos += sizeof(RiffHeader) + getPadSize(static_cast<DataChunk*>(chunk)->m_payloadSize);
+                break;
+            }
+            default: break;
+        }
+        chunk = chunk->m_next;
+    }
+
+    return pos - (offset + sizeof(RiffHeader));
+}
+
+/* static */SlangResult RiffUtil::_writeJunk(size_t junkSize, Stream* stream)
+{
+    SLANG_ASSERT(junkSize >= sizeof(RiffHeader) && junkSize - sizeof(RiffHeader) < RiffContainer::kPayloadMinAlignment);
+
+    RiffHeader junkHeader;
+    junkHeader.type = RiffFourCC::kJunk;
+    junkHeader.size = uint32_t(junkSize - sizeof(RiffHeader));
+    SLANG_RETURN_ON_FAIL(stream->write(&junkHeader, sizeof(junkHeader)));
+
+    static const uint8_t junk[RiffContainer::kPayloadMinAlignment] = { 0 };
+    if (junkHeader.size)
+    {
+        SLANG_RETURN_ON_FAIL(stream->write(junk, junkHeader.size));
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult RiffUtil::_write(RiffContainer::ListChunk* list, bool isRoot, size_t offset, Stream* stream)
 {
     RiffListHeader listHeader;
 
     listHeader.chunk.type = isRoot ? RiffFourCC::kRiff : RiffFourCC::kList;
-    listHeader.chunk.size = uint32_t(list->m_payloadSize);
+    // The size includes any junk chunks needed for alignment, so can differ from m_payloadSize
+    listHeader.chunk.size = uint32_t(calcAlignedListPayloadSize(list, offset));
     listHeader.subType = list->getSubType();
 
     // Write the header
     SLANG_RETURN_ON_FAIL(stream->write(&listHeader, sizeof(listHeader)));
+    size_t pos = offset + sizeof(listHeader);
 
         // Write the contained chunks
     Chunk* chunk = list->m_containedChunks;
@@ -228,13 +291,21 @@ struct DumpVisitor : public RiffContainer::Visitor
             {
                 auto listChunk = static_cast<ListChunk*>(chunk);
                 // It's a container
-                SLANG_RETURN_ON_FAIL(write(listChunk, false, stream));
+                SLANG_RETURN_ON_FAIL(_write(listChunk, false, pos, stream));
+                pos += sizeof(RiffHeader) + calcAlignedListPayloadSize(listChunk, pos);
                 break;
             }
             case Chunk::Kind::Data:
             {
                 auto dataChunk = static_cast<DataChunk*>(chunk);
 
+                // Pad such that the payload is aligned
+                if (const size_t junkSize = calcAlignmentJunkSize(pos))
+                {
+                    SLANG_RETURN_ON_FAIL(_writeJunk(junkSize, stream));
+                    pos += junkSize;
+                }
+
                 // Must be a regular chunk with data
                 RiffHeader chunkHeader;
                 chunkHeader.type = dataChunk->m_fourCC;
@@ -259,6 +330,9 @@ struct DumpVisitor : public RiffContainer::Visitor
                     static const uint8_t trailing[kRiffPadSize] = { 0 };
                     SLANG_RETURN_ON_FAIL(stream->write(trailing, remainingSize));
                 }
+
+                pos += sizeof(RiffHeader) + getPadSize(dataChunk->m_payloadSize);
+                break;
             }
             default: break;
         }
@@ -270,6 +344,12 @@ struct DumpVisitor : public RiffContainer::Visitor
     return SLANG_OK;
 }
 
+/* static */SlangResult RiffUtil::write(RiffContainer::ListChunk* list, bool isRoot, Stream* stream)
+{
+    // Alignment is relative to the start of the list being written
+    return _write(list, isRoot, 0, stream);
+}
+
 /* static */SlangResult RiffUtil::write(RiffContainer* container, Stream* stream)
 {
     return write(container->getRoot(), true, stream);
@@ -343,6 +423,12 @@ struct DumpVisitor : public RiffContainer::Visitor
                 // Start a container
                 outContainer.startChunk(Chunk::Kind::List, header.subType);
             }
+            else if (header.chunk.type == RiffFourCC::kJunk)
+            {
+                // Only there for alignment, so skip it
+                SLANG_RETURN_ON_FAIL(skip(header.chunk, stream, nullptr));
+                remaining -= size_t(calcChunkTotalSize(header.chunk));
+            }
             else
             {
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
@@ -365,6 +451,121 @@ struct DumpVisitor : public RiffContainer::Visitor
     return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
 }
 
+/* static */SlangResult RiffUtil::readBuffer(const void* inData, size_t size, RiffContainer& outContainer)
+{
+    typedef RiffContainer::ScopeChunk ScopeChunk;
+    outContainer.reset();
+
+    RiffReadHelper reader((const uint8_t*)inData, size);
+
+    // Reads a header (handling list/riff types) from the buffer
+    auto readHeader = [&](RiffListHeader& outHeader) -> SlangResult
+    {
+        SLANG_RETURN_ON_FAIL(reader.read(outHeader.chunk));
+        outHeader.subType = 0;
+        if (isListType(outHeader.chunk.type))
+        {
+            SLANG_RETURN_ON_FAIL(reader.read(outHeader.subType));
+        }
+        return SLANG_OK;
+    };
+
+    size_t remaining;
+    {
+        RiffListHeader header;
+        SLANG_RETURN_ON_FAIL(readHeader(header));
+        if (!isListType(header.chunk.type))
+        {
+            return SLANG_FAIL;
+        }
+
+        remaining = getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+        // The root can't claim more than is in the buffer
+        if (remaining > reader.getRemainingSize())
+        {
+            return SLANG_FAIL;
+        }
+        outContainer.startChunk(Chunk::Kind::List, header.subType);
+    }
+
+    List<size_t> remainingStack;
+    while (true)
+    {
+        if (remaining == 0)
+        {
+            outContainer.endChunk();
+            if (remainingStack.getCount() <= 0)
+            {
+                break;
+            }
+
+            remaining = remainingStack.getLast();
+            remainingStack.removeLast();
+        }
+        else
+        {
+            RiffListHeader header;
+            SLANG_RETURN_ON_FAIL(readHeader(header));
+
+            // The amount of data can't be larger than what remains
+            if (header.chunk.size > remaining)
+            {
+                return SLANG_FAIL;
+            }
+
+            if (header.chunk.type == RiffFourCC::kList)
+            {
+                if (header.chunk.size & kRiffPadMask)
+                {
+                    SLANG_ASSERT(!"A list chunk can only have divisible by 2 size");
+                    return SLANG_FAIL;
+                }
+
+                const size_t padSize = getPadSize(header.chunk.size);
+
+                remaining -= sizeof(RiffHeader) + padSize;
+                remainingStack.add(remaining);
+
+                remaining = padSize - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+
+                outContainer.startChunk(Chunk::Kind::List, header.subType);
+            }
+            else
+            {
+                const size_t payloadSize = header.chunk.size;
+                const size_t readSize = getPadSize(payloadSize);
+
+                const uint8_t* payload = reader.getData();
+                SLANG_RETURN_ON_FAIL(reader.skip(readSize));
+
+                remaining -= sizeof(RiffHeader) + readSize;
+
+                // Junk is only there for alignment
+                if (header.chunk.type == RiffFourCC::kJunk)
+                {
+                    continue;
+                }
+
+                ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
+                RiffContainer::Data* data = outContainer.addData();
+
+                // Readers of the payload may reinterpret it as 8 byte aligned data, so we can only
+                // reference the buffer directly if the payload has that alignment.
+                if ((size_t(payload) & (RiffContainer::kPayloadMinAlignment - 1)) == 0)
+                {
+                    outContainer.setUnowned(data, const_cast<uint8_t*>(payload), payloadSize);
+                }
+                else
+                {
+                    outContainer.setPayload(data, payload, payloadSize);
+                }
+            }
+        }
+    }
+
+    return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RiffContainer::Chunk !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 SlangResult RiffContainer::Chunk::visit(Visitor* visitor)
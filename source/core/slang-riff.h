@@ -62,6 +62,8 @@ struct RiffFourCC
      static const FourCC kRiff = SLANG_FOUR_CC('R', 'I', 'F', 'F');
         /// A list is the same as a 'riff' except can be placed anywhere in hierarchy.  
      static const FourCC kList = SLANG_FOUR_CC('L', 'I', 'S', 'T');
+        /// Filler chunk. Its contents are meaningless, and readers skip over it. Used to align the payload of the chunk that follows.
+     static const FourCC kJunk = SLANG_FOUR_CC('J', 'U', 'N', 'K');
 private:
     RiffFourCC() = delete;
 };
@@ -476,13 +478,35 @@ struct RiffUtil
         /// Get the size taking into account padding
     static size_t getPadSize(size_t in) { return (in + kRiffPadMask) & ~size_t(kRiffPadMask); }
 
-        /// Write a chunk list and contents to a stream
+        /// Write a chunk list and contents to a stream.
+        ///
+        /// Junk chunks are inserted where needed, such that every data chunk payload is aligned to
+        /// RiffContainer::kPayloadMinAlignment relative to the start of the written list. This allows
+        /// `readBuffer` to reference every payload in place when the buffer is suitably aligned.
     static SlangResult write(ListChunk* listChunk, bool isRoot, Stream* stream);
         /// Write a container to the stream
     static SlangResult write(RiffContainer* container, Stream* stream);
 
         /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+
+        /// Read the RIFF held in memory at `data` into the container without copying payloads.
+        /// Data chunk payloads that are suitably aligned reference `data` directly (Ownership::NotOwned),
+        /// so `data` must remain valid (and unchanged) for the lifetime of the container.
+        /// Payloads that are not aligned to kPayloadMinAlignment (for example from a RIFF written
+        /// without alignment, or a misaligned `data`) are copied into the container's arena.
+    static SlangResult readBuffer(const void* data, size_t size, RiffContainer& outContainer);
+
+        /// Get the size of the junk chunk needed before a data chunk whose header starts at `offset`,
+        /// such that its payload is aligned to RiffContainer::kPayloadMinAlignment. Returns 0 if no junk is needed.
+    static size_t calcAlignmentJunkSize(size_t offset);
+        /// Get the size of the list payload (as stored in its header) when written by `write`
+        /// with the list header at `offset`.
+    static size_t calcAlignedListPayloadSize(ListChunk* listChunk, size_t offset);
+
+protected:
+    static SlangResult _write(ListChunk* listChunk, bool isRoot, size_t offset, Stream* stream);
+    static SlangResult _writeJunk(size_t junkSize, Stream* stream);
 };
 
 }
@@ -22,6 +22,7 @@
 #   include <windows.h>
 #endif
 
+#include <chrono>
 #include <memory>
 #include <sstream>
 
@@ -201,9 +202,7 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
 
     const auto debugInfoType = request.debugInfoType;
 
-    spvtools::Optimizer optimizer(targetEnv);
-
-    optimizer.SetMessageConsumer(
+    const auto messageConsumer =
         [&](spv_message_level_t level, const char* source, const spv_position_t& position, const char* message) {
             SPIRVOptimizationDiagnostic diag;
             diag.level = level;
@@ -217,7 +216,9 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
                 diag.message = message;
             }
             outDiags.push_back(diag);
-        });
+        };
+
+    std::vector<spvtools::Optimizer::PassToken> passes;
 
     // If debug info is being generated, propagate
     // line information into all SPIR-V instructions. This avoids loss of
@@ -225,7 +226,7 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
     // redundant information to minimize final SPRIR-V size.
     if (debugInfoType != SLANG_DEBUG_INFO_LEVEL_NONE)
     {
-        optimizer.RegisterPass(spvtools::CreatePropagateLineInfoPass());
+        passes.push_back(spvtools::CreatePropagateLineInfoPass());
     }
 
     spvtools::OptimizerOptions spvOptOptions;
@@ -252,13 +253,13 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
 
 #if 0
             // This is the previous 'default optimization' passes setting for glslang
-            optimizer.RegisterPass(spvtools::CreateMergeReturnPass());
-            optimizer.RegisterPass(spvtools::CreateInlineExhaustivePass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreatePrivateToLocalPass());
-            optimizer.RegisterPass(spvtools::CreateScalarReplacementPass(100));
-            optimizer.RegisterPass(spvtools::CreateLocalAccessChainConvertPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateMergeReturnPass());
+            passes.push_back(spvtools::CreateInlineExhaustivePass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreatePrivateToLocalPass());
+            passes.push_back(spvtools::CreateScalarReplacementPass(100));
+            passes.push_back(spvtools::CreateLocalAccessChainConvertPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
 #elif 1
             // 6Mb 27 secs (all passes up to 9) 
             // 9Mb 25 secs (all passes up to 7)
@@ -273,31 +274,31 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
             // Across a wide range of compilations this produced SPIR-V that is less than half size of the
             // previous -O1 passes above.
 
-            optimizer.RegisterPass(spvtools::CreateWrapOpKillPass());           // 1
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());       // 2
+            passes.push_back(spvtools::CreateWrapOpKillPass());           // 1
+            passes.push_back(spvtools::CreateDeadBranchElimPass());       // 2
 
-            optimizer.RegisterPass(spvtools::CreateMergeReturnPass());
-            optimizer.RegisterPass(spvtools::CreateInlineExhaustivePass());
+            passes.push_back(spvtools::CreateMergeReturnPass());
+            passes.push_back(spvtools::CreateInlineExhaustivePass());
 
-            optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass()); // 3
+            passes.push_back(spvtools::CreateEliminateDeadFunctionsPass()); // 3
 
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreatePrivateToLocalPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreatePrivateToLocalPass());
 
-            optimizer.RegisterPass(spvtools::CreateScalarReplacementPass(100));
+            passes.push_back(spvtools::CreateScalarReplacementPass(100));
 
-            optimizer.RegisterPass(spvtools::CreateCCPPass());                  // 4 *
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());       // 5
-            //optimizer.RegisterPass(spvtools::CreateIfConversionPass());         // 6
-            //optimizer.RegisterPass(spvtools::CreateBlockMergePass());           // 7 *
+            passes.push_back(spvtools::CreateCCPPass());                  // 4 *
+            passes.push_back(spvtools::CreateSimplificationPass());       // 5
+            //passes.push_back(spvtools::CreateIfConversionPass());         // 6
+            //passes.push_back(spvtools::CreateBlockMergePass());           // 7 *
 
-            optimizer.RegisterPass(spvtools::CreateLocalAccessChainConvertPass());
+            passes.push_back(spvtools::CreateLocalAccessChainConvertPass());
 
-            optimizer.RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass()); // 8
+            passes.push_back(spvtools::CreateLocalSingleBlockLoadStoreElimPass()); // 8
 
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
 
-            optimizer.RegisterPass(spvtools::CreateVectorDCEPass());            // 9
+            passes.push_back(spvtools::CreateVectorDCEPass());            // 9
 
 #else
             // The following selection of passes was created by
@@ -325,39 +326,39 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
             //
             // So (for test case) approximately 13x compilation speed.
             // Binary twice the size of smallest SPIR-V size and 1/3 the size of the previous -O size 
-            optimizer.RegisterPass(spvtools::CreateWrapOpKillPass());
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());     // 15
-            optimizer.RegisterPass(spvtools::CreateMergeReturnPass());
-            optimizer.RegisterPass(spvtools::CreateInlineExhaustivePass());
-            optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass()); // 9
-            optimizer.RegisterPass(spvtools::CreatePrivateToLocalPass());
-            //optimizer.RegisterPass(spvtools::CreateScalarReplacementPass(0));   // 12
-            //optimizer.RegisterPass(spvtools::CreateLocalMultiStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateCCPPass());
-            //optimizer.RegisterPass(spvtools::CreateLoopUnrollPass(true));     // 1
-            //optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());     // 4
-            //optimizer.RegisterPass(spvtools::CreateSimplificationPass());       // 11
-            optimizer.RegisterPass(spvtools::CreateScalarReplacementPass(0));
-            //optimizer.RegisterPass(spvtools::CreateLocalSingleStoreElimPass());
-            //optimizer.RegisterPass(spvtools::CreateIfConversionPass());       // 7
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());       // 13
-            //optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());      // 10
-            //optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());         // 6 + 15
-            //optimizer.RegisterPass(spvtools::CreateBlockMergePass());             // 8
-            optimizer.RegisterPass(spvtools::CreateLocalAccessChainConvertPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());        // 5
-            //optimizer.RegisterPass(spvtools::CreateCopyPropagateArraysPass());          // 1
-            optimizer.RegisterPass(spvtools::CreateVectorDCEPass());
-            optimizer.RegisterPass(spvtools::CreateDeadInsertElimPass());
-            optimizer.RegisterPass(spvtools::CreateEliminateDeadMembersPass());
-            //optimizer.RegisterPass(spvtools::CreateLocalSingleStoreElimPass());
-            //optimizer.RegisterPass(spvtools::CreateBlockMergePass());                 // 3
-            //optimizer.RegisterPass(spvtools::CreateLocalMultiStoreElimPass());        // 2
-            //optimizer.RegisterPass(spvtools::CreateRedundancyEliminationPass());
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());             // 14
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateCFGCleanupPass());
+            passes.push_back(spvtools::CreateWrapOpKillPass());
+            passes.push_back(spvtools::CreateDeadBranchElimPass());     // 15
+            passes.push_back(spvtools::CreateMergeReturnPass());
+            passes.push_back(spvtools::CreateInlineExhaustivePass());
+            passes.push_back(spvtools::CreateEliminateDeadFunctionsPass()); // 9
+            passes.push_back(spvtools::CreatePrivateToLocalPass());
+            //passes.push_back(spvtools::CreateScalarReplacementPass(0));   // 12
+            //passes.push_back(spvtools::CreateLocalMultiStoreElimPass());
+            passes.push_back(spvtools::CreateCCPPass());
+            //passes.push_back(spvtools::CreateLoopUnrollPass(true));     // 1
+            //passes.push_back(spvtools::CreateDeadBranchElimPass());     // 4
+            //passes.push_back(spvtools::CreateSimplificationPass());       // 11
+            passes.push_back(spvtools::CreateScalarReplacementPass(0));
+            //passes.push_back(spvtools::CreateLocalSingleStoreElimPass());
+            //passes.push_back(spvtools::CreateIfConversionPass());       // 7
+            passes.push_back(spvtools::CreateSimplificationPass());       // 13
+            //passes.push_back(spvtools::CreateAggressiveDCEPass());      // 10
+            //passes.push_back(spvtools::CreateDeadBranchElimPass());         // 6 + 15
+            //passes.push_back(spvtools::CreateBlockMergePass());             // 8
+            passes.push_back(spvtools::CreateLocalAccessChainConvertPass());
+            passes.push_back(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());        // 5
+            //passes.push_back(spvtools::CreateCopyPropagateArraysPass());          // 1
+            passes.push_back(spvtools::CreateVectorDCEPass());
+            passes.push_back(spvtools::CreateDeadInsertElimPass());
+            passes.push_back(spvtools::CreateEliminateDeadMembersPass());
+            //passes.push_back(spvtools::CreateLocalSingleStoreElimPass());
+            //passes.push_back(spvtools::CreateBlockMergePass());                 // 3
+            //passes.push_back(spvtools::CreateLocalMultiStoreElimPass());        // 2
+            //passes.push_back(spvtools::CreateRedundancyEliminationPass());
+            passes.push_back(spvtools::CreateSimplificationPass());             // 14
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateCFGCleanupPass());
 #endif
 
             break;
@@ -373,62 +374,62 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
             // Use the same passes when specifying the "-O" flag in spirv-opt
             // Roughly equivalent to `RegisterPerformancePasses`
 
-            optimizer.RegisterPass(spvtools::CreateWrapOpKillPass());
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
-            optimizer.RegisterPass(spvtools::CreateMergeReturnPass());
-            optimizer.RegisterPass(spvtools::CreateInlineExhaustivePass());
-            optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreatePrivateToLocalPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateScalarReplacementPass());
-            optimizer.RegisterPass(spvtools::CreateLocalAccessChainConvertPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateWrapOpKillPass());
+            passes.push_back(spvtools::CreateDeadBranchElimPass());
+            passes.push_back(spvtools::CreateMergeReturnPass());
+            passes.push_back(spvtools::CreateInlineExhaustivePass());
+            passes.push_back(spvtools::CreateEliminateDeadFunctionsPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreatePrivateToLocalPass());
+            passes.push_back(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
+            passes.push_back(spvtools::CreateLocalSingleStoreElimPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateScalarReplacementPass());
+            passes.push_back(spvtools::CreateLocalAccessChainConvertPass());
+            passes.push_back(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
+            passes.push_back(spvtools::CreateLocalSingleStoreElimPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
 
             // We run CompactIdsPass here, because CreateLocalMultiStoreElimPass can explode
             // id usage (by a factor of 10), and compacting ids here has been shown to half
             // id usage with a complex shader.
-            optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
+            passes.push_back(spvtools::CreateCompactIdsPass());
 
             // Note that CreateLocalMultiStoreElimPass really just does a SSARewritePass
-            optimizer.RegisterPass(spvtools::CreateLocalMultiStoreElimPass());
-
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateCCPPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateLoopUnrollPass(true));
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
-            optimizer.RegisterPass(spvtools::CreateRedundancyEliminationPass());
-            optimizer.RegisterPass(spvtools::CreateCombineAccessChainsPass());
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());
-            optimizer.RegisterPass(spvtools::CreateScalarReplacementPass());
-            optimizer.RegisterPass(spvtools::CreateLocalAccessChainConvertPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateLocalSingleStoreElimPass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateSSARewritePass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateVectorDCEPass());
-            optimizer.RegisterPass(spvtools::CreateDeadInsertElimPass());
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());
-            optimizer.RegisterPass(spvtools::CreateIfConversionPass());
-            optimizer.RegisterPass(spvtools::CreateCopyPropagateArraysPass());
-            optimizer.RegisterPass(spvtools::CreateReduceLoadSizePass());
-            optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
-            optimizer.RegisterPass(spvtools::CreateBlockMergePass());
-            optimizer.RegisterPass(spvtools::CreateRedundancyEliminationPass());
-            optimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
-            optimizer.RegisterPass(spvtools::CreateBlockMergePass());
-            optimizer.RegisterPass(spvtools::CreateSimplificationPass());
+            passes.push_back(spvtools::CreateLocalMultiStoreElimPass());
+
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateCCPPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateLoopUnrollPass(true));
+            passes.push_back(spvtools::CreateDeadBranchElimPass());
+            passes.push_back(spvtools::CreateRedundancyEliminationPass());
+            passes.push_back(spvtools::CreateCombineAccessChainsPass());
+            passes.push_back(spvtools::CreateSimplificationPass());
+            passes.push_back(spvtools::CreateScalarReplacementPass());
+            passes.push_back(spvtools::CreateLocalAccessChainConvertPass());
+            passes.push_back(spvtools::CreateLocalSingleBlockLoadStoreElimPass());
+            passes.push_back(spvtools::CreateLocalSingleStoreElimPass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateSSARewritePass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateVectorDCEPass());
+            passes.push_back(spvtools::CreateDeadInsertElimPass());
+            passes.push_back(spvtools::CreateDeadBranchElimPass());
+            passes.push_back(spvtools::CreateSimplificationPass());
+            passes.push_back(spvtools::CreateIfConversionPass());
+            passes.push_back(spvtools::CreateCopyPropagateArraysPass());
+            passes.push_back(spvtools::CreateReduceLoadSizePass());
+            passes.push_back(spvtools::CreateAggressiveDCEPass());
+            passes.push_back(spvtools::CreateBlockMergePass());
+            passes.push_back(spvtools::CreateRedundancyEliminationPass());
+            passes.push_back(spvtools::CreateDeadBranchElimPass());
+            passes.push_back(spvtools::CreateBlockMergePass());
+            passes.push_back(spvtools::CreateSimplificationPass());
 
             // We again run compaction to try and ensure the final output uses ids that are in range.
             // On a complex shader, this reduced the amount ids by 5.
-            optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
+            passes.push_back(spvtools::CreateCompactIdsPass());
 
             break;
         }
@@ -436,12 +437,51 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
 
     if (debugInfoType != SLANG_DEBUG_INFO_LEVEL_NONE)
     {
-        optimizer.RegisterPass(spvtools::CreateRedundantLineInfoElimPass());
+        passes.push_back(spvtools::CreateRedundantLineInfoElimPass());
     }
 
     spvOptOptions.set_run_validator(false); // Don't run the validator by default
 
+    if (request.passTimingFunc)
     {
+        // Run each pass with its own optimizer so it can be timed. The module is serialized and
+        // parsed again between passes, which adds some time overall, but not to the passes.
+        for (auto& pass : passes)
+        {
+            spvtools::Optimizer optimizer(targetEnv);
+            optimizer.SetMessageConsumer(messageConsumer);
+            optimizer.RegisterPass(std::move(pass));
+
+            std::vector<unsigned int> optSpirv;
+
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            const bool succeeded = optimizer.Run(ioSpirv.data(), ioSpirv.size(), &optSpirv, spvOptOptions);
+            const std::chrono::duration<double> elapsedTime = std::chrono::high_resolution_clock::now() - startTime;
+
+            glslang_SPIRVPassTiming timing;
+            timing.passName = optimizer.GetPassNames()[0];
+            timing.seconds = elapsedTime.count();
+            timing.wordCountBefore = ioSpirv.size();
+            timing.wordCountAfter = succeeded ? optSpirv.size() : ioSpirv.size();
+            request.passTimingFunc(&timing, request.passTimingUserData);
+
+            if (!succeeded)
+            {
+                break;
+            }
+            ioSpirv.swap(optSpirv);
+        }
+        return;
+    }
+
+    {
+        spvtools::Optimizer optimizer(targetEnv);
+        optimizer.SetMessageConsumer(messageConsumer);
+        for (auto& pass : passes)
+        {
+            optimizer.RegisterPass(std::move(pass));
+        }
+
         // Put the output optimized spirv into optSpirv
         std::vector<unsigned int> optSpirv;
 
@@ -8,6 +8,17 @@
 
 typedef void (*glslang_OutputFunc)(void const* data, size_t size, void* userData);
 
+/// The time taken by a single spirv-opt pass, and the size of the module before and after it ran
+struct glslang_SPIRVPassTiming
+{
+    const char*         passName;
+    double              seconds;
+    size_t              wordCountBefore;
+    size_t              wordCountAfter;
+};
+
+typedef void (*glslang_PassTimingFunc)(const glslang_SPIRVPassTiming* timing, void* userData);
+
 enum
 {
     GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV,
@@ -127,6 +138,11 @@ struct glslang_CompileRequest_1_2
 
     // glslang_CompileRequest_1_2 fields
     const char* entryPointName; // The name of the entrypoint that will appear in output spirv.
+
+    // Fields added to 1.2 later. A request from an older caller is smaller (see sizeInBytes), and these are zeroed.
+
+    glslang_PassTimingFunc passTimingFunc;      ///< If set, spirv-opt passes are run one at a time, and each is reported when it completes
+    void* passTimingUserData;
 };
 
 inline void glslang_CompileRequest_1_0::set(const glslang_CompileRequest_1_1& in)
@@ -211,6 +211,7 @@ namespace SlangRecord
         CASE(NoHLSLPackConstantBufferElements);
         CASE(ValidateUniformity);
         CASE(AllowGLSL);
+        CASE(EnableExperimentalPasses);
         CASE(ArchiveType);
         CASE(CompileStdLib);
         CASE(Doc);
@@ -221,6 +222,12 @@ namespace SlangRecord
         CASE(SaveStdLibBinSource);
         CASE(TrackLiveness);
         CASE(LoopInversion);
+        CASE(IncrementalSimplification);
+        CASE(ReportPerfTrace);
+        CASE(DownstreamCache);
+        CASE(ReportDownstreamPassTime);
+        CASE(ParallelSPIRVOptimization);
+        CASE(SpecializationCache);
         CASE(CountOfParsableOptions);
         CASE(DebugInformationFormat);
         CASE(VulkanBindShiftAll);
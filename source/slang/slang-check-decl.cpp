@@ -17,6 +17,7 @@
 #include "slang-ast-synthesis.h"
 #include "slang-ast-reflect.h"
 #include "slang-ast-iterator.h"
+#include "../core/slang-performance-profiler.h"
 #include <limits>
 
 namespace Slang
@@ -2778,8 +2779,25 @@ namespace Slang
         }
     }
 
+        /// Get the name used to profile bringing all the decls in a module up to `state`
+    static const char* _getCheckModuleProfileName(DeclCheckState state)
+    {
+        switch (state)
+        {
+        case DeclCheckState::ScopesWired:           return "checkModule::ScopesWired";
+        case DeclCheckState::ReadyForReference:     return "checkModule::ReadyForReference";
+        case DeclCheckState::ReadyForLookup:        return "checkModule::ReadyForLookup";
+        case DeclCheckState::ReadyForConformances:  return "checkModule::ReadyForConformances";
+        case DeclCheckState::DefinitionChecked:     return "checkModule::DefinitionChecked";
+        case DeclCheckState::CapabilityChecked:     return "checkModule::CapabilityChecked";
+        default:                                    return "checkModule::Other";
+        }
+    }
+
     void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
     {
+        SLANG_PROFILE;
+
         // When we are dealing with code from the standard library,
         // there is a potential problem where we might need to look
         // up built-in types like `Int` through the session (e.g.,
@@ -2952,6 +2970,18 @@ namespace Slang
             // to the subset of declarations coming from a given source
             // file.
             //
+            // Each phase is profiled separately, so that the time spent
+            // checking function bodies (`DefinitionChecked`) can be told
+            // apart from the time spent on signatures and conformances.
+            //
+            // TODO: Function bodies are checked serially, on the thread
+            // calling `checkModule`, and there is no option to check them
+            // in parallel. Doing so would first need `ensureDecl`, the
+            // interning done by `ASTBuilder::getOrCreate`, the
+            // `TypeCheckingCache` and the `DiagnosticSink` to be made safe
+            // to use from several threads.
+            //
+            PerformanceProfilerFuncRAIIContext profileContext(_getCheckModuleProfileName(s));
             ensureAllDeclsRec(moduleDecl, s);
         }
 
@@ -160,6 +160,23 @@ namespace Slang
         return compiler;
     }
 
+    PersistentCache* Session::getDownstreamArtifactCache(const String& directory)
+    {
+        std::lock_guard<std::mutex> lock(m_downstreamArtifactCacheMutex);
+
+        if (auto cache = m_downstreamArtifactCaches.tryGetValue(directory))
+        {
+            return *cache;
+        }
+
+        PersistentCache::Desc desc;
+        desc.directory = directory.getBuffer();
+
+        RefPtr<PersistentCache> cache = new PersistentCache(desc);
+        m_downstreamArtifactCaches.add(directory, cache);
+        return cache;
+    }
+
     void checkTranslationUnit(
         TranslationUnitRequest* translationUnit,
         LoadedModuleDictionary& loadedModules)
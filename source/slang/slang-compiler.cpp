@@ -7,6 +7,9 @@
 #include "../core/slang-string-util.h"
 #include "../core/slang-hex-dump-util.h"
 #include "../core/slang-riff.h"
+#include "../core/slang-riff-file-system.h"
+#include "../core/slang-file-system.h"
+#include "../core/slang-stream.h"
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-castable.h"
@@ -23,6 +26,7 @@
 #include "../compiler-core/slang-artifact-impl.h"
 #include "../compiler-core/slang-artifact-util.h"
 #include "../compiler-core/slang-artifact-associated.h"
+#include "../compiler-core/slang-artifact-associated-impl.h"
 #include "../compiler-core/slang-artifact-diagnostic-util.h"
 #include "../compiler-core/slang-artifact-container-util.h"
 
@@ -42,6 +46,12 @@
 #include "slang-serialize-ast.h"
 #include "slang-serialize-container.h"
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace Slang
 {
 
@@ -1025,6 +1035,324 @@ namespace Slang
         return false;
     }
 
+    static void _appendToDigest(DigestBuilder<SHA1>& builder, const CharSlice& slice)
+    {
+        // Include the length, so the end of one string can't be confused with the start of the next
+        builder.append(slice.count);
+        builder.append(slice.data, slice.count);
+    }
+
+        /// True if the output of compiling with `options` only depends on what is hashed
+        /// by _calcDownstreamCacheKey.
+    static bool _canCacheDownstreamCompile(const DownstreamCompileOptions& options)
+    {
+        // Include paths and libraries reference files whose contents aren't part of the key, and
+        // a module path means the output is expected at a particular place on the file system.
+        //
+        // NOTE! Headers the source includes by absolute path (such as a prelude set to
+        // `#include "<path>"`) are not part of the key either.
+        //
+        // Pass times are reported as diagnostics, and replaying the times of an earlier compile
+        // would be misleading.
+        return options.sourceArtifacts.count > 0 &&
+            !options.reportPassTimes &&
+            options.includePaths.count == 0 &&
+            options.libraries.count == 0 &&
+            options.libraryPaths.count == 0 &&
+            options.modulePath.count == 0;
+    }
+
+    static SlangResult _calcDownstreamCacheKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache::Key& outKey)
+    {
+        DigestBuilder<SHA1> builder;
+
+        // The compiler and its version
+        const auto& desc = compiler->getDesc();
+        builder.append(desc.type);
+
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            builder.append(versionString);
+        }
+        else
+        {
+            builder.append(desc.version.m_major);
+            builder.append(desc.version.m_minor);
+            builder.append(desc.version.m_patch);
+        }
+
+        // The source, and the names used to report diagnostics in it
+        for (IArtifact* sourceArtifact : options.sourceArtifacts)
+        {
+            ComPtr<ISlangBlob> sourceBlob;
+            SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef()));
+            builder.append(sourceBlob->getBufferSize());
+            builder.append(sourceBlob);
+
+            const char* name = sourceArtifact->getName();
+            _appendToDigest(builder, CharSlice(name ? name : ""));
+        }
+
+        // The options
+        builder.append(options.optimizationLevel);
+        builder.append(options.debugInfoType);
+        builder.append(options.targetType);
+        builder.append(options.sourceLanguage);
+        builder.append(options.floatingPointMode);
+        builder.append(options.pipelineType);
+        builder.append(options.matrixLayout);
+        builder.append(options.flags);
+        builder.append(options.platform);
+        builder.append(options.stage);
+        builder.append(options.m_debugInfoFormat);
+
+        _appendToDigest(builder, options.entryPointName);
+        _appendToDigest(builder, options.profileName);
+
+        builder.append(options.defines.count);
+        for (const auto& define : options.defines)
+        {
+            _appendToDigest(builder, define.nameWithSig);
+            _appendToDigest(builder, define.value);
+        }
+
+        builder.append(options.compilerSpecificArguments.count);
+        for (const auto& arg : options.compilerSpecificArguments)
+        {
+            _appendToDigest(builder, arg);
+        }
+
+        builder.append(options.requiredCapabilityVersions.count);
+        for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+        {
+            builder.append(capabilityVersion.kind);
+            builder.append(capabilityVersion.version.m_major);
+            builder.append(capabilityVersion.version.m_minor);
+            builder.append(capabilityVersion.version.m_patch);
+        }
+
+        outKey = builder.finalize();
+        return SLANG_OK;
+    }
+
+    // Diagnostics can't be written into an artifact container, so a cached compile stores them
+    // in a file of their own, using the layout below.
+
+    static void _writeDiagnosticsString(OwnedMemoryStream& stream, const CharSlice& slice)
+    {
+        const uint32_t count = uint32_t(slice.count);
+        stream.write(&count, sizeof(count));
+        stream.write(slice.data, slice.count);
+    }
+
+    static SlangResult _writeDownstreamDiagnostics(IArtifactDiagnostics* diagnostics, ComPtr<ISlangBlob>& outBlob)
+    {
+        OwnedMemoryStream stream(FileAccess::Write);
+
+        const int32_t result = diagnostics->getResult();
+        const uint32_t count = uint32_t(diagnostics->getCount());
+        stream.write(&result, sizeof(result));
+        stream.write(&count, sizeof(count));
+
+        for (Index i = 0; i < diagnostics->getCount(); ++i)
+        {
+            const auto diagnostic = diagnostics->getAt(i);
+
+            const uint8_t severityAndStage[] = { uint8_t(diagnostic->severity), uint8_t(diagnostic->stage) };
+            const int64_t location[] = { int64_t(diagnostic->location.line), int64_t(diagnostic->location.column) };
+            stream.write(severityAndStage, sizeof(severityAndStage));
+            stream.write(location, sizeof(location));
+
+            _writeDiagnosticsString(stream, diagnostic->text);
+            _writeDiagnosticsString(stream, diagnostic->code);
+            _writeDiagnosticsString(stream, diagnostic->filePath);
+        }
+        _writeDiagnosticsString(stream, diagnostics->getRaw());
+
+        List<uint8_t> contents;
+        stream.swapContents(contents);
+        outBlob = ListBlob::moveCreate(contents);
+        return SLANG_OK;
+    }
+
+    static SlangResult _readDiagnosticsString(MemoryStreamBase& stream, List<char>& outChars)
+    {
+        uint32_t count;
+        SLANG_RETURN_ON_FAIL(stream.readExactly(&count, sizeof(count)));
+        if (Int64(count) > stream.getContents().getCount() - stream.getPosition())
+        {
+            return SLANG_FAIL;
+        }
+        outChars.setCount(Index(count) + 1);
+        SLANG_RETURN_ON_FAIL(stream.readExactly(outChars.getBuffer(), count));
+        outChars[count] = 0;
+        return SLANG_OK;
+    }
+
+    static SlangResult _readDownstreamDiagnostics(ISlangBlob* blob, ComPtr<IArtifactDiagnostics>& outDiagnostics)
+    {
+        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+
+        auto diagnostics = ArtifactDiagnostics::create();
+
+        int32_t result;
+        uint32_t count;
+        SLANG_RETURN_ON_FAIL(stream.readExactly(&result, sizeof(result)));
+        SLANG_RETURN_ON_FAIL(stream.readExactly(&count, sizeof(count)));
+        diagnostics->setResult(SlangResult(result));
+
+        List<char> text, code, filePath;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint8_t severityAndStage[2];
+            int64_t location[2];
+            SLANG_RETURN_ON_FAIL(stream.readExactly(severityAndStage, sizeof(severityAndStage)));
+            SLANG_RETURN_ON_FAIL(stream.readExactly(location, sizeof(location)));
+
+            SLANG_RETURN_ON_FAIL(_readDiagnosticsString(stream, text));
+            SLANG_RETURN_ON_FAIL(_readDiagnosticsString(stream, code));
+            SLANG_RETURN_ON_FAIL(_readDiagnosticsString(stream, filePath));
+
+            // The diagnostics copy the text they are given
+            ArtifactDiagnostic diagnostic;
+            diagnostic.severity = ArtifactDiagnostic::Severity(severityAndStage[0]);
+            diagnostic.stage = ArtifactDiagnostic::Stage(severityAndStage[1]);
+            diagnostic.location.line = Int(location[0]);
+            diagnostic.location.column = Int(location[1]);
+            diagnostic.text = TerminatedCharSlice(text.getBuffer(), text.getCount() - 1);
+            diagnostic.code = TerminatedCharSlice(code.getBuffer(), code.getCount() - 1);
+            diagnostic.filePath = TerminatedCharSlice(filePath.getBuffer(), filePath.getCount() - 1);
+            diagnostics->add(diagnostic);
+        }
+
+        List<char> raw;
+        SLANG_RETURN_ON_FAIL(_readDiagnosticsString(stream, raw));
+        diagnostics->setRaw(CharSlice(raw.getBuffer(), raw.getCount() - 1));
+
+        outDiagnostics = diagnostics;
+        return SLANG_OK;
+    }
+
+    static const char kDownstreamCacheArtifactDirectory[] = "artifact";
+    static const char kDownstreamCacheDiagnosticsPath[] = "diagnostics";
+
+        /// Write `artifact` produced by a downstream compile, including everything associated with it
+        /// (such as diagnostics, debug info and source maps) into a blob that can be stored in a cache.
+    static SlangResult _writeDownstreamCacheEntry(IArtifact* artifact, ComPtr<ISlangBlob>& outBlob)
+    {
+        // Turn the hierarchy into blobs. Artifacts that can't be represented as a blob (such as
+        // the diagnostics) are dropped, but this fails if the main product can't be.
+        ComPtr<IArtifact> filteredArtifact;
+        SLANG_RETURN_ON_FAIL(ArtifactContainerUtil::filter(artifact, filteredArtifact));
+        if (!filteredArtifact)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<ISlangMutableFileSystem> fileSystem(new RiffFileSystem(nullptr));
+
+        SLANG_RETURN_ON_FAIL(fileSystem->createDirectory(kDownstreamCacheArtifactDirectory));
+        {
+            ComPtr<ISlangMutableFileSystem> artifactFileSystem(new RelativeFileSystem(fileSystem, kDownstreamCacheArtifactDirectory));
+            SLANG_RETURN_ON_FAIL(ArtifactContainerUtil::writeContainer(filteredArtifact, String(), artifactFileSystem));
+        }
+
+        if (auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact))
+        {
+            ComPtr<ISlangBlob> diagnosticsBlob;
+            SLANG_RETURN_ON_FAIL(_writeDownstreamDiagnostics(diagnostics, diagnosticsBlob));
+            SLANG_RETURN_ON_FAIL(fileSystem->saveFileBlob(kDownstreamCacheDiagnosticsPath, diagnosticsBlob));
+        }
+
+        auto archiveFileSystem = as<IArchiveFileSystem>(fileSystem);
+        SLANG_ASSERT(archiveFileSystem);
+        return archiveFileSystem->storeArchive(true, outBlob.writeRef());
+    }
+
+        /// Recreate the artifact written by _writeDownstreamCacheEntry for a compile to `targetType`.
+    static SlangResult _readDownstreamCacheEntry(ISlangBlob* blob, SlangCompileTarget targetType, ComPtr<IArtifact>& outArtifact)
+    {
+        ComPtr<ISlangMutableFileSystem> fileSystem(new RiffFileSystem(nullptr));
+        auto archiveFileSystem = as<IArchiveFileSystem>(fileSystem);
+        SLANG_ASSERT(archiveFileSystem);
+        SLANG_RETURN_ON_FAIL(archiveFileSystem->loadArchive(blob->getBufferPointer(), blob->getBufferSize()));
+
+        ComPtr<IArtifact> readArtifact;
+        {
+            ComPtr<ISlangMutableFileSystem> artifactFileSystem(new RelativeFileSystem(fileSystem, kDownstreamCacheArtifactDirectory));
+            SLANG_RETURN_ON_FAIL(ArtifactContainerUtil::readContainer(artifactFileSystem, readArtifact));
+        }
+        if (!readArtifact)
+        {
+            return SLANG_FAIL;
+        }
+
+        // The container only records the kind of each artifact by its file extension, so the
+        // product is recreated with the desc for the target. Only compiles producing that desc
+        // are cached.
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(targetType);
+
+        ComPtr<ISlangBlob> productBlob;
+        SLANG_RETURN_ON_FAIL(readArtifact->loadBlob(ArtifactKeep::Yes, productBlob.writeRef()));
+        artifact->addRepresentationUnknown(productBlob);
+
+        for (IArtifact* child : readArtifact->getChildren())
+        {
+            artifact->addChild(child);
+        }
+        for (IArtifact* associated : readArtifact->getAssociated())
+        {
+            artifact->addAssociated(associated);
+        }
+
+        ComPtr<ISlangBlob> diagnosticsBlob;
+        if (SLANG_SUCCEEDED(fileSystem->loadFile(kDownstreamCacheDiagnosticsPath, diagnosticsBlob.writeRef())))
+        {
+            ComPtr<IArtifactDiagnostics> diagnostics;
+            SLANG_RETURN_ON_FAIL(_readDownstreamDiagnostics(diagnosticsBlob, diagnostics));
+            ArtifactUtil::addAssociated(artifact, diagnostics);
+        }
+
+        outArtifact = artifact;
+        return SLANG_OK;
+    }
+
+        /// Compile with `compiler`, reusing the output from `cache` if the same compilation has been
+        /// performed before. `cache` can be nullptr, in which case this just compiles.
+    static SlangResult _compileWithDownstreamCache(PersistentCache* cache, IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, ComPtr<IArtifact>& outArtifact)
+    {
+        PersistentCache::Key key;
+        if (!cache ||
+            !_canCacheDownstreamCompile(options) ||
+            SLANG_FAILED(_calcDownstreamCacheKey(compiler, options, key)))
+        {
+            return compiler->compile(options, outArtifact.writeRef());
+        }
+
+        // If the entry can't be read back, it is treated as a miss, and replaced below
+        ComPtr<ISlangBlob> cachedBlob;
+        if (SLANG_SUCCEEDED(cache->readEntry(key, cachedBlob.writeRef())) &&
+            SLANG_SUCCEEDED(_readDownstreamCacheEntry(cachedBlob, options.targetType, outArtifact)))
+        {
+            return SLANG_OK;
+        }
+
+        SLANG_RETURN_ON_FAIL(compiler->compile(options, outArtifact.writeRef()));
+
+        // A compile that failed has no product to write, so isn't cached. Otherwise the product
+        // is cached along with its diagnostics, so any warnings are reported again on a hit.
+        if (outArtifact->getDesc() == ArtifactDescUtil::makeDescForCompileTarget(options.targetType))
+        {
+            ComPtr<ISlangBlob> entryBlob;
+            if (SLANG_SUCCEEDED(_writeDownstreamCacheEntry(outArtifact, entryBlob)))
+            {
+                cache->writeEntry(key, entryBlob);
+            }
+        }
+        return SLANG_OK;
+    }
+
     SlangResult passthroughDownstreamDiagnostics(DiagnosticSink* sink, IDownstreamCompiler* compiler, IArtifact* artifact)
     {
         auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
@@ -1090,6 +1418,118 @@ namespace Slang
         return SLANG_OK;
     }
 
+    void SPIRVOptimizationBatch::add(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, IArtifact* artifact)
+    {
+        Job job;
+        job.compiler = compiler;
+        job.options = options;
+        job.artifact = artifact;
+        m_jobs.add(job);
+    }
+
+    // Returns true if `compiler` is known to allow `compile` to be called from several threads at once.
+    //
+    // spirv-opt is run through slang-glslang, which initializes glslang under a mutex and creates a
+    // new spvtools::Optimizer for each call, so no state is shared between calls.
+    static bool _canCompileConcurrently(IDownstreamCompiler* compiler)
+    {
+        return compiler->getDesc().type == SLANG_PASS_THROUGH_SPIRV_OPT;
+    }
+
+    SlangResult SPIRVOptimizationBatch::run(Session* session, DiagnosticSink* sink)
+    {
+        if (m_jobs.getCount() == 0)
+        {
+            return SLANG_OK;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Each job only touches its own artifacts, but IDownstreamCompiler makes no promise that
+        // `compile` can be called from several threads at once. Jobs for the same compiler are
+        // therefore run one at a time, unless the compiler is known to allow it.
+        List<IDownstreamCompiler*> compilers;
+        List<Index> jobCompilerIndices;
+        for (const auto& job : m_jobs)
+        {
+            Index compilerIndex = compilers.indexOf(job.compiler.get());
+            if (compilerIndex < 0)
+            {
+                compilerIndex = compilers.getCount();
+                compilers.add(job.compiler);
+            }
+            jobCompilerIndices.add(compilerIndex);
+        }
+        std::unique_ptr<std::mutex[]> compilerMutexes(new std::mutex[compilers.getCount()]);
+
+        std::atomic<Index> nextJobIndex = 0;
+        auto runJobs = [&]()
+        {
+            for (;;)
+            {
+                const Index jobIndex = nextJobIndex++;
+                if (jobIndex >= m_jobs.getCount())
+                {
+                    break;
+                }
+
+                Job& job = m_jobs[jobIndex];
+                job.options.sourceArtifacts = makeSlice(job.artifact.readRef(), 1);
+
+                std::unique_lock<std::mutex> compilerLock(compilerMutexes[jobCompilerIndices[jobIndex]], std::defer_lock);
+                if (!_canCompileConcurrently(job.compiler))
+                {
+                    compilerLock.lock();
+                }
+                job.result = job.compiler->compile(job.options, job.optimizedArtifact.writeRef());
+            }
+        };
+
+        const Index threadCount = Math::Min(m_jobs.getCount(), Index(std::thread::hardware_concurrency()));
+        List<std::thread> threads;
+        for (Index i = 1; i < threadCount; ++i)
+        {
+            threads.add(std::thread(runJobs));
+        }
+        runJobs();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        auto elapsedTime = (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001;
+        session->addDownstreamCompileTime(elapsedTime);
+
+        // The artifacts have already been handed out as the entry point results, so they
+        // are updated in place.
+        SlangResult result = SLANG_OK;
+        for (auto& job : m_jobs)
+        {
+            if (SLANG_FAILED(job.result))
+            {
+                continue;
+            }
+
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_SUCCEEDED(job.optimizedArtifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+            {
+                job.artifact->clear(IArtifact::ContainedKind::Representation);
+                job.artifact->addRepresentationUnknown(blob);
+            }
+            for (auto associated : job.optimizedArtifact->getAssociated())
+            {
+                job.artifact->addAssociated(associated);
+            }
+
+            if (SLANG_FAILED(passthroughDownstreamDiagnostics(sink, job.compiler, job.optimizedArtifact)))
+            {
+                result = SLANG_FAIL;
+            }
+        }
+        m_jobs.clear();
+        return result;
+    }
+
     bool CodeGenContext::isPrecompiled()
     {
         auto program = getProgram();
@@ -1276,6 +1716,13 @@ namespace Slang
                 sourceCodeGenContext.maybeDumpIntermediate(sourceArtifact);
 
                 sourceLanguage = (SourceLanguage)TypeConvertUtil::getSourceLanguageFromTarget((SlangCompileTarget)sourceTarget);
+
+                // Emitted C++ starts with the prelude, which is the same for every compilation, so
+                // the downstream compiler may be able to precompile it.
+                if (sourceLanguage == SourceLanguage::CPP)
+                {
+                    options.sourcePrelude = SliceUtil::asTerminatedCharSlice(getSession()->getPreludeForLanguage(sourceLanguage));
+                }
             }
         }
 
@@ -1492,6 +1939,8 @@ namespace Slang
                 default: SLANG_ASSERT(!"Unhandled floating point mode");
             }
 
+            options.reportPassTimes = getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamPassTime);
+
             {
                 // We need to look at the stage of the entry point(s) we are
                 // being asked to compile, since this will determine the
@@ -1591,10 +2040,21 @@ namespace Slang
         options.libraries = SliceUtil::asSlice(libraries);
         options.libraryPaths = allocator.allocate(libraryPaths);
         
+        // Pass-through compilations can include other files from the source, so only the output of
+        // compiling source we generated is cached.
+        PersistentCache* downstreamCache = nullptr;
+        {
+            const String cacheDirectory = getTargetProgram()->getOptionSet().getStringOption(CompilerOptionName::DownstreamCache);
+            if (cacheDirectory.getLength() && !isPassThroughEnabled())
+            {
+                downstreamCache = getSession()->getDownstreamArtifactCache(cacheDirectory);
+            }
+        }
+
         // Compile
         ComPtr<IArtifact> artifact;
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        SLANG_RETURN_ON_FAIL(_compileWithDownstreamCache(downstreamCache, compiler, options, artifact));
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         getSession()->addDownstreamCompileTime(downstreamElapsedTime);
@@ -1871,7 +2331,8 @@ namespace Slang
     IArtifact* TargetProgram::_createEntryPointResult(
         Int                     entryPointIndex,
         DiagnosticSink*         sink,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        SPIRVOptimizationBatch* spirvOptimizationBatch)
     {
         // It is possible that entry points got added to the `Program`
         // *after* we created this `TargetProgram`, so there might be
@@ -1889,6 +2350,7 @@ namespace Slang
         entryPointIndices.add(entryPointIndex);
 
         CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        sharedCodeGenContext.spirvOptimizationBatch = spirvOptimizationBatch;
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
         codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
@@ -1952,13 +2414,28 @@ namespace Slang
         }
         else
         {
+            // spirv-opt can be run for each entry point independently of the others, so
+            // if requested it is deferred until code has been generated for all of them,
+            // and then run concurrently.
+            //
+            SPIRVOptimizationBatch spirvOptimizationBatch;
+            const bool shouldBatchSPIRVOptimization =
+                entryPointCount > 1 &&
+                targetProgram->getTargetReq()->getTarget() == CodeGenTarget::SPIRV &&
+                targetProgram->shouldEmitSPIRVDirectly() &&
+                targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ParallelSPIRVOptimization);
+
             for (Index ii = 0; ii < entryPointCount; ++ii)
             {
                 targetProgram->_createEntryPointResult(
                     ii,
                     getSink(),
-                    this);
+                    this,
+                    shouldBatchSPIRVOptimization ? &spirvOptimizationBatch : nullptr);
             }
+
+            // Any failure is reported to the sink, which is checked once all output has been generated
+            spirvOptimizationBatch.run(getSession(), getSink());
         }
     }
 
@@ -20,6 +20,7 @@
 #include "../core/slang-command-options.h"
 
 #include "../core/slang-file-system.h"
+#include "../core/slang-persistent-cache.h"
 
 #include "slang-com-ptr.h"
 
@@ -32,11 +33,14 @@
 #include "slang-hlsl-to-vulkan-layout-options.h"
 #include "slang-compiler-options.h"
 #include "slang-serialize-ir-types.h"
+#include "slang-ir-specialization-cache.h"
 
 #include "../compiler-core/slang-artifact-representation-impl.h"
 
 #include "slang.h"
 
+#include <mutex>
+
 namespace Slang
 {
     struct PathInfo;
@@ -168,6 +172,7 @@ namespace Slang
     class FrontEndCompileRequest;
     class Linkage;
     class Module;
+    class SPIRVOptimizationBatch;
     class TranslationUnitRequest;
 
         /// Information collected about global or entry-point shader parameters
@@ -1500,7 +1505,16 @@ namespace Slang
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
             /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            ///
+            /// If the module was loaded with deferred IR, the IR module is constructed
+            /// by the first call. The builtin module is shared by every session created
+            /// from a global session, so construction is guarded to happen exactly once.
+        IRModule* getIRModule()
+        {
+            if (m_hasDeferredIRModule)
+                std::call_once(m_deferredIRModuleOnceFlag, [this]() { _materializeDeferredIRModule(); });
+            return m_irModule;
+        }
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1531,6 +1545,13 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set serialized IR for this module, which is turned into an IR module
+            /// the first time `getIRModule` is called.
+            ///
+            /// This should only be called once, during creation of the module, instead of `setIRModule`.
+            ///
+        void setDeferredIRModule(SerialDeferredIRModule* deferredIRModule);
+
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
         String getEntryPointMangledName(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return String(); }
@@ -1587,6 +1608,7 @@ namespace Slang
         List<RefPtr<EntryPoint>>& getEntryPoints() { return m_entryPoints; }
         void _addEntryPoint(EntryPoint* entryPoint);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
+        void _materializeDeferredIRModule();
 
         // Gets the files that has been included into the module.
         Dictionary<SourceFile*, FileDecl*>& getIncludedSourceFileMap() { return m_mapSourceFileToFileDecl; }
@@ -1609,6 +1631,12 @@ namespace Slang
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // Serialized IR that hasn't been turned into `m_irModule` yet
+        RefPtr<SerialDeferredIRModule> m_deferredIRModule;
+        // Set once by `setDeferredIRModule` (before the module is shared), never cleared
+        bool m_hasDeferredIRModule = false;
+        std::once_flag m_deferredIRModuleOnceFlag;
+
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
 
@@ -2495,7 +2523,8 @@ namespace Slang
         IArtifact* _createEntryPointResult(
             Int                     entryPointIndex,
             DiagnosticSink*         sink,
-            EndToEndCompileRequest* endToEndReq = nullptr);
+            EndToEndCompileRequest* endToEndReq = nullptr,
+            SPIRVOptimizationBatch* spirvOptimizationBatch = nullptr);
 
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
@@ -2504,6 +2533,14 @@ namespace Slang
             return m_irModuleForLayout;
         }
 
+            /// Get the cache of generic functions specialized by links of this program.
+            ///
+            /// The cache is shared by the links for every entry point, so that a generic
+            /// used by many of them is only specialized once per target. Returns nullptr
+            /// unless enabled with `CompilerOptionName::SpecializationCache`.
+            ///
+        IRSpecializationCache* getSpecializationCache() { return m_specializationCache; }
+
         CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
         HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions() { return m_targetReq->getHLSLToVulkanLayoutOptions(); }
@@ -2534,6 +2571,8 @@ namespace Slang
         List<ComPtr<IArtifact>> m_entryPointResults;
 
         RefPtr<IRModule> m_irModuleForLayout;
+
+        RefPtr<IRSpecializationCache> m_specializationCache;
     };
 
         /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2566,6 +2605,34 @@ namespace Slang
     public:
     };
 
+        /// SPIR-V optimizations deferred while generating code for several entry points, so that
+        /// they can be run concurrently once code has been generated for all of them.
+    class SPIRVOptimizationBatch
+    {
+    public:
+            /// Add an optimization of the SPIR-V in `artifact` with `compiler`.
+            /// The `sourceArtifacts` of `options` are ignored.
+        void add(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, IArtifact* artifact);
+
+            /// Run all of the added optimizations, and replace the SPIR-V in each artifact with the
+            /// optimized result. Diagnostics are reported in the order the optimizations were added.
+            /// Optimizations using the same compiler only run concurrently if that compiler is known
+            /// to allow it, otherwise they are run one at a time.
+        SlangResult run(Session* session, DiagnosticSink* sink);
+
+    protected:
+        struct Job
+        {
+            ComPtr<IDownstreamCompiler> compiler;
+            DownstreamCompileOptions options;
+            ComPtr<IArtifact> artifact;
+            ComPtr<IArtifact> optimizedArtifact;
+            SlangResult result = SLANG_OK;
+        };
+
+        List<Job> m_jobs;
+    };
+
         /// A context for code generation in the compiler back-end
     struct CodeGenContext
     {
@@ -2594,6 +2661,8 @@ namespace Slang
             EntryPointIndices       entryPointIndices;
             DiagnosticSink*         sink = nullptr;
             EndToEndCompileRequest* endToEndReq = nullptr;
+                /// If set, SPIR-V optimization is added to this batch rather than being run immediately
+            SPIRVOptimizationBatch* spirvOptimizationBatch = nullptr;
         };
 
         CodeGenContext(
@@ -2627,6 +2696,11 @@ namespace Slang
             return m_shared->entryPointIndices;
         }
 
+        SPIRVOptimizationBatch* getSPIRVOptimizationBatch()
+        {
+            return m_shared->spirvOptimizationBatch;
+        }
+
         CodeGenTarget getTargetFormat()
         {
             return m_targetFormat;
@@ -3262,6 +3336,10 @@ namespace Slang
         void addDownstreamCompileTime(double time) { m_downstreamCompileTime += time; }
         void addTotalCompileTime(double time) { m_totalCompileTime += time; }
 
+            /// Get the cache of downstream compiler output stored in `directory`. The cache is created on
+            /// first use, and shared by all compilations in the session that use the same directory.
+        PersistentCache* getDownstreamArtifactCache(const String& directory);
+
         ComPtr<ISlangSharedLibraryLoader> m_sharedLibraryLoader;                    ///< The shared library loader (never null)
 
         int m_downstreamCompilerInitialized = 0;                                        
@@ -3275,12 +3353,20 @@ namespace Slang
         CommandOptions m_commandOptions;
 
         int m_typeDictionarySize = 0;
+
+            /// Guards the type checking cache of the builtin linkage. Other linkages start from a
+            /// copy of it, and add the conversion costs they compute back to it.
+        std::mutex m_typeCheckingCacheMutex;
     private:
 
         void _initCodeGenTransitionMap();
 
         SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
 
+            /// Write/read the conversion costs cached by the builtin linkage to/from a stdlib archive
+        SlangResult _writeConversionCostCache(ISlangMutableFileSystem* fileSystem);
+        void _readConversionCostCache(ISlangFileSystem* fileSystem);
+
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
             /// Linkage used for all built-in (stdlib) code.
@@ -3295,6 +3381,9 @@ namespace Slang
 
         double m_downstreamCompileTime = 0.0;
         double m_totalCompileTime = 0.0;
+
+        std::mutex m_downstreamArtifactCacheMutex;
+        Dictionary<String, RefPtr<PersistentCache>> m_downstreamArtifactCaches;      ///< Caches of downstream compiler output, keyed by directory
     };
 
     void checkTranslationUnit(
@@ -147,6 +147,7 @@ DIAGNOSTIC(  100, Error, failedToLoadDownstreamCompiler, "failed to load downstr
 DIAGNOSTIC(  101, Error, downstreamCompilerDoesntSupportWholeProgramCompilation, "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(  102, Note,  downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(  103, Note,  performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(  104, Note,  downstreamCacheStats, "downstream cache: $0 hits, $1 misses")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -370,6 +370,30 @@ void calcRequiredLoweringPassSet(RequiredLoweringPassSet& result, CodeGenContext
     }
 }
 
+// Passes that only act on a few kinds of instruction don't need the scan above: the
+// module counts the instructions it has with each opcode, so such a pass declares the
+// opcodes it acts on, and is skipped if the module has none of them.
+//
+static bool hasAnyInstWithOp(IRModule* module, std::initializer_list<IROp> ops)
+{
+    for (auto op : ops)
+    {
+        if (module->getInstCountForOp(op) != 0)
+            return true;
+    }
+    return false;
+}
+
+// Returns `shouldRun`. If `isRecording`, also records if the pass was run or skipped, for
+// the statistics output by `-report-perf-benchmark`.
+//
+static bool shouldRunPass(bool isRecording, const char* passName, bool shouldRun)
+{
+    if (isRecording)
+        PerformanceProfiler::getProfiler()->recordPass(passName, shouldRun);
+    return shouldRun;
+}
+
 bool checkStaticAssert(IRInst* inst, DiagnosticSink* sink)
 {
     switch (inst->getOp())
@@ -457,15 +481,20 @@ Result linkAndOptimizeIR(
     RequiredLoweringPassSet requiredLoweringPassSet = {};
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
 
-    if(!isKhronosTarget(targetRequest) && requiredLoweringPassSet.glslSSBO)
+    // Which passes are run or skipped is only recorded if it will be reported
+    const bool isRecordingPasses = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmark);
+
+    if (shouldRunPass(isRecordingPasses, "lowerGLSLShaderStorageBufferObjectsToStructuredBuffers",
+        !isKhronosTarget(targetRequest) && requiredLoweringPassSet.glslSSBO))
         lowerGLSLShaderStorageBufferObjectsToStructuredBuffers(irModule, sink);
 
-    if (requiredLoweringPassSet.glslGlobalVar)
+    if (shouldRunPass(isRecordingPasses, "translateGLSLGlobalVar", requiredLoweringPassSet.glslGlobalVar))
         translateGLSLGlobalVar(codeGenContext, irModule);
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    if (shouldRunPass(isRecordingPasses, "replaceGlobalConstants", hasAnyInstWithOp(irModule, { kIROp_GlobalConstant })))
+        replaceGlobalConstants(irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -479,7 +508,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    if (requiredLoweringPassSet.bindExistential)
+    if (shouldRunPass(isRecordingPasses, "bindExistentialSlots", requiredLoweringPassSet.bindExistential))
         bindExistentialSlots(irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
@@ -560,7 +589,7 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    if (requiredLoweringPassSet.optionalType)
+    if (shouldRunPass(isRecordingPasses, "lowerOptionalType", requiredLoweringPassSet.optionalType))
         lowerOptionalType(irModule, sink);
 
     switch (target)
@@ -588,7 +617,7 @@ Result linkAndOptimizeIR(
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
-    if (requiredLoweringPassSet.resultType)
+    if (shouldRunPass(isRecordingPasses, "lowerResultType", requiredLoweringPassSet.resultType))
         lowerResultType(irModule, sink);
 
 #if 0
@@ -597,7 +626,9 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
-    lowerLValueCast(targetProgram, irModule);
+    if (shouldRunPass(isRecordingPasses, "lowerLValueCast",
+        hasAnyInstWithOp(irModule, { kIROp_InOutImplicitCast, kIROp_OutImplicitCast })))
+        lowerLValueCast(targetProgram, irModule);
 
     IRSimplificationOptions defaultIRSimplificationOptions = IRSimplificationOptions::getDefault(targetProgram);
     IRSimplificationOptions fastIRSimplificationOptions = IRSimplificationOptions::getFast(targetProgram);
@@ -621,7 +652,8 @@ Result linkAndOptimizeIR(
     // It's important that this takes place before defunctionalization as we
     // want to be able to easily discover the cooperate and fallback funcitons
     // being passed to saturated_cooperation
-    if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
+    if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations() &&
+        shouldRunPass(isRecordingPasses, "fuseCallsToSaturatedCooperation", hasAnyInstWithOp(irModule, { kIROp_KnownBuiltinDecoration })))
         fuseCallsToSaturatedCooperation(irModule);
 
     switch (target)
@@ -630,7 +662,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::PyTorchCppBinding:
     {
         // Generate any requested derivative wrappers
-        if (requiredLoweringPassSet.derivativePyBindWrapper)
+        if (shouldRunPass(isRecordingPasses, "generateDerivativeWrappers", requiredLoweringPassSet.derivativePyBindWrapper))
             generateDerivativeWrappers(irModule, sink);
         break;
     }
@@ -694,10 +726,10 @@ Result linkAndOptimizeIR(
         // which do.
         // Specialize away these parameters
         // TODO: We should implement a proper defunctionalization pass
-        if (requiredLoweringPassSet.higherOrderFunc)
+        if (shouldRunPass(isRecordingPasses, "specializeHigherOrderParameters", requiredLoweringPassSet.higherOrderFunc))
             changed |= specializeHigherOrderParameters(codeGenContext, irModule);
 
-        if (requiredLoweringPassSet.autodiff)
+        if (shouldRunPass(isRecordingPasses, "processAutodiffCalls", requiredLoweringPassSet.autodiff))
         {
             dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
             enableIRValidationAtInsert();
@@ -710,7 +742,7 @@ Result linkAndOptimizeIR(
             break;
     }
 
-    if (requiredLoweringPassSet.autodiff)
+    if (shouldRunPass(isRecordingPasses, "finalizeAutoDiffPass", requiredLoweringPassSet.autodiff))
         finalizeAutoDiffPass(targetProgram, irModule);
 
     // Remove auto-diff related decorations.
@@ -762,7 +794,7 @@ Result linkAndOptimizeIR(
         SLANG_RETURN_ON_FAIL(performTypeInlining(irModule, sink));
     }
 
-    if (requiredLoweringPassSet.reinterpret)
+    if (shouldRunPass(isRecordingPasses, "lowerReinterpret", requiredLoweringPassSet.reinterpret))
         lowerReinterpret(targetProgram, irModule, sink);
 
     if (sink->getErrorCount() != 0)
@@ -784,14 +816,15 @@ Result linkAndOptimizeIR(
         targetProgram->getOptionSet().shouldRunNonEssentialValidation())
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is not a string literal
-        SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
+        if (shouldRunPass(isRecordingPasses, "checkGetStringHashInsts", hasAnyInstWithOp(irModule, { kIROp_GetStringHash })))
+            SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
     }
 
     // For targets that supports dynamic dispatch, we need to lower the
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
-    if (requiredLoweringPassSet.generics)
+    if (shouldRunPass(isRecordingPasses, "lowerGenerics", requiredLoweringPassSet.generics))
         lowerGenerics(targetProgram, irModule, sink);
     else
         cleanupGenerics(targetProgram, irModule, sink);
@@ -825,7 +858,9 @@ Result linkAndOptimizeIR(
     // On non-HLSL targets, there isn't an implementation of `AppendStructuredBuffer`
     // and `ConsumeStructuredBuffer` types, so we lower them into normal struct types
     // of `RWStructuredBuffer` typed fields now.
-    if (target != CodeGenTarget::HLSL)
+    if (target != CodeGenTarget::HLSL &&
+        shouldRunPass(isRecordingPasses, "lowerAppendConsumeStructuredBuffers",
+            hasAnyInstWithOp(irModule, { kIROp_HLSLAppendStructuredBufferType, kIROp_HLSLConsumeStructuredBufferType })))
     {
         lowerAppendConsumeStructuredBuffers(targetProgram, irModule, sink);
     }
@@ -840,7 +875,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::Metal:
     case CodeGenTarget::MetalLib:
     case CodeGenTarget::MetalLibAssembly:
-        if (requiredLoweringPassSet.combinedTextureSamplers)
+        if (shouldRunPass(isRecordingPasses, "lowerCombinedTextureSamplers", requiredLoweringPassSet.combinedTextureSamplers))
             lowerCombinedTextureSamplers(irModule, sink);
         break;
     }
@@ -878,7 +913,7 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        if (requiredLoweringPassSet.existentialTypeLayout)
+        if (shouldRunPass(isRecordingPasses, "legalizeExistentialTypeLayout", requiredLoweringPassSet.existentialTypeLayout))
         {
             legalizeExistentialTypeLayout(
                 targetProgram,
@@ -926,7 +961,9 @@ Result linkAndOptimizeIR(
     legalizeVectorTypes(irModule, sink);
 
     // Legalize `__isTextureAccess` and related.
-    legalizeIsTextureAccess(irModule, sink);
+    if (shouldRunPass(isRecordingPasses, "legalizeIsTextureAccess",
+        hasAnyInstWithOp(irModule, { kIROp_IsTextureAccess, kIROp_IsTextureArrayAccess, kIROp_IsTextureScalarAccess })))
+        legalizeIsTextureAccess(irModule, sink);
 
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
@@ -971,7 +1008,8 @@ Result linkAndOptimizeIR(
 
     // Process `static_assert` after the specialization is done.
     // Some information for `static_assert` is available only after the specialization.
-    checkStaticAssert(irModule->getModuleInst(), sink);
+    if (shouldRunPass(isRecordingPasses, "checkStaticAssert", hasAnyInstWithOp(irModule, { kIROp_StaticAssert })))
+        checkStaticAssert(irModule->getModuleInst(), sink);
 
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
@@ -983,6 +1021,7 @@ Result linkAndOptimizeIR(
     switch(target)
     {
     case CodeGenTarget::HLSL:
+        if (shouldRunPass(isRecordingPasses, "wrapStructuredBuffersOfMatrices", hasAnyInstWithOp(irModule, { kIROp_MatrixType })))
         {
             wrapStructuredBuffersOfMatrices(irModule);
 #if 0
@@ -1000,7 +1039,7 @@ Result linkAndOptimizeIR(
     // of aggregate types from/to byte-address buffers into
     // stores of individual scalar or vector values.
     //
-    if (requiredLoweringPassSet.byteAddressBuffer)
+    if (shouldRunPass(isRecordingPasses, "legalizeByteAddressBufferOps", requiredLoweringPassSet.byteAddressBuffer))
     {
         ByteAddressBufferLegalizationOptions byteAddressBufferOptions;
 
@@ -1179,10 +1218,16 @@ Result linkAndOptimizeIR(
         legalizeNonStructParameterToStructForHLSL(irModule);
 
     // Create aliases for all dynamic resource parameters.
-    if(requiredLoweringPassSet.dynamicResource && isKhronosTarget(targetRequest))
+    if (shouldRunPass(isRecordingPasses, "legalizeDynamicResourcesForGLSL",
+        requiredLoweringPassSet.dynamicResource && isKhronosTarget(targetRequest)))
         legalizeDynamicResourcesForGLSL(codeGenContext, irModule);
-    
-    legalizeExtractFromTextureAccess(irModule);
+
+    if (shouldRunPass(isRecordingPasses, "legalizeExtractFromTextureAccess",
+        hasAnyInstWithOp(irModule, {
+            kIROp_ExtractArrayCoordFromTextureAccess,
+            kIROp_ExtractCoordFromTextureAccess,
+            kIROp_ExtractTextureFromTextureAccess })))
+        legalizeExtractFromTextureAccess(irModule);
 
     // Legalize `ImageSubscript` loads.
     switch (target)
@@ -1193,6 +1238,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::GLSL:
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
+        if (shouldRunPass(isRecordingPasses, "legalizeImageSubscript", hasAnyInstWithOp(irModule, { kIROp_ImageSubscript })))
         {
             legalizeImageSubscript(targetRequest, irModule, sink);
         } 
@@ -1286,7 +1332,7 @@ Result linkAndOptimizeIR(
 
     // Lower the `getRegisterIndex` and `getRegisterSpace` intrinsics.
     //
-    if (requiredLoweringPassSet.bindingQuery)
+    if (shouldRunPass(isRecordingPasses, "lowerBindingQueries", requiredLoweringPassSet.bindingQuery))
         lowerBindingQueries(irModule, sink);
 
     // For some small improvement in type safety we represent these as opaque
@@ -1294,7 +1340,7 @@ Result linkAndOptimizeIR(
     //
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
-    if (requiredLoweringPassSet.meshOutput)
+    if (shouldRunPass(isRecordingPasses, "legalizeMeshOutputTypes", requiredLoweringPassSet.meshOutput))
         legalizeMeshOutputTypes(irModule);
 
     lowerBufferElementTypeToStorageType(targetProgram, irModule);
@@ -1315,7 +1361,7 @@ Result linkAndOptimizeIR(
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    if (requiredLoweringPassSet.bitcast)
+    if (shouldRunPass(isRecordingPasses, "lowerBitCast", requiredLoweringPassSet.bitcast))
         lowerBitCast(targetProgram, irModule, sink);
 
     bool emitSpirvDirectly = targetProgram->shouldEmitSPIRVDirectly();
@@ -1408,7 +1454,12 @@ Result linkAndOptimizeIR(
         }
     }
 
-    if (isKhronosTarget(targetRequest) && emitSpirvDirectly)
+    if (isKhronosTarget(targetRequest) && emitSpirvDirectly &&
+        shouldRunPass(isRecordingPasses, "replaceLocationIntrinsicsWithRaytracingObject",
+            hasAnyInstWithOp(irModule, {
+                kIROp_SPIRVAsmOperandRayPayloadFromLocation,
+                kIROp_SPIRVAsmOperandRayAttributeFromLocation,
+                kIROp_SPIRVAsmOperandRayCallableFromLocation })))
     {
         replaceLocationIntrinsicsWithRaytracingObject(targetProgram, irModule, sink);
     }
@@ -1759,16 +1810,26 @@ SlangResult emitSPIRVForEntryPointsDirectly(
         case OptimizationLevel::Maximal:    downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;  break;
         default: SLANG_ASSERT(!"Unhandled optimization level"); break;
         }
-        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+        downstreamOptions.reportPassTimes = codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamPassTime);
+
+        if (auto spirvOptimizationBatch = codeGenContext->getSPIRVOptimizationBatch())
         {
-            artifact = _Move(optimizedArtifact);
+            // The SPIR-V in the artifact is replaced when the batch is run
+            spirvOptimizationBatch->add(compiler, downstreamOptions, artifact);
         }
-        auto downstreamElapsedTime =
-            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-        codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+        else
+        {
+            auto downstreamStartTime = std::chrono::high_resolution_clock::now();
+            if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+            {
+                artifact = _Move(optimizedArtifact);
+            }
+            auto downstreamElapsedTime =
+                (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
+            codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
-        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+            SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+        }
     }
 
     ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
@@ -1061,6 +1061,7 @@ void stripAutoDiffDecorationsFromChildren(IRInst* parent)
 
 void stripAutoDiffDecorations(IRModule* module)
 {
+    SLANG_PROFILE;
     stripAutoDiffDecorationsFromChildren(module->getModuleInst());
 }
 
@@ -2054,6 +2055,7 @@ void releaseNullDifferentialType(AutoDiffSharedContext* context)
 
 bool finalizeAutoDiffPass(TargetProgram* target, IRModule* module)
 {
+    SLANG_PROFILE;
     bool modified = false;
 
     // Create shared context for all auto-diff related passes
@@ -1,5 +1,6 @@
 // slang-ir-bind-existentials.cpp
 #include "slang-ir-bind-existentials.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -360,6 +361,7 @@ void bindExistentialSlots(
     IRModule*       module,
     DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     BindExistentialSlots context;
     context.module = module;
     context.sink = sink;
@@ -1,5 +1,6 @@
 // slang-ir-byte-address-legalize.cpp
 #include "slang-ir-byte-address-legalize.h"
+#include "../core/slang-performance-profiler.h"
 
 // This file implements an IR pass that translates load/store operations
 // on byte-address buffers to be legal for a chosen target.
@@ -1248,6 +1249,7 @@ void legalizeByteAddressBufferOps(
     DiagnosticSink*                             sink,
     ByteAddressBufferLegalizationOptions const& options)
 {
+    SLANG_PROFILE;
     ByteAddressBufferLegalizationContext context;
     context.m_session = session;
     context.m_target = program->getTargetReq();
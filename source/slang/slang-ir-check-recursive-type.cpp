@@ -1,5 +1,6 @@
 #include "slang-ir-check-recursive-type.h"
 #include "slang-ir-util.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -42,6 +43,7 @@ namespace Slang
 
     void checkForRecursiveTypes(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         HashSet<IRInst*> checkedTypes;
         for (auto globalInst : module->getGlobalInsts())
         {
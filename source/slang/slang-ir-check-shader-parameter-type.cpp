@@ -1,5 +1,6 @@
 #include "slang-ir-check-shader-parameter-type.h"
 #include "slang-ir-util.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -59,6 +60,7 @@ namespace Slang
         IRModule* module,
         DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         if (isMetalTarget(target))
             checkForInvalidShaderParameterTypeForMetal(module, sink);
     }
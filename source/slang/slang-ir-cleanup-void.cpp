@@ -3,6 +3,7 @@
 #include "slang-ir-cleanup-void.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -180,6 +181,7 @@ namespace Slang
     
     void cleanUpVoidType(IRModule* module)
     {
+        SLANG_PROFILE;
         CleanUpVoidContext context(module);
         context.processModule();
     }
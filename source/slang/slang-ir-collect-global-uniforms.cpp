@@ -1,5 +1,6 @@
 // slang-ir-collect-global-uniforms.cpp
 #include "slang-ir-collect-global-uniforms.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 
@@ -325,6 +326,7 @@ void collectGlobalUniformParameters(
     IRModule*       module,
     IRVarLayout*    globalScopeVarLayout)
 {
+    SLANG_PROFILE;
     CollectGlobalUniformParametersContext context;
     context.module = module;
     context.globalScopeVarLayout = globalScopeVarLayout;
@@ -1,5 +1,6 @@
 // slang-ir-com-interface.cpp
 #include "slang-ir-com-interface.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -40,6 +41,7 @@ static bool _canReplace(IRUse* use)
 
 void lowerComInterfaces(IRModule* module, ArtifactStyle artifactStyle, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     // First, lower all COM methods and their call sites out of `Result` and other managed types.
     lowerComMethods(module, sink);
 
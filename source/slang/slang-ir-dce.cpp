@@ -1,5 +1,6 @@
 // slang-ir-dce.cpp
 #include "slang-ir-dce.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -467,6 +468,7 @@ bool eliminateDeadCode(
     IRModule*                           module,
     IRDeadCodeEliminationOptions const& options)
 {
+    SLANG_PROFILE;
     DeadCodeEliminationContext context;
     context.module = module;
     context.options = options;
@@ -1,4 +1,5 @@
 #include "slang-ir-defunctionalization.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 #include "slang-ir-specialize-function-call.h"
@@ -23,6 +24,7 @@ bool specializeHigherOrderParameters(
     CodeGenContext* codeGenContext,
     IRModule*       module)
 {
+    SLANG_PROFILE;
     bool result = false;
     FunctionParameterSpecializationCondition condition;
     condition.targetRequest = codeGenContext->getTargetReq();
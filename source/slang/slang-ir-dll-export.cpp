@@ -1,5 +1,6 @@
 // slang-ir-dll-export.cpp
 #include "slang-ir-dll-export.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -58,6 +59,7 @@ struct DllExportContext
 
 void generateDllExportFuncs(IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     DllExportContext context;
     context.module = module;
     context.diagnosticSink = sink;
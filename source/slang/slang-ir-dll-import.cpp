@@ -1,5 +1,6 @@
 // slang-ir-dll-import.cpp
 #include "slang-ir-dll-import.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -190,6 +191,7 @@ struct DllImportContext
 
 void generateDllImportFuncs(TargetProgram* targetProgram, IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     DllImportContext context;
     context.module = module;
     context.targetProgram = targetProgram;
@@ -16,6 +16,7 @@
 //
 
 #include "slang-ir.h"
+#include "slang-ir-util.h"
 
 namespace Slang {
 
@@ -857,4 +858,52 @@ RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code)
     return context.createDominatorTree(code);
 }
 
+RefPtr<IRDominatorTree> IRDominatorTree::compute(IRGlobalValueWithCode* code)
+{
+    return computeDominatorTree(code);
+}
+
+// IRPostorder
+
+RefPtr<IRPostorder> IRPostorder::compute(IRGlobalValueWithCode* code)
+{
+    RefPtr<IRPostorder> postorder = new IRPostorder();
+    computePostorder(code, postorder->blocks, postorder->reachableSet);
+    return postorder;
+}
+
+// IRLoopInfo
+
+RefPtr<IRLoopInfo> IRLoopInfo::compute(IRGlobalValueWithCode* code)
+{
+    auto module = code->getModule();
+    SLANG_ASSERT(module);
+
+    RefPtr<IRLoopInfo> loopInfo = new IRLoopInfo();
+    loopInfo->m_code = code;
+
+    // The header of a loop dominates the headers of any loops nested in it, and so
+    // comes after them in postorder.
+    auto postorder = module->findOrCreateAnalysis<IRPostorder>(code);
+    for (auto block : postorder->blocks)
+    {
+        if (auto loop = as<IRLoop>(block->getTerminator()))
+            loopInfo->m_loops.add(loop);
+    }
+    return loopInfo;
+}
+
+const List<IRBlock*>& IRLoopInfo::getLoopBlocks(IRLoop* loop)
+{
+    if (auto blocks = m_loopBlocks.tryGetValue(loop))
+        return *blocks;
+
+    if (!m_domTree)
+        m_domTree = m_code->getModule()->findOrCreateDominatorTree(m_code);
+
+    auto& blocks = m_loopBlocks[loop];
+    blocks = collectBlocksInRegion(m_domTree, loop);
+    return blocks;
+}
+
 }
@@ -8,10 +8,27 @@ namespace Slang
     struct IRBlock;
     struct IRGlobalValueWithCode;
     struct IRInst;
+    struct IRLoop;
+
+    /// The analyses of a control flow graph that `IRModule` can cache for a function.
+    ///
+    /// An analysis type `T` identifies its kind with `T::kAnalysisKind`, and is computed
+    /// with `T::compute`. See `IRModule::findOrCreateAnalysis`.
+    enum class IRAnalysisKind
+    {
+        DominatorTree,
+        Postorder,
+        LoopInfo,
+    };
 
     /// The computed dominator tree for an IR control flow graph.
     struct IRDominatorTree : public RefObject
     {
+        static const IRAnalysisKind kAnalysisKind = IRAnalysisKind::DominatorTree;
+
+        /// Compute the dominator tree of `code`. Same as `computeDominatorTree`.
+        static RefPtr<IRDominatorTree> compute(IRGlobalValueWithCode* code);
+
         /// The function or other code-bearing value for which the dominator tree was computed.
         IRGlobalValueWithCode*  code;
 
@@ -170,6 +187,44 @@ namespace Slang
         // tree in the same structure, just to make life simpler.
     };
 
+    /// The blocks of an IR control flow graph in postorder.
+    struct IRPostorder : public RefObject
+    {
+        static const IRAnalysisKind kAnalysisKind = IRAnalysisKind::Postorder;
+
+        /// Compute the postorder of `code`, as `computePostorder` does.
+        static RefPtr<IRPostorder> compute(IRGlobalValueWithCode* code);
+
+        /// The blocks in postorder, preceded by any unreachable blocks
+        List<IRBlock*> blocks;
+
+        /// The blocks that are reachable from the entry block
+        HashSet<IRBlock*> reachableSet;
+    };
+
+    /// The loops of an IR control flow graph.
+    struct IRLoopInfo : public RefObject
+    {
+        static const IRAnalysisKind kAnalysisKind = IRAnalysisKind::LoopInfo;
+
+        /// Find the loops of `code`, which must be in a module.
+        static RefPtr<IRLoopInfo> compute(IRGlobalValueWithCode* code);
+
+        /// The loops, where inner loops come before the loops that contain them.
+        const List<IRLoop*>& getLoops() const { return m_loops; }
+
+        /// Get the blocks in the region of `loop`, as `collectBlocksInRegion` does.
+        ///
+        /// The region is found on first use, with the dominator tree cached by the module.
+        const List<IRBlock*>& getLoopBlocks(IRLoop* loop);
+
+    private:
+        IRGlobalValueWithCode* m_code = nullptr;
+        List<IRLoop*> m_loops;
+        RefPtr<IRDominatorTree> m_domTree;
+        Dictionary<IRLoop*, List<IRBlock*>> m_loopBlocks;
+    };
+
     RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code);
 
     void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
@@ -157,6 +157,7 @@ namespace Slang
 
     void replaceLocationIntrinsicsWithRaytracingObject(TargetProgram* target, IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         //currently only applies to GLSL syntax
         CacheOfDataToReplaceOps cache = CacheOfDataToReplaceOps(target, module, sink);
         cache.searchForGlobalsDataNeededInPass();
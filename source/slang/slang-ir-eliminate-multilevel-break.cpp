@@ -5,6 +5,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir-eliminate-phis.h"
 #include "slang-ir-dominators.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -469,6 +470,7 @@ struct EliminateMultiLevelBreakContext
 
 void eliminateMultiLevelBreak(IRModule* irModule)
 {
+    SLANG_PROFILE;
     EliminateMultiLevelBreakContext context;
     context.irModule = irModule;
     for (auto globalInst : irModule->getGlobalInsts())
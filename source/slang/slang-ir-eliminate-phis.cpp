@@ -2,6 +2,7 @@
 #include "slang-ir-eliminate-phis.h"
 #include "slang-ir-ssa-register-allocate.h"
 #include "slang-ir-util.h"
+#include "../core/slang-performance-profiler.h"
 
 // This file implements a pass to take code in the Slang IR out out SSA form
 // by eliminating all "phi nodes."
@@ -1141,6 +1142,7 @@ struct PhiEliminationContext
 
 void eliminatePhis(LivenessMode livenessMode, IRModule* module, PhiEliminationOptions options)
 {
+    SLANG_PROFILE;
     PhiEliminationContext context(livenessMode, module, options);
     context.eliminatePhisInModule();
 }
@@ -1,5 +1,6 @@
 // slang-ir-entry-point-raw-ptr-params.cpp
 #include "slang-ir-entry-point-raw-ptr-params.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 
@@ -112,6 +113,7 @@ struct ConvertEntryPointPtrParamsToRawPtrsPass
 void convertEntryPointPtrParamsToRawPtrs(
     IRModule*   module)
 {
+    SLANG_PROFILE;
     ConvertEntryPointPtrParamsToRawPtrsPass pass;
     pass.m_module = module;
     pass.processModule();
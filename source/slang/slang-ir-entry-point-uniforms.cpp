@@ -1,5 +1,6 @@
 // slang-ir-entry-point-uniforms.cpp
 #include "slang-ir-entry-point-uniforms.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -502,6 +503,7 @@ void collectEntryPointUniformParams(
     IRModule*                                       module,
     CollectEntryPointUniformParamsOptions const&    options)
 {
+    SLANG_PROFILE;
     CollectEntryPointUniformParams context;
     context.m_options = options;
     context.processModule(module);
@@ -510,6 +512,7 @@ void collectEntryPointUniformParams(
 void moveEntryPointUniformParamsToGlobalScope(
     IRModule*   module)
 {
+    SLANG_PROFILE;
     MoveEntryPointUniformParametersToGlobalScope context;
     context.processModule(module);
 }
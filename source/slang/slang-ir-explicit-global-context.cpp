@@ -1,5 +1,6 @@
 // slang-ir-explicit-global-context.cpp
 #include "slang-ir-explicit-global-context.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 #include "slang-ir-clone.h"
@@ -753,6 +754,7 @@ void introduceExplicitGlobalContext(
     IRModule*       module,
     CodeGenTarget   target)
 {
+    SLANG_PROFILE;
     IntroduceExplicitGlobalContextPass pass(module, target);
     pass.processModule();
 }
@@ -1,5 +1,6 @@
 // slang-ir-explicit-global-init.cpp
 #include "slang-ir-explicit-global-init.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 
@@ -218,6 +219,7 @@ struct MoveGlobalVarInitializationToEntryPointsPass
 void moveGlobalVarInitializationToEntryPoints(
     IRModule* module)
 {
+    SLANG_PROFILE;
     MoveGlobalVarInitializationToEntryPointsPass pass;
     pass.processModule(module);
 }
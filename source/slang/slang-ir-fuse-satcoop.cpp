@@ -1,4 +1,5 @@
 #include "slang-ir-fuse-satcoop.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
@@ -526,6 +527,7 @@ static void fuseCallsInBlock(IRBuilder& builder, IRBlock* block)
 
 void fuseCallsToSaturatedCooperation(IRModule* module)
 {
+    SLANG_PROFILE;
     IRBuilder builder(module);
     overAllBlocks(module, [&](auto b){fuseCallsInBlock(builder, b);});
 }
@@ -1,5 +1,6 @@
 // slang-ir-glsl-legalize.cpp
 #include "slang-ir-glsl-legalize.h"
+#include "../core/slang-performance-profiler.h"
 
 #include <functional>
 
@@ -3477,6 +3478,7 @@ void legalizeEntryPointsForGLSL(
     CodeGenContext*         context,
     GLSLExtensionTracker*   glslExtensionTracker)
 {
+    SLANG_PROFILE;
     for (auto func : funcs)
     {
         legalizeEntryPointForGLSL(session, module, func, context, glslExtensionTracker);
@@ -3489,6 +3491,7 @@ void legalizeEntryPointsForGLSL(
 
 void legalizeConstantBufferLoadForGLSL(IRModule* module)
 {
+    SLANG_PROFILE;
     // Constant buffers and parameter blocks are represented as `uniform` blocks
     // in GLSL. These uniform blocks can't be used directly as a value of the underlying
     // struct type. If we see a direct load of the constant buffer pointer,
@@ -3533,6 +3536,7 @@ void legalizeConstantBufferLoadForGLSL(IRModule* module)
 
 void legalizeDispatchMeshPayloadForGLSL(IRModule* module)
 {
+    SLANG_PROFILE;
     // Find out DispatchMesh function
     IRGlobalValueWithCode* dispatchMeshFunc = nullptr;
     for(const auto globalInst : module->getGlobalInsts())
@@ -3618,6 +3622,7 @@ void legalizeDispatchMeshPayloadForGLSL(IRModule* module)
 
 void legalizeDynamicResourcesForGLSL(CodeGenContext* context, IRModule* module)
 {
+    SLANG_PROFILE;
     List<IRGlobalParam*> toRemove;
 
     for (auto inst : module->getGlobalInsts())
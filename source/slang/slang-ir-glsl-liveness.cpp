@@ -1,4 +1,5 @@
 #include "slang-ir-glsl-liveness.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
@@ -232,6 +233,7 @@ void GLSLLivenessContext::processModule()
 
 void applyGLSLLiveness(IRModule* module)
 {
+    SLANG_PROFILE;
     GLSLLivenessContext context(module);
 
     context.processModule();
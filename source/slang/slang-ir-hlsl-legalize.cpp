@@ -1,5 +1,6 @@
 // slang-ir-hlsl-legalize.cpp
 #include "slang-ir-hlsl-legalize.h"
+#include "../core/slang-performance-profiler.h"
 
 #include <functional>
 
@@ -82,6 +83,7 @@ void searchChildrenForForceVarIntoStructTemporarily(IRModule* module, IRInst* in
 
 void legalizeNonStructParameterToStructForHLSL(IRModule* module)
 {
+    SLANG_PROFILE;
     for(auto globalInst : module->getGlobalInsts())
     {
         if (globalInst->getOp() != kIROp_Func)
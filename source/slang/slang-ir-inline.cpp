@@ -963,6 +963,7 @@ struct GLSLResourceReturnFunctionInliningPass : InliningPassBase
 
 void performGLSLResourceReturnFunctionInlining(TargetProgram* targetProgram, IRModule* module)
 {
+    SLANG_PROFILE;
     GLSLResourceReturnFunctionInliningPass pass(module);
     bool changed = true;
 
@@ -1015,6 +1016,7 @@ struct IntrinsicFunctionInliningPass : InliningPassBase
 
 void performIntrinsicFunctionInlining(IRModule* module)
 {
+    SLANG_PROFILE;
     IntrinsicFunctionInliningPass pass(module);
     bool changed = true;
 
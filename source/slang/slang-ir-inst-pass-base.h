@@ -4,11 +4,55 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-dce.h"
+#include "slang-ir-util.h"
 
 namespace Slang
 {
     struct IRModule;
 
+        /// Instructions changed by the passes of a simplification loop, which may have become
+        /// simplifiable as a result.
+        ///
+        /// SCCP and redundancy removal add the instructions they change, and peephole optimization
+        /// starts from these and their users rather than visiting the whole function again. A pass that makes a
+        /// change it doesn't track (such as a change to the control flow graph) marks everything
+        /// as changed instead.
+    struct IRChangedInsts
+    {
+            /// Add the users of `inst`. Must be called before its uses are replaced.
+        void addUsersOf(IRInst* inst)
+        {
+            if (isEverythingChanged)
+                return;
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+                add(use->getUser());
+        }
+        void add(IRInst* inst)
+        {
+            if (!isEverythingChanged && instSet.add(inst))
+                insts.add(inst);
+        }
+        void markEverythingChanged()
+        {
+            isEverythingChanged = true;
+            insts.clear();
+            instSet.clear();
+        }
+            /// Start tracking again, with nothing changed
+        void reset()
+        {
+            isEverythingChanged = false;
+            insts.clear();
+            instSet.clear();
+        }
+
+            /// True if every instruction has to be considered changed. Nothing is known to be
+            /// unchanged to begin with.
+        bool isEverythingChanged = true;
+        List<IRInst*> insts;
+        HashSet<IRInst*> instSet;
+    };
+
     class InstPassBase
     {
     protected:
@@ -110,6 +154,149 @@ namespace Slang
             }
         }
 
+            /// Call `f` on `root` and each of its descendants, and then call it again on instructions
+            /// that may have become simplifiable because of a change it made, until there are none left.
+            /// `f` returns true if it changed the IR.
+            ///
+            /// When `f` changes an instruction, the users and operands that the instruction had are
+            /// visited again, along with the users of those users, any instructions created next to
+            /// it, and the instruction itself if it is still present. The parameters of a block depend on the branches to it,
+            /// so whenever a branch is visited again the parameters of the block it targets are too.
+            ///
+            /// If `changedInsts` is set and doesn't have everything marked as changed, only the
+            /// instructions in it and their users are visited to begin with, rather than all of
+            /// `root`. It is reset once done.
+            ///
+            /// Returns true if `f` changed anything.
+        template <typename Func>
+        bool processChildInstsUntilUnchanged(IRInst* root, const Func& f, IRChangedInsts* changedInsts = nullptr)
+        {
+            workList.clear();
+            workListSet.clear();
+
+            // Instructions to visit again because of a change. They are visited before the rest
+            // of the work list, and their children are not added to it again.
+            InstWorkList revisitList(module);
+            InstHashSet revisitSet(module);
+            auto addToRevisitList = [&](IRInst* inst)
+                {
+                    if (!revisitSet.add(inst))
+                        return;
+                    revisitList.add(inst);
+                    if (auto branch = as<IRUnconditionalBranch>(inst))
+                    {
+                        for (auto param : branch->getTargetBlock()->getParams())
+                        {
+                            if (revisitSet.add(param))
+                                revisitList.add(param);
+                        }
+                    }
+                };
+
+            // A change can be matched by the users of the users of a changed instruction too,
+            // since a simplification can look at the operands of its operands
+            auto addWithUsersToRevisitList = [&](IRInst* inst)
+                {
+                    addToRevisitList(inst);
+                    for (auto use = inst->firstUse; use; use = use->nextUse)
+                        addToRevisitList(use->getUser());
+                };
+
+            List<IRInst*> affectedUsers;
+            List<IRInst*> affectedOperands;
+
+            bool changed = false;
+
+            if (changedInsts && !changedInsts->isEverythingChanged)
+            {
+                for (auto inst : changedInsts->insts)
+                {
+                    // The instruction may have been removed since it was changed
+                    if (inst != root && inst->getParent() && isChildInstOf(inst, root))
+                        addWithUsersToRevisitList(inst);
+                }
+            }
+            else
+            {
+                addToWorkList(root);
+            }
+            for (;;)
+            {
+                IRInst* inst = nullptr;
+                const bool isRevisit = revisitList.getCount() != 0;
+                if (isRevisit)
+                {
+                    inst = revisitList.getLast();
+                    revisitList.removeLast();
+                    revisitSet.remove(inst);
+                }
+                else if (workList.getCount() != 0)
+                {
+                    inst = pop();
+                }
+                else
+                {
+                    break;
+                }
+
+                // The instruction may have been removed by a change made after it was added
+                if (inst != root && !inst->getParent())
+                    continue;
+
+                // The users and operands of the instruction can't be found after it has been replaced
+                affectedUsers.clear();
+                affectedOperands.clear();
+                for (auto use = inst->firstUse; use; use = use->nextUse)
+                    affectedUsers.add(use->getUser());
+                for (UInt i = 0; i < inst->getOperandCount(); ++i)
+                    affectedOperands.add(inst->getOperand(i));
+
+                IRInst* parent = inst->getParent();
+                IRInst* prev = inst->getPrevInst();
+                IRInst* next = inst->getNextInst();
+
+                if (f(inst))
+                {
+                    changed = true;
+
+                    auto isAffected = [&](IRInst* affectedInst)
+                        {
+                            return affectedInst && affectedInst != root && affectedInst->getParent() && isChildInstOf(affectedInst, root);
+                        };
+                    for (auto affectedInst : affectedUsers)
+                    {
+                        if (isAffected(affectedInst))
+                            addWithUsersToRevisitList(affectedInst);
+                    }
+                    for (auto affectedInst : affectedOperands)
+                    {
+                        if (isAffected(affectedInst))
+                            addToRevisitList(affectedInst);
+                    }
+
+                    if (inst != root)
+                    {
+                        auto first = (prev && prev->getParent() == parent) ? prev->getNextInst() : parent->getFirstChild();
+                        for (auto newInst = first; newInst && newInst != next; newInst = newInst->getNextInst())
+                            addToRevisitList(newInst);
+                    }
+                }
+
+                if (!isRevisit && (inst == root || inst->getParent()))
+                {
+                    for (auto child = inst->getLastChild(); child; child = child->getPrevInst())
+                    {
+                        addToWorkList(child);
+                    }
+                }
+            }
+
+            if (changedInsts)
+                changedInsts->reset();
+
+            return changed;
+        }
+
         template <typename Func>
         void processAllInsts(const Func& f)
         {
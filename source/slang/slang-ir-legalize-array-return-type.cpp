@@ -2,6 +2,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-clone.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -80,6 +81,7 @@ void makeFuncReturnViaOutParam(IRBuilder& builder, IRFunc* func)
 
 void legalizeArrayReturnType(IRModule* module)
 {
+    SLANG_PROFILE;
     IRBuilder builder(module);
 
     for (auto inst : module->getGlobalInsts())
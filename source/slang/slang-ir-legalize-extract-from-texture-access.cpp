@@ -1,4 +1,5 @@
 #include "slang-ir-legalize-extract-from-texture-access.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -100,6 +101,7 @@ namespace Slang
 
     void legalizeExtractFromTextureAccess(IRModule* module)
     {
+        SLANG_PROFILE;
         IRBuilder builder(module);
         for (auto globalInst : module->getModuleInst()->getChildren())
         {
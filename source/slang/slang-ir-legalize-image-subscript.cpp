@@ -1,4 +1,5 @@
 #include "slang-ir-legalize-image-subscript.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -165,6 +166,7 @@ namespace Slang
     }
     void legalizeImageSubscript(TargetRequest* target, IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         IRBuilder builder(module);
         for (auto globalInst : module->getModuleInst()->getChildren())
         {
@@ -1,4 +1,5 @@
 #include "slang-ir-legalize-is-texture-access.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -19,6 +20,7 @@ namespace Slang
 
     void legalizeIsTextureAccess(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         HashSet<IRFunc*> functionsToSCCP;
         IRBuilder builder(module);
         for (auto globalInst : module->getModuleInst()->getChildren())
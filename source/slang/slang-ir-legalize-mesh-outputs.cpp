@@ -2,12 +2,14 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-clone.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
 
 void legalizeMeshOutputTypes(IRModule* module)
 {
+    SLANG_PROFILE;
     IRBuilder builder(module);
 
     for (auto inst : module->getGlobalInsts())
@@ -4155,6 +4155,7 @@ void legalizeExistentialTypeLayout(
 
 void legalizeEmptyTypes(TargetProgram* target, IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     SLANG_UNUSED(sink);
 
     IREmptyTypeLegalizationContext context(target, module);
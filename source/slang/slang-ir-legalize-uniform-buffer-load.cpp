@@ -1,9 +1,11 @@
 #include "slang-ir-legalize-uniform-buffer-load.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
 void legalizeUniformBufferLoad(IRModule* module)
 {
+    SLANG_PROFILE;
     List<IRLoad*> workList;
     for (auto globalInst : module->getGlobalInsts())
     {
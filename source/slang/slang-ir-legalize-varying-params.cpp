@@ -1,5 +1,6 @@
 // slang-ir-legalize-varying-params.cpp
 #include "slang-ir-legalize-varying-params.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
@@ -1406,6 +1407,7 @@ void legalizeEntryPointVaryingParamsForCPU(
     IRModule*               module,
     DiagnosticSink*         sink)
 {
+    SLANG_PROFILE;
     CPUEntryPointVaryingParamLegalizeContext context;
     context.processModule(module, sink);
 }
@@ -1414,6 +1416,7 @@ void legalizeEntryPointVaryingParamsForCUDA(
     IRModule*               module,
     DiagnosticSink*         sink)
 {
+    SLANG_PROFILE;
     CUDAEntryPointVaryingParamLegalizeContext context;
     context.processModule(module, sink);
 }
@@ -2,6 +2,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -186,6 +187,7 @@ namespace Slang
 
     void legalizeVectorTypes(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         VectorTypeLoweringContext context(module);
         context.sink = sink;
         context.processModule();
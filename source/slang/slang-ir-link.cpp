@@ -54,10 +54,23 @@ struct IRSharedSpecContext
 
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    // in the *original* module. Names are only added
+    // when they are first looked up (see `findSymbol`),
+    // and the keys reference string literals in the
+    // original modules.
+    typedef Dictionary<UnownedStringSlice, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+    // String literals are deduplicated within an IR module, so the
+    // literal holding a mangled name identifies that name. This maps
+    // the literals that have been looked up to their symbols, so
+    // repeated lookups only hash and compare a pointer.
+    Dictionary<IRStringLit*, IRSpecSymbol*> symbolsByNameLit;
+
+    // Indices of the mangled names in each of the original
+    // modules, in the order the modules are searched.
+    List<RefPtr<IRMangledNameIndex>> moduleIndices;
+
     IRBuilder builderStorage;
 
     // The "global" specialization environment.
@@ -72,8 +85,6 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
-
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
     IRSpecEnv* getEnv()
@@ -219,6 +230,14 @@ struct IRSpecContext : IRSpecContextBase
 
 IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal);
 
+IRSpecSymbol* findSymbol(
+    IRSharedSpecContext*        sharedContext,
+    const UnownedStringSlice&   mangledName);
+
+IRSpecSymbol* findSymbol(
+    IRSharedSpecContext*        sharedContext,
+    IRStringLit*                mangledNameLit);
+
 IRInst* cloneValue(
     IRSpecContextBase*  context,
     IRInst*        originalValue);
@@ -787,9 +806,12 @@ void cloneGlobalValueWithCodeCommon(
     }
 }
 
-void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, UnownedStringSlice const& mangledName)
+void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, IRStringLit* mangledName)
 {
 #ifdef _DEBUG
+    // String literals are deduplicated within a module, so two
+    // instructions of the module have the same mangled name exactly
+    // when they share the same literal.
     for (auto child : moduleInst->getDecorationsAndChildren())
     {
         if (child == inst)
@@ -797,7 +819,7 @@ void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, UnownedStringSlice const
 
         if(auto childLinkage = child->findDecoration<IRLinkageDecoration>())
         {
-            if(mangledName == childLinkage->getMangledName())
+            if(mangledName == childLinkage->getMangledNameOperand())
             {
                 SLANG_UNEXPECTED("duplicate global instruction");
             }
@@ -836,7 +858,7 @@ void cloneFunctionCommon(
     {
         if( auto linkage = clonedFunc->findDecoration<IRLinkageDecoration>() )
         {
-            checkIRDuplicate(clonedFunc, context->getModule()->getModuleInst(), linkage->getMangledName());
+            checkIRDuplicate(clonedFunc, context->getModule()->getModuleInst(), linkage->getMangledNameOperand());
         }
     }
 }
@@ -920,12 +942,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = findSymbol(context->getShared(), mangledName.getUnownedSlice());
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().tryGetValue(hashedName, sym))
+        sym = findSymbol(context->getShared(), hashedName.getUnownedSlice());
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1308,9 +1331,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // with the same mangled name as `originalVal` and try
     // to pick the "best" one for our target.
 
-    auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().tryGetValue(mangledName, sym) )
+    IRSpecSymbol* sym = findSymbol(context->getShared(), originalLinkage->getMangledNameOperand());
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1367,46 +1389,68 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
+void addGlobalValueSymbols(
     IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+    IRMangledNameIndex*     index)
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
+    if (!index)
         return;
 
-    auto mangledName = String(linkage->getMangledName());
+    sharedContext->moduleIndices.add(index);
+}
 
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
+IRSpecSymbol* findSymbol(
+    IRSharedSpecContext*        sharedContext,
+    const UnownedStringSlice&   mangledName)
+{
+    if (auto found = sharedContext->symbols.tryGetValue(mangledName))
+        return *found;
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
+    // Gather every global value with linkage named `mangledName` from the
+    // modules being linked. The first value found heads the list, and each
+    // value found after it is inserted directly after the head, which is the
+    // order that ties between equally good values have always been broken in.
+    //
+    RefPtr<IRSpecSymbol> head;
+    for (auto index : sharedContext->moduleIndices)
     {
-        sharedContext->symbols.add(mangledName, sym);
+        for (Index i = index->findFirstEntry(mangledName); i >= 0; i = index->getEntry(i).next)
+        {
+            RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+            sym->irGlobalValue = index->getEntry(i).inst;
+
+            if (head)
+            {
+                sym->nextWithSameName = head->nextWithSameName;
+                head->nextWithSameName = sym;
+            }
+            else
+            {
+                head = sym;
+            }
+        }
     }
+
+    if (!head)
+        return nullptr;
+
+    // Key on the name held by the module, as `mangledName` may not outlive the context.
+    auto key = head->irGlobalValue->findDecoration<IRLinkageDecoration>()->getMangledName();
+    sharedContext->symbols.add(key, head);
+    return head;
 }
 
-void insertGlobalValueSymbols(
+IRSpecSymbol* findSymbol(
     IRSharedSpecContext*    sharedContext,
-    IRModule*               originalModule)
+    IRStringLit*            mangledNameLit)
 {
-    if (!originalModule)
-        return;
+    if (auto found = sharedContext->symbolsByNameLit.tryGetValue(mangledNameLit))
+        return *found;
 
-    for(auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
+    IRSpecSymbol* sym = findSymbol(sharedContext, mangledNameLit->getStringSlice());
+    if (sym)
+        sharedContext->symbolsByNameLit.add(mangledNameLit, sym);
+    return sym;
 }
 
 void initializeSharedSpecContext(
@@ -1735,36 +1779,42 @@ LinkedIR linkIR(
 
     // We need to be able to look up IR definitions for any symbols in
     // modules that the program depends on (transitively). To
-    // accelerate lookup, we will create a symbol table for looking
-    // up IR definitions by their mangled name.
+    // accelerate lookup, we use an index of each module's global
+    // values by mangled name, and build up the symbol table from
+    // those indices as names are looked up.
     //
 
     List<IRModule*> irModules;
 
     // Link stdlib modules.
+    //
+    // The stdlib modules are not modified once they have been created, so their
+    // indices are built once and shared by every link.
     auto& stdlibModules = static_cast<Session*>(linkage->getGlobalSession())->stdlibModules;
     for (auto& m : stdlibModules)
-        irModules.add(m->getIRModule());
+    {
+        IRModule* irModule = m->getIRModule();
+        irModules.add(irModule);
+        addGlobalValueSymbols(sharedContext, irModule ? irModule->getMangledNameIndex() : nullptr);
+    }
 
     // Link modules in the program.
+    //
+    // These modules can still change between links (for example when they are
+    // precompiled for a target), so they are indexed for this link only.
     program->enumerateIRModules([&](IRModule* irModule)
     {
         irModules.add(irModule);
+        addGlobalValueSymbols(sharedContext, irModule ? new IRMangledNameIndex(irModule) : nullptr);
     });
 
-    // Add any modules that were loaded as libraries
-    for (IRModule* irModule : irModules)
-    {
-        insertGlobalValueSymbols(sharedContext, irModule);
-    }
-
     // We will also insert the IR global symbols from the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
     // global symbols via decorations.
     //
     auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    addGlobalValueSymbols(sharedContext, irModuleForLayout ? new IRMangledNameIndex(irModuleForLayout) : nullptr);
 
     auto context = state->getContext();
 
@@ -1988,6 +2038,7 @@ struct ReplaceGlobalConstantsPass
 
 void replaceGlobalConstants(IRModule* module)
 {
+    SLANG_PROFILE;
     ReplaceGlobalConstantsPass pass;
     pass.process(module);
 }
@@ -418,17 +418,13 @@ List<IRLoop*> collectLoopsInFunc(IRGlobalValueWithCode* func, const TFunc& filte
 {
     List<IRLoop*> loops;
 
-    // Post order processing allows us to process inner loops first.
-    auto postOrder = getPostorder(func);
-
-    for (auto block : postOrder)
+    // The loops are in post order, so inner loops are processed first.
+    auto loopInfo = func->getModule()->findOrCreateAnalysis<IRLoopInfo>(func);
+    for (auto loop : loopInfo->getLoops())
     {
-        if (auto loop = as<IRLoop>(block->getTerminator()))
+        if (filter(loop))
         {
-            if (filter(loop))
-            {
-                loops.add(loop);
-            }
+            loops.add(loop);
         }
     }
     return loops;
@@ -451,7 +447,7 @@ bool unrollLoopsInFunc(
         // Remove any continue jumps from the loop.
         eliminateContinueBlocks(module, loop);
 
-        auto blocks = collectBlocksInRegion(func, loop);
+        auto blocks = module->findOrCreateAnalysis<IRLoopInfo>(func)->getLoopBlocks(loop);
         auto loopLoc = loop->sourceLoc;
         if (!_unrollLoop(targetProgram, module, loop, blocks))
         {
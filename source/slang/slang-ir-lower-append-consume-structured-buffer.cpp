@@ -4,6 +4,7 @@
 #include "slang-ir-util.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-lower-buffer-element-type.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -255,6 +256,7 @@ namespace Slang
 
     void lowerAppendConsumeStructuredBuffers(TargetProgram* target, IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         SLANG_UNUSED(sink);
         for (auto globalInst : module->getGlobalInsts())
         {
@@ -3,6 +3,7 @@
 #include "slang-ir-lower-tuple-types.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 // The pass in this file lowers the `getRegisterIndex()` and
 // `getSpaceIndex()` intrinsics, by replacing them with literal
@@ -610,6 +611,7 @@ namespace Slang
         IRModule* module,
         DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         BindingQueryLoweringContext context(module);
         context.sink = sink;
         context.processModule();
@@ -3,6 +3,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir-extract-value-from-type.h"
 #include "slang-ir-layout.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -262,6 +263,7 @@ struct BitCastLoweringContext
 
 void lowerBitCast(TargetProgram* targetProgram, IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     BitCastLoweringContext context;
     context.module = module;
     context.targetProgram = targetProgram;
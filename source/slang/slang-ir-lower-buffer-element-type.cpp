@@ -4,6 +4,7 @@
 #include "slang-ir-util.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-layout.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -876,6 +877,7 @@ namespace Slang
 
     void lowerBufferElementTypeToStorageType(TargetProgram* target, IRModule* module, bool lowerBufferPointer)
     {
+        SLANG_PROFILE;
         SlangMatrixLayoutMode defaultMatrixMode = (SlangMatrixLayoutMode)target->getOptionSet().getMatrixLayoutMode();
         if ((isCPUTarget(target->getTargetReq()) || isCUDATarget(target->getTargetReq()) || isMetalTarget(target->getTargetReq())))
             defaultMatrixMode = SLANG_MATRIX_LAYOUT_ROW_MAJOR;
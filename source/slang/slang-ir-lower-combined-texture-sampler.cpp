@@ -1,4 +1,5 @@
 #include "slang-ir-lower-combined-texture-sampler.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
@@ -94,6 +95,7 @@ namespace Slang
         IRModule* module,
         DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         SLANG_UNUSED(sink);
 
         LowerCombinedSamplerContext context;
@@ -274,6 +274,7 @@ namespace Slang
 
     void cleanupGenerics(TargetProgram* program, IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         SharedGenericsLoweringContext sharedContext(module);
         sharedContext.targetProgram = program;
         sharedContext.sink = sink;
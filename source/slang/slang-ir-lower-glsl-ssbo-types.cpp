@@ -1,6 +1,7 @@
 #include "slang-ir-lower-glsl-ssbo-types.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -214,6 +215,7 @@ namespace Slang
 
     void lowerGLSLShaderStorageBufferObjectsToStructuredBuffers(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         lowerArrayLikeSSBOs(module);
         lowerStructLikeSSBOs(module);
         diagnoseRemainingSSBOs(module, sink);
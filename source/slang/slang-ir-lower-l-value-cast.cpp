@@ -1,4 +1,5 @@
 #include "slang-ir-lower-l-value-cast.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -226,6 +227,7 @@ struct LValueCastLoweringContext
 
 void lowerLValueCast(TargetProgram* target, IRModule* module)
 { 
+    SLANG_PROFILE;
     LValueCastLoweringContext context(target, module);
     context.processModule();
 }
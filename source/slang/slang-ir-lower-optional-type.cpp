@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -290,6 +291,7 @@ namespace Slang
     
     void lowerOptionalType(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         OptionalTypeLoweringContext context(module);
         context.sink = sink;
         context.processModule();
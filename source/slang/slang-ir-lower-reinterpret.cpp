@@ -4,6 +4,7 @@
 #include "slang-ir-layout.h"
 #include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-any-value-inference.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -93,6 +94,7 @@ struct ReinterpretLoweringContext
 
 void lowerReinterpret(TargetProgram* target, IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     // Before processing reinterpret insts, ensure that existential types without 
     // user-defined sizes have inferred sizes where possible.
     // 
@@ -3,6 +3,7 @@
 #include "slang-ir-lower-result-type.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -298,6 +299,7 @@ namespace Slang
     
     void lowerResultType(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         ResultTypeLoweringContext context(module);
         context.sink = sink;
         context.processModule();
@@ -1,4 +1,5 @@
 #include "slang-ir-metal-legalize.h"
+#include "../core/slang-performance-profiler.h"
 
 #include <set>
 #include "slang-ir.h"
@@ -1734,6 +1735,7 @@ namespace Slang
 
     void legalizeIRForMetal(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         List<EntryPointInfo> entryPoints;
         for (auto inst : module->getGlobalInsts())
         {
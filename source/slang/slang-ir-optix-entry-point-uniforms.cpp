@@ -4,6 +4,7 @@
 // slang-ir-entry-point-uniforms.cpp
 
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-entry-point-pass.h"
@@ -265,6 +266,7 @@ struct CollectOptixEntryPointUniformParams : PerEntryPointPass {
 void collectOptiXEntryPointUniformParams(
     IRModule* module)
 {
+    SLANG_PROFILE;
     // look into all entry point functions by checking the IREntryPointDecoration on the children 
     // Insts of the module. For any ray tracing entry points, collect all uniform parameters into one
     // common struct, and replace parameter usage with SBT record accesses.
@@ -1137,7 +1137,7 @@ struct PeepholeContext : InstPassBase
         return type->parent->getOp() == kIROp_Module && !as<IRGlobalGenericParam>(type);
     }
 
-    bool processFunc(IRInst* func)
+    bool processFunc(IRInst* func, IRChangedInsts* changedInsts = nullptr)
     {
         if (!useFastAnalysis)
             func->getModule()->invalidateAllAnalysis();
@@ -1146,16 +1146,15 @@ struct PeepholeContext : InstPassBase
         if (!isInGeneric)
             isInGeneric = as<IRGeneric>(func) != nullptr;
 
-        bool result = false;
-        for (;;)
-        {
-            changed = false;
-            processChildInsts(func, [this](IRInst* inst) { processInst(inst); });
-            if (changed)
-                result = true;
-            else
-                break;
-        }
+        // The instructions affected by a change are visited again straight away, until
+        // there are none left, rather than scanning the whole function again.
+        bool result = processChildInstsUntilUnchanged(func, [this](IRInst* inst)
+            {
+                changed = false;
+                processInst(inst);
+                return changed;
+            }, changedInsts);
+        changed = false;
 
         isInGeneric = lastIsInGeneric;
 
@@ -1179,14 +1178,14 @@ bool peepholeOptimize(TargetProgram* target, IRModule* module, PeepholeOptimizat
     return context.processModule();
 }
 
-bool peepholeOptimize(TargetProgram* target, IRInst* func)
+bool peepholeOptimize(TargetProgram* target, IRInst* func, IRChangedInsts* changedInsts)
 {
     PeepholeContext context = PeepholeContext(func->getModule());
     context.targetProgram = target;
     context.useFastAnalysis = target
         ? target->getOptionSet().getBoolOption(CompilerOptionName::MinimumSlangOptimization)
         : true;
-    return context.processFunc(func);
+    return context.processFunc(func, changedInsts);
 }
 
 bool peepholeOptimizeInst(TargetProgram* target, IRModule* module, IRInst* inst)
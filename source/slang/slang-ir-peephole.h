@@ -6,6 +6,7 @@ namespace Slang
     struct IRModule;
     struct IRCall;
     struct IRInst;
+    struct IRChangedInsts;
     class TargetProgram;
 
     struct PeepholeOptimizationOptions
@@ -21,7 +22,10 @@ namespace Slang
 
         /// Apply peephole optimizations.
     bool peepholeOptimize(TargetProgram* target, IRModule* module, PeepholeOptimizationOptions options);
-    bool peepholeOptimize(TargetProgram* target, IRInst* func);
+        /// Apply peephole optimizations to `func`. If `changedInsts` is set, only the instructions
+        /// in it (and any affected by changes to them) are visited, unless everything is marked as
+        /// changed.
+    bool peepholeOptimize(TargetProgram* target, IRInst* func, IRChangedInsts* changedInsts = nullptr);
     bool peepholeOptimizeInst(TargetProgram* target, IRModule* module, IRInst* inst);
     bool peepholeOptimizeGlobalScope(TargetProgram* target, IRModule* module);
     bool tryReplaceInstUsesWithSimplifiedValue(TargetProgram* target, IRModule* module, IRInst* inst);
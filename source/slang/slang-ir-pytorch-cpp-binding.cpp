@@ -4,6 +4,7 @@
 #include "slang-diagnostics.h"
 #include "slang-ir-autodiff.h"
 #include "slang-ir-lower-cuda-builtin-types.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -985,6 +986,7 @@ IRFunc* generateCUDAWrapperForFunc(IRFunc* func, DiagnosticSink* sink)
 
 void lowerBuiltinTypesForKernelEntryPoints(IRModule* module, DiagnosticSink*)
 {
+    SLANG_PROFILE;
     List<IRFunc*> cudaKernels;
     for (auto globalInst : module->getGlobalInsts())
     {
@@ -1114,6 +1116,7 @@ void lowerBuiltinTypesForKernelEntryPoints(IRModule* module, DiagnosticSink*)
 
 void generateHostFunctionsForAutoBindCuda(IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     List<IRFunc*> autoBindRequests;
     for (auto globalInst : module->getGlobalInsts())
     {
@@ -1134,6 +1137,7 @@ void generateHostFunctionsForAutoBindCuda(IRModule* module, DiagnosticSink* sink
 
 void generatePyTorchCppBinding(IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     List<IRFunc*> workList;
     List<IRFunc*> cudaKernels;
     List<IRType*> typesToExport;
@@ -1195,6 +1199,7 @@ void generatePyTorchCppBinding(IRModule* module, DiagnosticSink* sink)
 // Remove all [TorchEntryPoint] functions when emitting CUDA source.
 void removeTorchKernels(IRModule* module)
 {
+    SLANG_PROFILE;
     List<IRInst*> toRemove;
     for (auto globalInst : module->getGlobalInsts())
     {
@@ -1209,6 +1214,7 @@ void removeTorchKernels(IRModule* module)
 
 void handleAutoBindNames(IRModule* module)
 {
+    SLANG_PROFILE;
     // We need to rewrite extern-cpp names for functions that have an auto-bind decoration.
     // since the name needs to be used for the host function.
     //
@@ -1233,6 +1239,7 @@ void handleAutoBindNames(IRModule* module)
 
 void removeTorchAndCUDAEntryPoints(IRModule* module)
 {
+    SLANG_PROFILE;
     // Go through global insts, find cuda & torch related entry points and remove the keep-alive decoration.
     IRBuilder builder(module);
     for (auto globalInst : module->getGlobalInsts())
@@ -1254,6 +1261,7 @@ void removeTorchAndCUDAEntryPoints(IRModule* module)
 
 void generateDerivativeWrappers(IRModule* module, DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     SLANG_UNUSED(sink);
     for (auto globalInst : module->getGlobalInsts())
     {
@@ -1,5 +1,6 @@
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-dominators.h"
+#include "slang-ir-inst-pass-base.h"
 #include "slang-ir-util.h"
 
 namespace Slang
@@ -8,6 +9,8 @@ namespace Slang
 struct RedundancyRemovalContext
 {
     RefPtr<IRDominatorTree> dom;
+    // If set, the instructions changed by the pass are added to it
+    IRChangedInsts* changedInsts = nullptr;
     bool isSingleIterationLoop(IRLoop* loop)
     {
         int useCount = 0;
@@ -59,6 +62,8 @@ struct RedundancyRemovalContext
 
                 // Move inst to parentBlock.
                 inst->insertBefore(terminatorInst);
+                if (changedInsts)
+                    changedInsts->add(inst);
                 changed = true;
 
                 // Continue to consider outer hoisting positions.
@@ -84,6 +89,8 @@ struct RedundancyRemovalContext
                 });
             if (resultInst != instP)
             {
+                if (changedInsts)
+                    changedInsts->addUsersOf(instP);
                 instP->replaceUsesWith(resultInst);
                 instP->removeAndDeallocate();
                 result = true;
@@ -122,14 +129,15 @@ bool removeRedundancy(IRModule* module)
     return changed;
 }
 
-bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
+bool removeRedundancyInFunc(IRGlobalValueWithCode* func, IRChangedInsts* changedInsts)
 {
     auto root = func->getFirstBlock();
     if (!root)
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    context.dom = func->getModule()->findOrCreateDominatorTree(func);
+    context.changedInsts = changedInsts;
     Dictionary<IRBlock*, DeduplicateContext> mapBlockToDeduplicateContext;
     for (auto block : func->getBlocks())
     {
@@ -154,7 +162,13 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
     }
     if (auto normalFunc = as<IRFunc>(func))
     {
-        result |= eliminateRedundantLoadStore(normalFunc);
+        // Loads and stores are not tracked individually.
+        if (eliminateRedundantLoadStore(normalFunc))
+        {
+            if (changedInsts)
+                changedInsts->markEverythingChanged();
+            result = true;
+        }
     }
     return result;
 }
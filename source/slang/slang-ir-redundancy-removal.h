@@ -5,9 +5,12 @@ namespace Slang
 {
     struct IRModule;
     struct IRGlobalValueWithCode;
+    struct IRChangedInsts;
 
     bool removeRedundancy(IRModule* module);
-    bool removeRedundancyInFunc(IRGlobalValueWithCode* func);
+        /// Remove redundant instructions from `func`. If `changedInsts` is set, the instructions
+        /// that are changed are added to it.
+    bool removeRedundancyInFunc(IRGlobalValueWithCode* func, IRChangedInsts* changedInsts = nullptr);
 
     bool eliminateRedundantLoadStore(IRGlobalValueWithCode* func);
 }
@@ -1,8 +1,10 @@
 // slang-ir-sccp.cpp
 #include "slang-ir-sccp.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-inst-pass-base.h"
 
 namespace Slang {
 
@@ -16,6 +18,9 @@ struct SharedSCCPContext
 {
     IRModule*       module;
     DiagnosticSink* sink;
+
+    // If set, the instructions changed by the pass are added to it
+    IRChangedInsts* changedInsts = nullptr;
 };
 //
 // Next we have a context struct that will be applied for each function (or other
@@ -1553,6 +1558,8 @@ struct SCCPContext
                 // instructions to be removed *iff* the instruction
                 // is known to have no obersvable side effects.
                 //
+                if (shared->changedInsts)
+                    shared->changedInsts->addUsersOf(inst);
                 inst->replaceUsesWith(constantVal);
                 if( !inst->mightHaveSideEffects() )
                 {
@@ -1654,6 +1661,13 @@ struct SCCPContext
                 unreachableBlocks.add(block);
             }
         }
+
+        // Changes to the control flow graph can make instructions anywhere in the
+        // function simplifiable, such as the parameters of a block that lost a
+        // predecessor, so they are not tracked individually.
+        //
+        if (shared->changedInsts && (changed || unreachableBlocks.getCount() != 0))
+            shared->changedInsts->markEverythingChanged();
         //
         // It might seem like we could just do:
         //
@@ -1787,6 +1801,7 @@ bool applySparseConditionalConstantPropagation(
     IRModule*       module,
     DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     if (sink && sink->getErrorCount())
         return false;
 
@@ -1823,7 +1838,7 @@ bool applySparseConditionalConstantPropagationForGlobalScope(
     return changed;
 }
 
-bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sink)
+bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sink, IRChangedInsts* changedInsts)
 {
     if (sink && sink->getErrorCount())
         return false;
@@ -1831,6 +1846,7 @@ bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sin
     SharedSCCPContext shared;
     shared.module = func->getModule();
     shared.sink = sink;
+    shared.changedInsts = changedInsts;
 
     SCCPContext globalContext;
     globalContext.shared = &shared;
@@ -5,6 +5,7 @@ namespace Slang
 {
     struct IRModule;
     struct IRInst;
+    struct IRChangedInsts;
     class DiagnosticSink;
 
         /// Apply Sparse Conditional Constant Propagation (SCCP) to a module.
@@ -22,7 +23,9 @@ namespace Slang
         IRModule* module,
         DiagnosticSink* sink);
 
-    bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sink);
+        /// Apply SCCP to `func`. If `changedInsts` is set, the instructions that are changed
+        /// are added to it.
+    bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sink, IRChangedInsts* changedInsts = nullptr);
 
     IRInst* tryConstantFoldInst(IRModule* module, IRInst* inst);
 }
@@ -86,7 +86,7 @@ static bool isTrivialSingleIterationLoop(
     // We need to verify this is a trivial loop by checking if there is any multi-level breaks
     // that skips out of this loop.
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = func->getModule()->findOrCreateDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     auto loopBlocks = collectBlocksInRegion(context.domTree, loop, &hasMultiLevelBreaks);
     if (hasMultiLevelBreaks)
@@ -154,7 +154,7 @@ static bool doesLoopHasSideEffect(CFGSimplificationContext& context, Reachabilit
 {
     bool hasMultiLevelBreaks = false;
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = func->getModule()->findOrCreateDominatorTree(func);
     auto blocks = collectBlocksInRegion(context.domTree.get(), loopInst, &hasMultiLevelBreaks);
 
     // We'll currently not deal with loops that contain multi-level breaks.
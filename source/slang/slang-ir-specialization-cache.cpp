@@ -0,0 +1,484 @@
+// slang-ir-specialization-cache.cpp
+#include "slang-ir-specialization-cache.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-structural-hash.h"
+#include "slang-ir-util.h"
+
+#include "../core/slang-performance-profiler.h"
+
+namespace Slang
+{
+    // Clone a constant or an hoistable instruction (such as a type) using `builder`, mapping its
+    // type and operands with `mapOperand`. Returns nullptr if `value` can't be cloned this way,
+    // or if any of the operands can't be mapped.
+    template<typename F>
+    static IRInst* _cloneHoistableValue(IRBuilder& builder, IRInst* value, const F& mapOperand)
+    {
+        IRType* type = nullptr;
+        if (auto oldType = value->getFullType())
+        {
+            type = (IRType*)mapOperand(oldType);
+            if (!type)
+            {
+                return nullptr;
+            }
+        }
+
+        if (auto constant = as<IRConstant>(value))
+        {
+            switch (constant->getOp())
+            {
+            case kIROp_BoolLit:     return builder.getBoolValue(constant->value.intVal != 0);
+            case kIROp_IntLit:      return builder.getIntValue(type, constant->value.intVal);
+            case kIROp_FloatLit:    return builder.getFloatValue(type, constant->value.floatVal);
+            case kIROp_StringLit:   return builder.getStringValue(constant->getStringSlice());
+            case kIROp_VoidLit:     return builder.getVoidValue();
+            case kIROp_PtrLit:
+                return constant->value.ptrVal ? nullptr : builder.getNullPtrValue(type);
+            default:
+                return nullptr;
+            }
+        }
+
+        // Only hoistable instructions are identified by their operands alone
+        if (!getIROpInfo(value->getOp()).isHoistable() || value->getFirstDecorationOrChild())
+        {
+            return nullptr;
+        }
+
+        const UInt operandCount = value->getOperandCount();
+        ShortList<IRInst*> operands;
+        operands.setCount(operandCount);
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            auto operand = value->getOperand(i);
+            operands[i] = operand ? mapOperand(operand) : nullptr;
+            if (!operands[i])
+            {
+                return nullptr;
+            }
+        }
+        return builder.emitIntrinsicInst(type, value->getOp(), operandCount, operands.getArrayView().getBuffer());
+    }
+
+    static bool _isCacheableGeneric(IRInst* base)
+    {
+        // The generic is only identified by its structural hash, which for a generic with
+        // linkage includes its mangled name.
+        return as<IRGeneric>(base) && base->findDecoration<IRLinkageDecoration>();
+    }
+
+    static HashCode64 _calcKey(IRStructuralHashContext& hashContext, IRSpecialize* specializeInst)
+    {
+        // The hash of the specialize inst covers the generic's name and the arguments. The body
+        // of the generic is included too, as it can be changed by passes that run between
+        // specializations.
+        Hasher hasher;
+        hasher.addHash(hashContext.getGlobalHash(specializeInst));
+        hasher.addHash(hashContext.getFuncHash(as<IRGeneric>(specializeInst->getBase())));
+        return hasher.getResult();
+    }
+
+    /* IRSpecializationCache::ModuleSymbols */
+
+    IRSpecializationCache::ModuleSymbols::ModuleSymbols(IRModule* inModule)
+        : module(inModule)
+    {
+    }
+
+    IRInst* IRSpecializationCache::ModuleSymbols::find(const UnownedStringSlice& mangledName)
+    {
+        auto moduleInst = module->getModuleInst();
+        if (!m_isBuilt)
+        {
+            m_isBuilt = true;
+            for (auto inst : moduleInst->getChildren())
+            {
+                if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+                {
+                    const auto name = linkage->getMangledName();
+                    // A name that is used more than once can't identify a value
+                    if (m_symbols.containsKey(name))
+                        m_symbols.set(name, nullptr);
+                    else
+                        m_symbols.add(name, inst);
+                }
+            }
+        }
+
+        auto found = m_symbols.tryGetValue(mangledName);
+        // The module may have been changed since the symbols were found, so check that the
+        // value is still in it.
+        if (!found || !*found || (*found)->getParent() != moduleInst)
+        {
+            return nullptr;
+        }
+        return *found;
+    }
+
+    /* IRSpecializationCache */
+
+    struct IRSpecializationCache::ExportContext
+    {
+        IRStructuralHashContext hashContext;
+        IRCloneEnv env;
+        IRBuilder* builder = nullptr;
+            /// Global values with linkage are only recorded as dependencies while this is set
+        bool isRecordingDependencies = true;
+        List<Dependency> dependencies;
+        List<IRInst*> values;
+            /// The number of instructions visited while exporting
+        Count instCount = 0;
+    };
+
+    struct IRSpecializationCache::CompareContext
+    {
+            /// Maps insts in m_module to the insts in the linked module they have been matched with
+        Dictionary<IRInst*, IRInst*> matched;
+    };
+
+    IRSpecializationCache::IRSpecializationCache(Session* session)
+        : m_session(session)
+    {
+    }
+
+    IRInst* IRSpecializationCache::_getPlaceholder(const UnownedStringSlice& mangledName)
+    {
+        if (auto placeholder = m_placeholders.tryGetValue(mangledName))
+        {
+            return *placeholder;
+        }
+
+        IRBuilder builder(m_module);
+        builder.setInsertInto(m_module->getModuleInst());
+
+        // The placeholder is never used as anything other than an operand, so any kind of
+        // global value will do. The name is held by its decoration, so it lives as long as
+        // the module.
+        auto placeholder = builder.createStructKey();
+        builder.addImportDecoration(placeholder, mangledName);
+
+        const auto name = placeholder->findDecoration<IRLinkageDecoration>()->getMangledName();
+        m_placeholders.add(name, placeholder);
+        return placeholder;
+    }
+
+    IRInst* IRSpecializationCache::_exportValue(ExportContext& context, IRInst* value)
+    {
+        if (auto exported = context.env.mapOldValToNew.tryGetValue(value))
+        {
+            return *exported;
+        }
+
+        IRInst* exportedValue = nullptr;
+        if (auto linkage = value->findDecoration<IRLinkageDecoration>())
+        {
+            exportedValue = _getPlaceholder(linkage->getMangledName());
+            if (context.isRecordingDependencies)
+            {
+                context.dependencies.add(Dependency{ exportedValue, value, context.hashContext.getGlobalHash(value) });
+            }
+        }
+        else
+        {
+            exportedValue = _cloneHoistableValue(*context.builder, value,
+                [&](IRInst* operand) { return _exportValue(context, operand); });
+            if (!exportedValue)
+            {
+                return nullptr;
+            }
+            context.values.add(exportedValue);
+        }
+
+        context.env.mapOldValToNew[value] = exportedValue;
+        return exportedValue;
+    }
+
+    IRInst* IRSpecializationCache::_exportTree(ExportContext& context, IRInst* root)
+    {
+        // Find everything that the tree references from outside of itself
+        List<IRInst*> insts;
+        insts.add(root);
+        for (Index i = 0; i < insts.getCount(); ++i)
+        {
+            IRInst* inst = insts[i];
+            for (auto child : inst->getDecorationsAndChildren())
+            {
+                insts.add(child);
+            }
+
+            if (auto type = inst->getFullType())
+            {
+                if (!isChildInstOf(type, root) && !_exportValue(context, type))
+                {
+                    return nullptr;
+                }
+            }
+            for (UInt j = 0; j < inst->getOperandCount(); ++j)
+            {
+                auto operand = inst->getOperand(j);
+                if (operand && !isChildInstOf(operand, root) && !_exportValue(context, operand))
+                {
+                    return nullptr;
+                }
+            }
+        }
+        context.instCount += insts.getCount();
+
+        // References from inside the tree (including to the root itself) are to the copy
+        IRCloneEnv env;
+        env.parent = &context.env;
+        return cloneInst(&env, context.builder, root);
+    }
+
+    bool IRSpecializationCache::_isSameValue(CompareContext& context, IRInst* cached, IRInst* value)
+    {
+        if (!cached || !value)
+        {
+            return cached == value;
+        }
+        if (auto matched = context.matched.tryGetValue(cached))
+        {
+            return *matched == value;
+        }
+
+        bool isSame = false;
+        if (auto cachedLinkage = cached->findDecoration<IRLinkageDecoration>())
+        {
+            // A placeholder stands for any value with the same name
+            auto placeholder = m_placeholders.tryGetValue(cachedLinkage->getMangledName());
+            if (placeholder && *placeholder == cached)
+            {
+                auto linkage = value->findDecoration<IRLinkageDecoration>();
+                isSame = linkage && linkage->getMangledName() == cachedLinkage->getMangledName();
+            }
+        }
+        else if (cached->getOp() == value->getOp() &&
+            cached->getOperandCount() == value->getOperandCount() &&
+            !value->getFirstDecorationOrChild())
+        {
+            // Otherwise it's a constant or hoistable value, as made by _cloneHoistableValue
+            isSame = _isSameValue(context, cached->getFullType(), value->getFullType());
+            if (auto cachedConstant = as<IRConstant>(cached))
+            {
+                isSame = isSame && cachedConstant->isValueEqual(as<IRConstant>(value));
+            }
+            for (UInt i = 0; isSame && i < cached->getOperandCount(); ++i)
+            {
+                isSame = _isSameValue(context, cached->getOperand(i), value->getOperand(i));
+            }
+        }
+
+        if (isSame)
+        {
+            context.matched[cached] = value;
+        }
+        return isSame;
+    }
+
+    bool IRSpecializationCache::_isSameTree(CompareContext& context, IRInst* cached, IRInst* value)
+    {
+        if (auto matched = context.matched.tryGetValue(cached))
+        {
+            return *matched == value;
+        }
+
+        // Pair up the insts of the two trees first, as operands can refer to insts later in the tree
+        List<KeyValuePair<IRInst*, IRInst*>> pairs;
+        pairs.add(KeyValuePair<IRInst*, IRInst*>(cached, value));
+        context.matched[cached] = value;
+        for (Index i = 0; i < pairs.getCount(); ++i)
+        {
+            IRInst* cachedInst = pairs[i].key;
+            IRInst* inst = pairs[i].value;
+            if (cachedInst->getOp() != inst->getOp() ||
+                cachedInst->getOperandCount() != inst->getOperandCount())
+            {
+                return false;
+            }
+            if (auto cachedConstant = as<IRConstant>(cachedInst))
+            {
+                if (!cachedConstant->isValueEqual(as<IRConstant>(inst)))
+                {
+                    return false;
+                }
+            }
+
+            auto cachedChild = cachedInst->getFirstDecorationOrChild();
+            auto child = inst->getFirstDecorationOrChild();
+            for (; cachedChild && child; cachedChild = cachedChild->getNextInst(), child = child->getNextInst())
+            {
+                pairs.add(KeyValuePair<IRInst*, IRInst*>(cachedChild, child));
+                context.matched[cachedChild] = child;
+            }
+            if (cachedChild || child)
+            {
+                return false;
+            }
+        }
+
+        for (const auto& pair : pairs)
+        {
+            if (!_isSameValue(context, pair.key->getFullType(), pair.value->getFullType()))
+            {
+                return false;
+            }
+            for (UInt i = 0; i < pair.key->getOperandCount(); ++i)
+            {
+                if (!_isSameValue(context, pair.key->getOperand(i), pair.value->getOperand(i)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void IRSpecializationCache::add(IRSpecialize* specializeInst, IRFunc* func)
+    {
+        if (!_isCacheableGeneric(specializeInst->getBase()))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_instCount >= kMaxInstCount)
+        {
+            return;
+        }
+
+        ExportContext context;
+        const HashCode64 key = _calcKey(context.hashContext, specializeInst);
+        if (m_entries.containsKey(key))
+        {
+            return;
+        }
+
+        if (!m_module)
+        {
+            m_module = IRModule::create(m_session);
+        }
+
+        IRBuilder builder(m_module);
+        builder.setInsertInto(m_module->getModuleInst());
+        context.builder = &builder;
+
+        // Anything exported is kept in m_module even if the function turns out not to be
+        // cacheable, so it counts towards the size of the cache either way.
+        Entry entry;
+        bool isCacheable = true;
+
+        // The arguments must be identifiable in other modules for the key to be meaningful
+        for (UInt i = 0; isCacheable && i < specializeInst->getArgCount(); ++i)
+        {
+            auto arg = _exportValue(context, specializeInst->getArg(i));
+            entry.args.add(arg);
+            isCacheable = arg != nullptr;
+        }
+
+        if (isCacheable)
+        {
+            entry.generic = _exportTree(context, specializeInst->getBase());
+            entry.func = as<IRFunc>(_exportTree(context, func));
+            isCacheable = entry.generic && entry.func;
+        }
+
+        // Only the values referenced so far need to be cloned along with the function
+        const Count valueCount = context.values.getCount();
+
+        // Copy the global values the function depends on, so they can be compared in full
+        context.isRecordingDependencies = false;
+        for (Index i = 0; isCacheable && i < context.dependencies.getCount(); ++i)
+        {
+            auto& dependency = context.dependencies[i];
+            dependency.value = _exportTree(context, dependency.value);
+            isCacheable = dependency.value != nullptr;
+        }
+
+        m_instCount += context.instCount;
+        if (!isCacheable)
+        {
+            return;
+        }
+
+        context.values.setCount(valueCount);
+
+        entry.dependencies = _Move(context.dependencies);
+        entry.values = _Move(context.values);
+        m_entries.add(key, _Move(entry));
+    }
+
+    IRFunc* IRSpecializationCache::findAndClone(IRSpecialize* specializeInst, ModuleSymbols& symbols, IRInst* insertBefore)
+    {
+        if (!_isCacheableGeneric(specializeInst->getBase()))
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_entries.getCount() == 0)
+        {
+            return nullptr;
+        }
+
+        IRStructuralHashContext hashContext;
+        auto entry = m_entries.tryGetValue(_calcKey(hashContext, specializeInst));
+        if (!entry)
+        {
+            return nullptr;
+        }
+
+        // The hash matching doesn't mean the specialization is the same, so compare the generic,
+        // the arguments, and every global value the function was specialized with.
+        CompareContext compareContext;
+        if (specializeInst->getArgCount() != UInt(entry->args.getCount()) ||
+            !_isSameTree(compareContext, entry->generic, specializeInst->getBase()))
+        {
+            return nullptr;
+        }
+        for (UInt i = 0; i < specializeInst->getArgCount(); ++i)
+        {
+            if (!_isSameValue(compareContext, entry->args[i], specializeInst->getArg(i)))
+            {
+                return nullptr;
+            }
+        }
+
+        IRCloneEnv env;
+        for (const auto& dependency : entry->dependencies)
+        {
+            const auto name = dependency.placeholder->findDecoration<IRLinkageDecoration>()->getMangledName();
+            auto value = symbols.find(name);
+            if (!value ||
+                hashContext.getGlobalHash(value) != dependency.hash ||
+                !_isSameTree(compareContext, dependency.value, value))
+            {
+                return nullptr;
+            }
+            env.mapOldValToNew[dependency.placeholder] = value;
+        }
+
+        SLANG_PROFILE_SECTION(cloneCachedSpecialization);
+
+        IRBuilder builder(symbols.module);
+        builder.setInsertBefore(insertBefore);
+
+        for (auto value : entry->values)
+        {
+            auto clonedValue = _cloneHoistableValue(builder, value,
+                [&](IRInst* operand) -> IRInst*
+                {
+                    auto cloned = env.mapOldValToNew.tryGetValue(operand);
+                    return cloned ? *cloned : nullptr;
+                });
+            SLANG_ASSERT(clonedValue);
+            env.mapOldValToNew[value] = clonedValue;
+        }
+
+        return as<IRFunc>(cloneInst(&env, &builder, entry->func));
+    }
+}
@@ -0,0 +1,111 @@
+// slang-ir-specialization-cache.h
+#pragma once
+
+#include "slang-ir.h"
+
+#include <mutex>
+
+namespace Slang
+{
+    struct IRFunc;
+    struct IRSpecialize;
+
+        /// Holds generic functions that have been specialized by one link of a program, so that
+        /// later links of the same program for the same target (such as those for other entry
+        /// points) can reuse them rather than specializing them again. A function is cached as
+        /// it is produced by specialization, which only applies the fast simplifications to it;
+        /// the link that clones it simplifies it further along with the rest of its module.
+        ///
+        /// A cached function is kept in a module owned by the cache, along with copies of the
+        /// generic and arguments it was specialized with, and of the global values with linkage
+        /// it references. The cache is keyed by structural hash, and on a hash match all of the
+        /// copies are compared in full with the values in the module being linked. Global values
+        /// are matched between modules by mangled name, so functions that reference global values
+        /// without linkage are not cached. Global values referenced by the copies of global values
+        /// are matched by name alone.
+        ///
+        /// The cache can be used by links on different threads, as a target program is shared
+        /// between them.
+    class IRSpecializationCache : public RefObject
+    {
+    public:
+            /// The global values with linkage in a module that cached functions can be cloned into
+        struct ModuleSymbols
+        {
+            ModuleSymbols(IRModule* module);
+
+                /// Find the value in the module with `mangledName`, or nullptr if there is no
+                /// such value or the name is not unique.
+            IRInst* find(const UnownedStringSlice& mangledName);
+
+            IRModule* module;
+
+        protected:
+            bool m_isBuilt = false;
+            Dictionary<UnownedStringSlice, IRInst*> m_symbols;
+        };
+
+            /// The number of instructions the cache can hold. Once it holds this many, no more
+            /// functions are added to it.
+        static const Count kMaxInstCount = 256 * 1024;
+
+            /// Try to find a cached specialization for `specializeInst`, and if found clone it into
+            /// the module of `symbols` before `insertBefore`. Returns nullptr if there is none.
+        IRFunc* findAndClone(IRSpecialize* specializeInst, ModuleSymbols& symbols, IRInst* insertBefore);
+
+            /// Add `func`, the result of specializing `specializeInst`, to the cache if possible.
+        void add(IRSpecialize* specializeInst, IRFunc* func);
+
+        IRSpecializationCache(Session* session);
+
+    protected:
+        struct Dependency
+        {
+                /// The inst in m_module that stands in for the global value
+            IRInst* placeholder;
+                /// A copy of the global value the function was specialized with
+            IRInst* value;
+                /// The structural hash of the global value, to quickly reject a changed value
+            HashCode64 hash;
+        };
+
+        struct Entry
+        {
+                /// A copy of the generic that was specialized
+            IRInst* generic = nullptr;
+                /// The arguments it was specialized with
+            List<IRInst*> args;
+            IRFunc* func = nullptr;
+                /// Global values with linkage referenced by func, the generic or the arguments
+            List<Dependency> dependencies;
+                /// Hoistable insts and constants referenced by func, with operands before their users
+            List<IRInst*> values;
+        };
+
+        struct ExportContext;
+        struct CompareContext;
+
+        IRInst* _getPlaceholder(const UnownedStringSlice& mangledName);
+            /// Get the inst in m_module that represents `value`, or nullptr if it can't be represented
+        IRInst* _exportValue(ExportContext& context, IRInst* value);
+            /// Copy `root` and its children into m_module, or return nullptr if it can't be copied
+        IRInst* _exportTree(ExportContext& context, IRInst* root);
+
+            /// True if `cached`, an operand in m_module, stands for `value`
+        bool _isSameValue(CompareContext& context, IRInst* cached, IRInst* value);
+            /// True if `cached`, a copy made by _exportTree, has the same structure as `value`
+        bool _isSameTree(CompareContext& context, IRInst* cached, IRInst* value);
+
+            /// Guards everything below, as the links of a program can run on different threads
+        std::mutex m_mutex;
+
+        Session* m_session;
+        RefPtr<IRModule> m_module;
+            /// Maps a mangled name to its placeholder in m_module
+        Dictionary<UnownedStringSlice, IRInst*> m_placeholders;
+            /// Maps the structural hash of a specialize inst to the cached specialization
+        Dictionary<HashCode64, Entry> m_entries;
+            /// The number of instructions exported into m_module
+        Count m_instCount = 0;
+    };
+}
@@ -1,5 +1,6 @@
 // slang-ir-specialize-arrays.cpp
 #include "slang-ir-specialize-arrays.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-specialize-function-call.h"
 #include "slang-ir.h"
@@ -88,6 +89,7 @@ void specializeArrayParameters(
     CodeGenContext* codeGenContext,
     IRModule*       module)
 {
+    SLANG_PROFILE;
     ArrayParameterSpecializationCondition condition;
     condition.codeGenContext = codeGenContext;
     specializeFunctionCalls(codeGenContext, module, &condition);
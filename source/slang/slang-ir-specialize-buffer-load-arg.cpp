@@ -1,5 +1,6 @@
 // slang-ir-specialize-buffer-load-arg.cpp
 #include "slang-ir-specialize-buffer-load-arg.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -88,6 +89,7 @@ void specializeFuncsForBufferLoadArgs(
     CodeGenContext*         codegenContext,
     IRModule*               module)
 {
+    SLANG_PROFILE;
     FuncBufferLoadSpecializationCondition condition;
     specializeFunctionCalls(codegenContext, module, &condition);
 }
@@ -2,6 +2,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-compiler.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -26,6 +27,7 @@ namespace Slang
 
     void specializeMatrixLayout(TargetProgram* target, IRModule* module)
     {
+        SLANG_PROFILE;
         List<IRMatrixType*> typeWorkList;
         visitParent(typeWorkList, module->getModuleInst());
 
@@ -1,5 +1,6 @@
 // slang-ir-specialize-resources.cpp
 #include "slang-ir-specialize-resources.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-specialize-function-call.h"
 #include "slang-ir.h"
@@ -1228,6 +1229,7 @@ bool specializeResourceUsage(
     CodeGenContext* codeGenContext,
     IRModule*       irModule)
 {
+    SLANG_PROFILE;
     bool result = false;
     // We apply two kinds of specialization to clean up resource value usage:
     //
@@ -8,6 +8,7 @@
 #include "slang-ir-lower-witness-lookup.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-specialization-cache.h"
 #include "../core/slang-performance-profiler.h"
 
 namespace Slang
@@ -51,6 +52,10 @@ struct SpecializationContext
     TargetProgram* targetProgram;
     bool changed = false;
 
+    // Specialized functions shared with other links of the same target program,
+    // and the symbols of our module used to clone functions out of it.
+    IRSpecializationCache* specializationCache = nullptr;
+    IRSpecializationCache::ModuleSymbols cacheSymbols;
 
     SpecializationContext(IRModule* inModule, TargetProgram* target)
         : workList(*inModule->getContainerPool().getList<IRInst>())
@@ -58,7 +63,10 @@ struct SpecializationContext
         , cleanInsts(*inModule->getContainerPool().getHashSet<IRInst>())
         , module(inModule)
         , targetProgram(target)
+        , cacheSymbols(inModule)
     {
+        if (target)
+            specializationCache = target->getSpecializationCache();
     }
     ~SpecializationContext()
     {
@@ -285,7 +293,22 @@ struct SpecializationContext
         // can be re-used in other cases that need to
         // do one-off specialization.
         //
-        IRInst* specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+        // A function may already have been specialized for the same arguments by an
+        // earlier link of the program, in which case we can clone the result from
+        // the cache rather than specializing it again.
+        //
+        IRInst* specializedVal = nullptr;
+        if (specializationCache)
+            specializedVal = specializationCache->findAndClone(specializeInst, cacheSymbols, genericVal);
+        if (!specializedVal)
+        {
+            specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+            if (specializationCache)
+            {
+                if (auto func = as<IRFunc>(specializedVal))
+                    specializationCache->add(specializeInst, func);
+            }
+        }
 
         // The body of the specialized generic may expose more specialization opportunities, so
         // we add the children to workList.
@@ -2696,6 +2719,7 @@ bool specializeModule(
 
 void finalizeSpecialization(IRModule* module)
 {
+    SLANG_PROFILE;
     // Go through all the top-level children of module's module inst,
     // and remove any specialization dictionary insts.
     //
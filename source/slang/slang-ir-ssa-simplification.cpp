@@ -1,6 +1,7 @@
 // slang-ir-ssa-simplification.cpp
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir.h"
+#include "slang-ir-inst-pass-base.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-sccp.h"
 #include "slang-ir-dce.h"
@@ -10,6 +11,7 @@
 #include "slang-ir-remove-unused-generic-param.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-propagate-func-properties.h"
+#include "slang-ir-structural-hash.h"
 #include "../core/slang-performance-profiler.h"
 #include "slang-ir-util.h"
 
@@ -25,7 +27,10 @@ namespace Slang
             result.cfgOptions = CFGSimplificationOptions::getDefault();
         result.peepholeOptions = PeepholeOptimizationOptions();
         if (targetProgram)
+        {
             result.deadCodeElimOptions.keepGlobalParamsAlive = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
+            result.skipConvergedFuncs = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::IncrementalSimplification);
+        }
         result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
         return result;
     }
@@ -37,11 +42,57 @@ namespace Slang
         result.cfgOptions = CFGSimplificationOptions::getFast();
         result.peepholeOptions = PeepholeOptimizationOptions();
         if (targetProgram)
+        {
             result.deadCodeElimOptions.keepGlobalParamsAlive = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
+            result.skipConvergedFuncs = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::IncrementalSimplification);
+        }
         result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
         return result;
     }
 
+    namespace
+    {
+        // The state of a function recorded when it reached a fixed point in simplifyIR
+        struct ConvergedFunc
+        {
+            List<IRStructuralHashDependency> dependencies;
+                /// The epochs of each entry in `dependencies` when the function converged
+            List<IRModule::ModificationEpochs> dependencyEpochs;
+        };
+    }
+
+    static void _recordConvergedFunc(
+        IRModule* module,
+        IRStructuralHashContext& hashContext,
+        IRGlobalValueWithCode* func,
+        ConvergedFunc& outConverged)
+    {
+        outConverged.dependencies.clear();
+        outConverged.dependencyEpochs.clear();
+        hashContext.collectFuncDependencies(func, outConverged.dependencies);
+        for (const auto& dependency : outConverged.dependencies)
+            outConverged.dependencyEpochs.add(module->getModificationEpochs(dependency.globalInst));
+    }
+
+    // Returns true if nothing the converged function depends on has changed since it was recorded.
+    //
+    // Every change the IR can make to an instruction bumps the epochs of the global instruction
+    // it is nested in, so comparing them is exact, and doesn't need to look at the function.
+    static bool _isConvergedFuncUnchanged(IRModule* module, const ConvergedFunc& converged)
+    {
+        for (Index i = 0; i < converged.dependencies.getCount(); ++i)
+        {
+            const auto& dependency = converged.dependencies[i];
+            const auto& recordedEpochs = converged.dependencyEpochs[i];
+            const auto epochs = module->getModificationEpochs(dependency.globalInst);
+            if (epochs.epoch != recordedEpochs.epoch)
+                return false;
+            if (dependency.includesBody && epochs.bodyEpoch != recordedEpochs.bodyEpoch)
+                return false;
+        }
+        return true;
+    }
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
     void simplifyIR(TargetProgram* target, IRModule* module, IRSimplificationOptions options, DiagnosticSink* sink)
@@ -52,6 +103,19 @@ namespace Slang
         const int kMaxFuncIterations = 16;
         int iterationCounter = 0;
 
+        // The per-function passes below only observe the body of the function being
+        // simplified and the global instructions it references. A function whose inner
+        // loop reached a fixed point will therefore stay at that fixed point until its
+        // body or something it references changes. We record the global instructions
+        // each converged function depends on (the same ones its structural hash covers),
+        // along with their modification epochs, and skip the function while none of
+        // them has been modified.
+        //
+        Dictionary<IRGlobalValueWithCode*, ConvergedFunc> convergedFuncs;
+        const bool wasModificationTrackingEnabled = module->isModificationTrackingEnabled();
+        if (options.skipConvergedFuncs)
+            module->setModificationTrackingEnabled(true);
+
         while (changed && iterationCounter < kMaxIterations)
         {
             if (sink && sink->getErrorCount())
@@ -59,44 +123,68 @@ namespace Slang
 
             changed = false;
 
-            changed |= deduplicateGenericChildren(module);
-            changed |= propagateFuncProperties(module);
-            changed |= removeUnusedGenericParam(module);
-            changed |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
-            changed |= peepholeOptimizeGlobalScope(target, module);
+            bool globalChanged = false;
+            globalChanged |= deduplicateGenericChildren(module);
+            globalChanged |= propagateFuncProperties(module);
+            globalChanged |= removeUnusedGenericParam(module);
+            globalChanged |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
+            globalChanged |= peepholeOptimizeGlobalScope(target, module);
+            changed |= globalChanged;
+
+            // Collects the global instructions each converged function depends on.
+            IRStructuralHashContext hashContext;
 
             for (auto inst : module->getGlobalInsts())
             {
                 auto func = as<IRGlobalValueWithCode>(inst);
                 if (!func)
                     continue;
+                if (options.skipConvergedFuncs)
+                {
+                    auto converged = convergedFuncs.tryGetValue(func);
+                    if (converged && _isConvergedFuncUnchanged(module, *converged))
+                        continue;
+                }
                 bool funcChanged = true;
                 int funcIterationCount = 0;
+                // The instructions changed since peephole optimization last ran on the function.
+                IRChangedInsts changedInsts;
                 while (funcChanged && funcIterationCount < kMaxFuncIterations)
                 {
                     funcChanged = false;
-                    funcChanged |= applySparseConditionalConstantPropagation(func, sink);
-                    funcChanged |= peepholeOptimize(target, func);
+                    funcChanged |= applySparseConditionalConstantPropagation(func, sink, &changedInsts);
+                    funcChanged |= peepholeOptimize(target, func, &changedInsts);
                     if (options.removeRedundancy)
-                        funcChanged |= removeRedundancyInFunc(func);
-                    funcChanged |= simplifyCFG(func, options.cfgOptions);
+                        funcChanged |= removeRedundancyInFunc(func, &changedInsts);
+                    if (simplifyCFG(func, options.cfgOptions))
+                    {
+                        changedInsts.markEverythingChanged();
+                        funcChanged = true;
+                    }
                     // Note: we disregard the `changed` state from dead code elimination pass since
                     // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
                     // DCE will always remove those nearly generated consts and always returns true here.
                     eliminateDeadCode(func, options.deadCodeElimOptions);
-                    if (funcIterationCount == 0)
-                        funcChanged |= constructSSA(func);
+                    if (funcIterationCount == 0 && constructSSA(func))
+                    {
+                        changedInsts.markEverythingChanged();
+                        funcChanged = true;
+                    }
                     changed |= funcChanged;
                     funcIterationCount++;
                 }
+                if (options.skipConvergedFuncs && !funcChanged)
+                    _recordConvergedFunc(module, hashContext, func, convergedFuncs[func]);
             }
             iterationCounter++;
         }
+        module->setModificationTrackingEnabled(wasModificationTrackingEnabled);
         eliminateDeadCode(module, options.deadCodeElimOptions);
     }
 
     void simplifyNonSSAIR(TargetProgram* target, IRModule* module, IRSimplificationOptions options)
     {
+        SLANG_PROFILE;
         bool changed = true;
         const int kMaxIterations = 8;
         int iterationCounter = 0;
@@ -124,24 +212,34 @@ namespace Slang
         bool changed = true;
         const int kMaxIterations = 8;
         int iterationCounter = 0;
+        // The instructions changed since peephole optimization last ran on the function.
+        IRChangedInsts changedInsts;
         while (changed && iterationCounter < kMaxIterations)
         {
             if (sink && sink->getErrorCount())
                 break;
 
             changed = false;
-            changed |= applySparseConditionalConstantPropagation(func, sink);
-            changed |= peepholeOptimize(target, func);
+            changed |= applySparseConditionalConstantPropagation(func, sink, &changedInsts);
+            changed |= peepholeOptimize(target, func, &changedInsts);
             if (!options.minimalOptimization)
-                changed |= removeRedundancyInFunc(func);
-            changed |= simplifyCFG(func, options.cfgOptions);
+                changed |= removeRedundancyInFunc(func, &changedInsts);
+            if (simplifyCFG(func, options.cfgOptions))
+            {
+                changedInsts.markEverythingChanged();
+                changed = true;
+            }
 
             // Note: we disregard the `changed` state from dead code elimination pass since
             // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
             // DCE will always remove those nearly generated consts and always returns true here.
             eliminateDeadCode(func, options.deadCodeElimOptions);
 
-            changed |= constructSSA(func);
+            if (constructSSA(func))
+            {
+                changedInsts.markEverythingChanged();
+                changed = true;
+            }
 
             iterationCounter++;
 
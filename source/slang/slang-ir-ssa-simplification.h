@@ -21,6 +21,12 @@ namespace Slang
         bool minimalOptimization = false;
         bool removeRedundancy = false;
 
+        // When set, `simplifyIR` will not revisit functions that already reached a fixed
+        // point in a previous iteration, unless the function, or a global instruction it
+        // depends on, has been modified since. Modifications are tracked with the epochs of
+        // `IRModule::getModificationEpochs`.
+        bool skipConvergedFuncs = false;
+
         static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
         static IRSimplificationOptions getFast(TargetProgram* targetProgram);
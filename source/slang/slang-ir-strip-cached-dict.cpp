@@ -1,12 +1,14 @@
 // slang-ir-strip-cached-dict.cpp
 #include "slang-ir-strip-cached-dict.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
 
 void stripCachedDictionaries(IRModule* module)
 {
+    SLANG_PROFILE;
     List<IRInst*> toRemove;
     for (auto inst : module->getGlobalInsts())
     {
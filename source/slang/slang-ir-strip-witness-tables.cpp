@@ -1,5 +1,6 @@
 // slang-ir-strip-witness-tables.cpp
 #include "slang-ir-strip-witness-tables.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -9,6 +10,7 @@ namespace Slang
 
 void stripWitnessTables(IRModule* module)
 {
+    SLANG_PROFILE;
     // Our goal here is to empty out any witness tables in
     // the IR so that they don't keep other symbols alive
     // further into compilation. Luckily we expect all
@@ -35,6 +37,7 @@ void stripWitnessTables(IRModule* module)
 
 void unpinWitnessTables(IRModule* module)
 {
+    SLANG_PROFILE;
     for (auto inst : module->getGlobalInsts())
     {
         auto witnessTable = as<IRWitnessTable>(inst);
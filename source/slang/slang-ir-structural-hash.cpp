@@ -0,0 +1,239 @@
+// slang-ir-structural-hash.cpp
+#include "slang-ir-structural-hash.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+    // Tags mixed into the hash to distinguish how an operand was referenced
+    enum class StructuralHashTag : uint32_t
+    {
+        Null,
+        Local,
+        Global,
+    };
+
+    void IRStructuralHashContext::_addLocalInsts(IRInst* inst)
+    {
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            m_localIndices.add(child, m_localInsts.getCount());
+            m_localInsts.add(child);
+            _addLocalInsts(child);
+        }
+    }
+
+    void IRStructuralHashContext::_hashOperand(Hasher& hasher, IRInst* operand)
+    {
+        if (!operand)
+        {
+            hasher.hashValue(StructuralHashTag::Null);
+        }
+        else if (auto localIndex = m_localIndices.tryGetValue(operand))
+        {
+            hasher.hashValue(StructuralHashTag::Local);
+            hasher.hashValue(*localIndex);
+        }
+        else
+        {
+            hasher.hashValue(StructuralHashTag::Global);
+            hasher.addHash(getGlobalHash(operand));
+        }
+    }
+
+    HashCode64 IRStructuralHashContext::getFuncHash(IRGlobalValueWithCode* func)
+    {
+        // Number all of the instructions in the function first, as operands
+        // can reference instructions (such as blocks) that appear later.
+        m_localInsts.clear();
+        m_localIndices.clear();
+        _addLocalInsts(func);
+
+        Hasher hasher;
+        hasher.addHash(getGlobalHash(func));
+
+        for (auto inst : m_localInsts)
+        {
+            hasher.hashValue(inst->getOp());
+            hasher.hashValue(inst->getOperandCount());
+            // The parent determines the structure (which block an instruction is in),
+            // and it is either the function or a local instruction.
+            _hashOperand(hasher, inst->getParent() == func ? nullptr : inst->getParent());
+            _hashOperand(hasher, inst->getFullType());
+            for (UInt i = 0; i < inst->getOperandCount(); ++i)
+            {
+                _hashOperand(hasher, inst->getOperand(i));
+            }
+        }
+
+        m_localInsts.clear();
+        m_localIndices.clear();
+        return hasher.getResult();
+    }
+
+    void IRStructuralHashContext::collectFuncDependencies(IRGlobalValueWithCode* func, List<IRStructuralHashDependency>& outDependencies)
+    {
+        m_localInsts.clear();
+        m_localIndices.clear();
+        _addLocalInsts(func);
+
+        // Walk the global instructions reachable from the function the same way
+        // _calcGlobalHash does, noting the child of the module each one is nested in.
+        HashSet<IRInst*> visitedInsts;
+        Dictionary<IRInst*, Index> dependencyIndices;
+        List<IRInst*> workList;
+
+        auto addToWorkList = [&](IRInst* inst)
+        {
+            if (inst && !m_localIndices.containsKey(inst) && visitedInsts.add(inst))
+                workList.add(inst);
+        };
+
+        addToWorkList(func);
+        for (auto inst : m_localInsts)
+        {
+            addToWorkList(inst->getFullType());
+            for (UInt i = 0; i < inst->getOperandCount(); ++i)
+            {
+                addToWorkList(inst->getOperand(i));
+            }
+        }
+
+        for (Index i = 0; i < workList.getCount(); ++i)
+        {
+            IRInst* inst = workList[i];
+
+            IRInst* globalInst = inst;
+            bool isInBody = (inst == func);
+            while (globalInst->getParent() && !as<IRModuleInst>(globalInst->getParent()))
+            {
+                isInBody |= as<IRBlock>(globalInst) != nullptr;
+                globalInst = globalInst->getParent();
+            }
+            // Instructions that are not in a module cannot be modified through it
+            if (globalInst->getParent())
+            {
+                if (auto dependencyIndex = dependencyIndices.tryGetValue(globalInst))
+                {
+                    outDependencies[*dependencyIndex].includesBody |= isInBody;
+                }
+                else
+                {
+                    dependencyIndices.add(globalInst, outDependencies.getCount());
+                    IRStructuralHashDependency dependency;
+                    dependency.globalInst = globalInst;
+                    dependency.includesBody = isInBody;
+                    outDependencies.add(dependency);
+                }
+            }
+
+            addToWorkList(inst->getFullType());
+            for (UInt j = 0; j < inst->getOperandCount(); ++j)
+            {
+                addToWorkList(inst->getOperand(j));
+            }
+            if (as<IRGlobalValueWithCode>(inst))
+            {
+                for (auto decoration : inst->getDecorations())
+                {
+                    addToWorkList(decoration);
+                }
+            }
+            else
+            {
+                for (auto child : inst->getDecorationsAndChildren())
+                {
+                    addToWorkList(child);
+                }
+            }
+        }
+
+        m_localInsts.clear();
+        m_localIndices.clear();
+    }
+
+    HashCode64 IRStructuralHashContext::getGlobalHash(IRInst* inst)
+    {
+        if (!inst)
+        {
+            return 0;
+        }
+        if (auto hash = m_globalHashes.tryGetValue(inst))
+        {
+            return *hash;
+        }
+
+        // Global instructions can reference each other recursively (for example a witness table
+        // and a function that uses it). Set a provisional hash so that such references terminate.
+        m_globalHashes.add(inst, Slang::getHashCode(inst->getOp()));
+
+        const HashCode64 hash = _calcGlobalHash(inst);
+        m_globalHashes.set(inst, hash);
+        return hash;
+    }
+
+    HashCode64 IRStructuralHashContext::_calcGlobalHash(IRInst* inst)
+    {
+        Hasher hasher;
+        hasher.hashValue(inst->getOp());
+        hasher.addHash(getGlobalHash(inst->getFullType()));
+
+        if (auto constant = as<IRConstant>(inst))
+        {
+            switch (constant->getOp())
+            {
+            case kIROp_BoolLit:
+            case kIROp_FloatLit:
+            case kIROp_IntLit:
+                hasher.hashValue(constant->value.intVal);
+                break;
+            case kIROp_PtrLit:
+                hasher.hashValue(reinterpret_cast<uintptr_t>(constant->value.ptrVal));
+                break;
+            case kIROp_BlobLit:
+            case kIROp_StringLit:
+                {
+                    const UnownedStringSlice slice = constant->getStringSlice();
+                    hasher.addHash(Slang::getHashCode(slice.begin(), slice.getLength()));
+                    break;
+                }
+            default:
+                break;
+            }
+            return hasher.getResult();
+        }
+
+        // A symbol with linkage is identified by its mangled name
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            const auto name = linkage->getMangledName();
+            hasher.addHash(Slang::getHashCode(name.begin(), name.getLength()));
+        }
+
+        hasher.hashValue(inst->getOperandCount());
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            hasher.addHash(getGlobalHash(inst->getOperand(i)));
+        }
+
+        if (as<IRGlobalValueWithCode>(inst))
+        {
+            // Code is not included, only the decorations that describe it
+            for (auto decoration : inst->getDecorations())
+            {
+                hasher.addHash(getGlobalHash(decoration));
+            }
+        }
+        else
+        {
+            // Includes decorations, struct fields, witness table entries and so on
+            for (auto child : inst->getDecorationsAndChildren())
+            {
+                hasher.addHash(getGlobalHash(child));
+            }
+        }
+
+        return hasher.getResult();
+    }
+}
@@ -0,0 +1,59 @@
+// slang-ir-structural-hash.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRInst;
+    struct IRGlobalValueWithCode;
+
+        /// A child of the module instruction that the structural hash of a function depends on
+    struct IRStructuralHashDependency
+    {
+        IRInst* globalInst = nullptr;
+            /// True if the hash depends on instructions in the blocks of the code of `globalInst`,
+            /// such as when it is the function being hashed.
+        bool includesBody = false;
+    };
+
+        /// Computes hashes of IR that depend only on its structure, and not on the
+        /// addresses instructions happen to be allocated at. The same IR produced by
+        /// two compilations will produce the same hash.
+        ///
+        /// The hash of a function covers its body, along with the parts of any global
+        /// instruction it references that can influence how the body is optimized
+        /// (types, constants, decorations and the entries of global containers like
+        /// witness tables). The bodies of referenced functions are not included.
+        ///
+        /// Hashes of global instructions are memoized, so a context should only be used
+        /// while the global scope of the module it is used on is unchanged.
+    struct IRStructuralHashContext
+    {
+            /// Get the hash of `func` and everything it references.
+        HashCode64 getFuncHash(IRGlobalValueWithCode* func);
+
+            /// Get the hash of a global instruction, as seen from a function that references it.
+        HashCode64 getGlobalHash(IRInst* inst);
+
+            /// Add the children of the module instruction that the hash of `func` depends on to
+            /// `outDependencies`. That is `func` itself, along with the global instructions that
+            /// contain anything `func` references, directly or through other global instructions.
+            ///
+            /// Together with IRModule::getModificationEpochs, this gives an exact way to tell that
+            /// nothing covered by the hash of `func` has changed.
+        void collectFuncDependencies(IRGlobalValueWithCode* func, List<IRStructuralHashDependency>& outDependencies);
+
+    protected:
+        void _addLocalInsts(IRInst* inst);
+        void _hashOperand(Hasher& hasher, IRInst* operand);
+        HashCode64 _calcGlobalHash(IRInst* inst);
+
+        Dictionary<IRInst*, HashCode64> m_globalHashes;
+
+            /// Instructions local to the function being hashed, in the order they are hashed
+        List<IRInst*> m_localInsts;
+            /// Maps a local instruction to its index in m_localInsts
+        Dictionary<IRInst*, Index> m_localIndices;
+    };
+}
@@ -1,5 +1,6 @@
 // slang-ir-synthesize-active-mask.cpp
 #include "slang-ir-synthesize-active-mask.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
@@ -2068,6 +2069,7 @@ void synthesizeActiveMask(
     IRModule*       module,
     DiagnosticSink* sink)
 {
+    SLANG_PROFILE;
     SynthesizeActiveMaskForModuleContext context;
     context.m_module = module;
     context.m_sink = sink;
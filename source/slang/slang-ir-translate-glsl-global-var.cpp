@@ -1,4 +1,5 @@
 #include "slang-ir-translate-glsl-global-var.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -305,6 +306,7 @@ namespace Slang
 
     void translateGLSLGlobalVar(CodeGenContext* context, IRModule* module)
     {
+        SLANG_PROFILE;
         GlobalVarTranslationContext ctx;
         ctx.context = context;
         ctx.processModule(module);
@@ -1,4 +1,5 @@
 #include "slang-ir-uniformity.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -474,6 +475,7 @@ namespace Slang
 
     void validateUniformity(IRModule* module, DiagnosticSink* sink)
     {
+        SLANG_PROFILE;
         ValidateUniformityContext context;
         context.module = module;
         context.sink = sink;
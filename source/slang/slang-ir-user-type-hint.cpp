@@ -1,4 +1,5 @@
 #include "slang-ir-user-type-hint.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -9,6 +10,7 @@ namespace Slang
 
 void addUserTypeHintDecorations(IRModule* module)
 {
+    SLANG_PROFILE;
     for (auto globalInst : module->getGlobalInsts())
     {
         auto inst = as<IRGlobalParam>(globalInst);
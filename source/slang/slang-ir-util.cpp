@@ -989,7 +989,7 @@ bool areCallArgumentsSideEffectFree(IRCall* call, SideEffectAnalysisOptions opti
 
         if (arg->getOp() == kIROp_Var && getParentFunc(arg) == parentFunc)
         {
-            IRDominatorTree* dom = nullptr;
+            RefPtr<IRDominatorTree> dom;
             if (isBitSet(options, SideEffectAnalysisOptions::UseDominanceTree))
                 dom = module->findOrCreateDominatorTree(parentFunc);
 
@@ -1356,7 +1356,7 @@ void resetScratchDataBit(IRInst* inst, int bitIndex)
     {
         auto item = workList.getLast();
         workList.removeLast();
-        item->scratchData &= ~(1ULL << bitIndex);
+        item->scratchData &= ~(1u << bitIndex);
         for (auto child = item->getLastDecorationOrChild(); child; child = child->getPrevInst())
             workList.add(child);
     }
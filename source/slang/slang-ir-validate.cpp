@@ -328,6 +328,57 @@ namespace Slang
         }
     }
 
+    // Check that the analyses of `code` that its module has cached, and that are not stale, are
+    // the same as they would be if computed again. If not, `code` was changed in a way that should
+    // have invalidated them.
+    void validateCachedAnalyses(IRValidateContext* context, IRGlobalValueWithCode* code)
+    {
+        auto module = code->getModule();
+        if (!module)
+            return;
+
+        if (auto cachedDomTree = module->findAnalysis<IRDominatorTree>(code))
+        {
+            bool isSame = true;
+            for (auto block : code->getBlocks())
+            {
+                if (cachedDomTree->isUnreachable(block) != context->domTree->isUnreachable(block) ||
+                    cachedDomTree->getImmediateDominator(block) != context->domTree->getImmediateDominator(block))
+                {
+                    isSame = false;
+                    break;
+                }
+            }
+            validate(context, isSame, code, "cached dominator tree is stale");
+        }
+
+        auto cachedPostorder = module->findAnalysis<IRPostorder>(code);
+        auto cachedLoopInfo = module->findAnalysis<IRLoopInfo>(code);
+        if (!cachedPostorder && !cachedLoopInfo)
+            return;
+
+        // Computed directly, rather than through the module, so validation doesn't change what is cached
+        List<IRBlock*> postorder;
+        HashSet<IRBlock*> reachableSet;
+        computePostorder(code, postorder, reachableSet);
+
+        if (cachedPostorder)
+        {
+            validate(context, cachedPostorder->blocks == postorder, code, "cached postorder is stale");
+        }
+
+        if (cachedLoopInfo)
+        {
+            List<IRLoop*> loops;
+            for (auto block : postorder)
+            {
+                if (auto loop = as<IRLoop>(block->getTerminator()))
+                    loops.add(loop);
+            }
+            validate(context, cachedLoopInfo->getLoops() == loops, code, "cached loop info is stale");
+        }
+    }
+
     void validateIRInst(
         IRValidateContext*  context,
         IRInst*             inst)
@@ -340,6 +391,7 @@ namespace Slang
         {
             context->domTree = computeDominatorTree(code);
             validateCodeBody(context, code);
+            validateCachedAnalyses(context, code);
         }
 
         // If `inst` is itself a parent instruction, then we need to recursively
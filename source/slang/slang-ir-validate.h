@@ -26,6 +26,9 @@ namespace Slang
     //   elsewhere in a block.
     //
     // * Confirm that all the parameters of a block come before any "ordinary" instructions.
+    //
+    // * Confirm that the control flow analyses the module has cached for a function, unless
+    //   they are stale, are the same as they would be if computed again.
     void validateIRModule(IRModule* module, DiagnosticSink* sink);
     void validateIRInst(IRInst* inst);
 
@@ -1,6 +1,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-dominators.h"
 #include "slang-ir-variable-scope-correction.h"
@@ -55,7 +56,7 @@ void VariableScopeCorrectionContext::processModule()
 
 void VariableScopeCorrectionContext::_processFunction(IRFunc* funcInst)
 {
-    IRDominatorTree* dominatorTree = m_module->findOrCreateDominatorTree(funcInst);
+    RefPtr<IRDominatorTree> dominatorTree = m_module->findOrCreateDominatorTree(funcInst);
     List<IRInst*> workList;
     Dictionary<IRBlock*, List<IRLoop*>> loopHeaderMap;
 
@@ -250,6 +251,7 @@ bool VariableScopeCorrectionContext::_isStorableType(IRType* type)
 
 void applyVariableScopeCorrection(IRModule* module, TargetRequest* targetReq)
 {
+    SLANG_PROFILE;
     VariableScopeCorrectionContext context(module, targetReq);
 
     context.processModule();
@@ -1,6 +1,7 @@
 #include "slang-ir-vk-invert-y.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -18,6 +19,7 @@ static IRInst* _invertYOfVector(IRBuilder& builder, IRInst* originalVector)
 // Find outputs to SV_Position and invert the y coordinates of it right before the write.
 void invertYOfPositionOutput(IRModule* module)
 {
+    SLANG_PROFILE;
     for (auto globalInst : module->getGlobalInsts())
     {
         if (globalInst->findDecoration<IRGLPositionOutputDecoration>())
@@ -71,6 +73,7 @@ static IRInst* _invertWOfVector(IRBuilder& builder, IRInst* originalVector)
 // Find inputs of SV_Position and rcp the w coordinates of it right after the read.
 void rcpWOfPositionInput(IRModule* module)
 {
+    SLANG_PROFILE;
     for (auto globalInst : module->getGlobalInsts())
     {
         if (globalInst->findDecoration<IRGLPositionInputDecoration>())
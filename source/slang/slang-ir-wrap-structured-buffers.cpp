@@ -1,5 +1,6 @@
 // slang-ir-wrap-structured-buffers.cpp
 #include "slang-ir-wrap-structured-buffers.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
@@ -312,6 +313,7 @@ struct WrapStructuredBuffersContext
 void wrapStructuredBuffersOfMatrices(
     IRModule*                           module)
 {
+    SLANG_PROFILE;
     WrapStructuredBuffersContext context;
     context.m_module = module;
     context.processModule();
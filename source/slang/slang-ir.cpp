@@ -10,6 +10,8 @@
 
 #include "slang-mangle.h"
 
+#include <atomic>
+
 namespace Slang
 {
     struct IRSpecContext;
@@ -174,6 +176,63 @@ namespace Slang
 #endif
     }
 
+    // Mark the cached analyses of `code` as stale if it is a function in a module, because
+    // its control flow graph has changed.
+    static void _invalidateCFGAnalysis(IRInst* code)
+    {
+        if (auto func = as<IRGlobalValueWithCode>(code))
+        {
+            if (auto module = func->getModule())
+                module->invalidateAnalysisForInst(func);
+        }
+    }
+
+    // Called when `inst` is added to or removed from `parent`.
+    static void _invalidateCFGAnalysisForChild(IRInst* inst, IRInst* parent)
+    {
+        if (as<IRBlock>(inst))
+            _invalidateCFGAnalysis(parent);
+        else if (as<IRTerminatorInst>(inst) && as<IRBlock>(parent))
+            _invalidateCFGAnalysis(parent->getParent());
+        else if (auto func = as<IRGlobalValueWithCode>(inst))
+        {
+            // Changes made to a function while it is outside of its module are not tracked.
+            if (auto module = parent->getModule())
+                module->invalidateAnalysisForInst(func);
+        }
+    }
+
+    // Record that `inst` has been modified with the global instruction of its module that it
+    // is nested in, if modification tracking is enabled on that module.
+    static void _noteInstModified(IRInst* inst, bool isBodyModified)
+    {
+        if (!IRModule::isModificationTrackingEnabledOnAnyModule())
+            return;
+
+        IRInst* globalInst = inst;
+        for (IRInst* parent = inst->getParent(); parent; parent = parent->getParent())
+        {
+            if (auto moduleInst = as<IRModuleInst>(parent))
+            {
+                if (auto module = moduleInst->module)
+                    module->_noteGlobalInstModified(globalInst, isBodyModified);
+                return;
+            }
+            isBodyModified |= as<IRBlock>(globalInst) != nullptr;
+            globalInst = parent;
+        }
+    }
+
+    // Called when an operand of `user` changes from `oldValue` to `newValue`.
+    static void _invalidateCFGAnalysisForOperand(IRInst* user, IRInst* oldValue, IRInst* newValue)
+    {
+        if (as<IRTerminatorInst>(user) && (as<IRBlock>(oldValue) || as<IRBlock>(newValue)))
+        {
+            if (auto block = user->getParent())
+                _invalidateCFGAnalysis(block->getParent());
+        }
+    }
+
     void IRUse::init(IRInst* u, IRInst* v)
     {
         clear();
@@ -201,9 +260,17 @@ namespace Slang
         // Normally we should never be modifying the operand of an hoistable inst.
         // They can be modified by `replaceUsesWith`, or to be replaced by a new inst.
         SLANG_ASSERT(!getIROpInfo(user->getOp()).isHoistable() || uv == usedValue);
+        _invalidateCFGAnalysisForOperand(user, usedValue, uv);
+        _noteInstModified(user, false);
         init(user, uv);
     }
 
+    void IRInst::setFullType(IRType* type)
+    {
+        typeUse.init(this, (IRInst*) type);
+        _noteInstModified(this, false);
+    }
+
     void IRUse::clear()
     {
         // This `IRUse` is part of the linked list
@@ -1325,6 +1392,7 @@ namespace Slang
         auto builder = user->getModule()->getDeduplicationContext();
         builder->_removeGlobalNumberingEntry(user);
         use->init(user, newValue);
+        _noteInstModified(user, false);
 
         IRInst* existingVal = nullptr;
         if (builder->getGlobalValueNumberingMap().tryGetValue(IRInstKey{ user }, existingVal))
@@ -1511,6 +1579,8 @@ namespace Slang
         inst->operandCount = uint32_t(operandCount);
         inst->m_op = op;
 
+        _addInstCountForOp(op, 1);
+
         return inst;
     }
 
@@ -2627,6 +2697,9 @@ namespace Slang
             }
         }
 
+        // The key is kept as the instruction, so it is now counted by the module
+        getModule()->_addInstCountForOp(op, 1);
+
         addHoistableInst(this, inst);
 
         return inst;
@@ -4393,6 +4466,30 @@ namespace Slang
         return addDecoration(target, kIROp_IntermediateContextFieldDifferentialTypeDecoration, witness);
     }
 
+    // The number of modules that have modification tracking enabled.
+    static std::atomic<Count> s_modificationTrackingModuleCount = 0;
+
+    IRModule::~IRModule()
+    {
+        setModificationTrackingEnabled(false);
+    }
+
+    void IRModule::setModificationTrackingEnabled(bool enabled)
+    {
+        if (enabled == m_isModificationTrackingEnabled)
+            return;
+        m_isModificationTrackingEnabled = enabled;
+        if (enabled)
+            s_modificationTrackingModuleCount++;
+        else
+            s_modificationTrackingModuleCount--;
+    }
+
+    bool IRModule::isModificationTrackingEnabledOnAnyModule()
+    {
+        return s_modificationTrackingModuleCount.load(std::memory_order_relaxed) != 0;
+    }
+
     RefPtr<IRModule> IRModule::create(Session* session)
     {
         RefPtr<IRModule> module = new IRModule(session);
@@ -4405,18 +4502,89 @@ namespace Slang
         return module;
     }
 
-    IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
+    RefPtr<IRDominatorTree> IRModule::findDominatorTree(IRGlobalValueWithCode* func)
     {
-        IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
-        if (analysis)
-            return analysis->getDominatorTree();
-        else
+        return findAnalysis<IRDominatorTree>(func);
+    }
+
+    RefPtr<IRDominatorTree> IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
+    {
+        return findOrCreateAnalysis<IRDominatorTree>(func);
+    }
+
+    UInt IRModule::getCFGEpoch(IRGlobalValueWithCode* func)
+    {
+        // The epoch is only increased for functions that have an entry, so one has to
+        // be created for the epoch to be meaningful.
+        return m_mapInstToAnalysis[func].cfgEpoch;
+    }
+
+    void IRModule::invalidateAnalysisForInst(IRGlobalValueWithCode* func)
+    {
+        if (auto analysis = m_mapInstToAnalysis.tryGetValue(func))
+            analysis->cfgEpoch++;
+    }
+
+    void IRModule::invalidateAllAnalysis()
+    {
+        for (auto& [_, analysis] : m_mapInstToAnalysis)
+            analysis.cfgEpoch++;
+    }
+
+    RefObject* IRModule::_findAnalysis(IRGlobalValueWithCode* func, Index kind)
+    {
+        auto analysis = m_mapInstToAnalysis.tryGetValue(func);
+        if (!analysis || kind >= analysis->entries.getCount())
+            return nullptr;
+        const auto& entry = analysis->entries[kind];
+        return entry.cfgEpoch == analysis->cfgEpoch ? entry.value.get() : nullptr;
+    }
+
+    void IRModule::_setAnalysis(IRGlobalValueWithCode* func, Index kind, RefObject* value)
+    {
+        auto& analysis = m_mapInstToAnalysis[func];
+        if (kind >= analysis.entries.getCount())
+            analysis.entries.setCount(kind + 1);
+        auto& entry = analysis.entries[kind];
+        entry.value = value;
+        entry.cfgEpoch = analysis.cfgEpoch;
+    }
+
+    IRMangledNameIndex::IRMangledNameIndex(IRModule* module)
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (inst->findDecoration<IRLinkageDecoration>())
+                m_entries.add(Entry{ inst, -1 });
+        }
+
+        // Walk the entries backwards, so that each entry links to the next one with the
+        // same name, and the dictionary ends up holding the first entry for each name.
+        for (Index i = m_entries.getCount() - 1; i >= 0; --i)
+        {
+            Entry& entry = m_entries[i];
+            const UnownedStringSlice mangledName = entry.inst->findDecoration<IRLinkageDecoration>()->getMangledName();
+
+            Index* firstEntry = m_firstEntries.tryGetValue(mangledName);
+            if (firstEntry)
+            {
+                entry.next = *firstEntry;
+                *firstEntry = i;
+            }
+            else
+            {
+                m_firstEntries.add(mangledName, i);
+            }
+        }
+    }
+
+    IRMangledNameIndex* IRModule::getMangledNameIndex()
+    {
+        if (!m_mangledNameIndex)
         {
-            m_mapInstToAnalysis[func] = IRAnalysis();
-            analysis = m_mapInstToAnalysis.tryGetValue(func);
+            m_mangledNameIndex = new IRMangledNameIndex(this);
         }
-        analysis->domTree = computeDominatorTree(func);
-        return analysis->getDominatorTree();
+        return m_mangledNameIndex;
     }
 
     void addGlobalValue(
@@ -7952,6 +8120,8 @@ namespace Slang
                 }
                 
                 // Swap this use over to use the other value.
+                _invalidateCFGAnalysisForOperand(user, thisInst, other);
+                _noteInstModified(user, false);
                 uu->usedValue = other;
 
                 // If `other` is hoistable, then we need to make sure `other` is hoisted
@@ -8077,6 +8247,9 @@ namespace Slang
         this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        _invalidateCFGAnalysisForChild(this, inParent);
+        _noteInstModified(inParent, as<IRBlock>(this) != nullptr);
         
 #if _DEBUG
         validateIRInstOperands(this);
@@ -8164,6 +8337,9 @@ namespace Slang
         prev = nullptr;
         next = nullptr;
         parent = nullptr;
+
+        _invalidateCFGAnalysisForChild(this, oldParent);
+        _noteInstModified(oldParent, as<IRBlock>(this) != nullptr);
     }
 
     void IRInst::removeArguments()
@@ -8184,6 +8360,7 @@ namespace Slang
         }
         getOperands()[operandCount - 1].clear();
         operandCount--;
+        _noteInstModified(this, false);
         return;
     }
 
@@ -8205,7 +8382,8 @@ namespace Slang
             }
             module->getDeduplicationContext()->getInstReplacementMap().remove(this);
             if (auto func = as<IRGlobalValueWithCode>(this))
-                module->invalidateAnalysisForInst(func);
+                module->removeAnalysisForInst(func);
+            module->_addInstCountForOp(getOp(), -1);
         }
         removeArguments();
         removeFromParent();
@@ -8782,11 +8960,6 @@ namespace Slang
         return inst;
     }
 
-    IRDominatorTree* IRAnalysis::getDominatorTree()
-    {
-        return static_cast<IRDominatorTree*>(domTree.get());
-    }
-
     bool isMovableInst(IRInst* inst)
     {
         // Don't try to modify hoistable insts, they are already globally deduplicated.
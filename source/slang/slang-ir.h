@@ -596,6 +596,16 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // Reserved memory space for use by individual IR passes.
+    // This field is not supposed to be valid outside an IR pass,
+    // and each IR pass should always treat it as uninitialized
+    // upon entry.
+    //
+    // Note: this is kept to 32 bits and placed alongside the other
+    // 32 bit fields, so that it occupies what would otherwise be
+    // padding before the pointer fields that follow.
+    uint32_t scratchData = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -717,19 +727,13 @@ struct IRInst
     uint32_t _debugUID;
 #endif
 
-    // Reserved memory space for use by individual IR passes.
-    // This field is not supposed to be valid outside an IR pass,
-    // and each IR pass should always treat it as uninitialized
-    // upon entry.
-    UInt64 scratchData = 0;
-
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
     IRUse typeUse;
 
     IRType* getFullType() { return (IRType*) typeUse.get(); }
-    void setFullType(IRType* type) { typeUse.init(this, (IRInst*) type); }
+    void setFullType(IRType* type);
 
     IRRate* getRate();
 
@@ -2299,10 +2303,51 @@ private:
 
 struct IRDominatorTree;
 
+    /// The analyses of the control flow graph of one function that are cached by its module
 struct IRAnalysis
 {
-    RefPtr<RefObject> domTree;
-    IRDominatorTree* getDominatorTree();
+    struct Entry
+    {
+        RefPtr<RefObject> value;
+            /// The epoch of the control flow graph the value was computed for
+        UInt cfgEpoch = 0;
+    };
+
+        /// Incremented whenever the control flow graph of the function changes
+    UInt cfgEpoch = 0;
+        /// Indexed by IRAnalysisKind. Entries computed for an earlier epoch are stale.
+    List<Entry> entries;
+};
+
+    /// An index from mangled names to the global instructions of a module that have linkage
+    /// with that name.
+    ///
+    /// The index does not track changes to the module it was built from.
+struct IRMangledNameIndex : RefObject
+{
+    struct Entry
+    {
+        IRInst* inst;
+        Index next;         ///< Index of the next entry with the same mangled name, or -1 if there isn't one
+    };
+
+        /// Build an index of the global instructions of `module`.
+    explicit IRMangledNameIndex(IRModule* module);
+
+        /// Get the index of the first entry (in module order) named `mangledName`, or -1 if there isn't one.
+    Index findFirstEntry(const UnownedStringSlice& mangledName) const
+    {
+        const Index* found = m_firstEntries.tryGetValue(mangledName);
+        return found ? *found : -1;
+    }
+    const Entry& getEntry(Index index) const { return m_entries[index]; }
+
+protected:
+        /// Entries in the order of the global instructions in the module
+    List<Entry> m_entries;
+        /// Maps a mangled name to the index of its first entry. The keys reference the
+        /// string literals in the module.
+    Dictionary<UnownedStringSlice, Index> m_firstEntries;
 };
 
 struct IRModule : RefObject
@@ -2315,6 +2360,8 @@ public:
 
     static RefPtr<IRModule> create(Session* session);
 
+    ~IRModule();
+
     SLANG_FORCE_INLINE Session* getSession() const { return m_session; }
     SLANG_FORCE_INLINE IRModuleInst* getModuleInst() const { return m_moduleInst;  }
     SLANG_FORCE_INLINE MemoryArena& getMemoryArena() { return m_memoryArena; }
@@ -2324,19 +2371,126 @@ public:
 
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
-    IRDominatorTree* findDominatorTree(IRGlobalValueWithCode* func)
+        /// Find the analysis `T` of `func` if it is cached and not stale.
+        ///
+        /// An analysis type identifies itself with `T::kAnalysisKind` (see IRAnalysisKind),
+        /// and is computed by `T::compute(func)`.
+        ///
+        /// The analysis is returned as a RefPtr, because a stale analysis is released when it
+        /// is computed again.
+    template<typename T>
+    RefPtr<T> findAnalysis(IRGlobalValueWithCode* func)
     {
-        IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
-        if (analysis)
-            return analysis->getDominatorTree();
-        return nullptr;
+        return static_cast<T*>(_findAnalysis(func, Index(T::kAnalysisKind)));
+    }
+
+        /// Find the analysis `T` of `func`, computing it if it isn't cached or is stale.
+        ///
+        /// A cached analysis stays valid until the control flow graph of `func` changes, or
+        /// it is invalidated.
+    template<typename T>
+    RefPtr<T> findOrCreateAnalysis(IRGlobalValueWithCode* func)
+    {
+        if (auto analysis = findAnalysis<T>(func))
+            return analysis;
+        RefPtr<T> analysis = T::compute(func);
+        _setAnalysis(func, Index(T::kAnalysisKind), analysis);
+        return analysis;
     }
-    IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
-    void invalidateAnalysisForInst(IRGlobalValueWithCode* func) { m_mapInstToAnalysis.remove(func); }
-    void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
+
+    RefPtr<IRDominatorTree> findDominatorTree(IRGlobalValueWithCode* func);
+    RefPtr<IRDominatorTree> findOrCreateDominatorTree(IRGlobalValueWithCode* func);
+
+        /// Get the epoch of the control flow graph of `func`.
+        ///
+        /// The epoch increases whenever the analyses of `func` are invalidated, so passes can
+        /// use it to tell whether a function has to be looked at again.
+    UInt getCFGEpoch(IRGlobalValueWithCode* func);
+
+        /// Mark the analyses of `func` as stale, by increasing the epoch of its control flow graph.
+        ///
+        /// This is done automatically when a block is added to or removed from `func`, or a
+        /// terminator in it is added, removed or has a block operand changed. Passes that make
+        /// other changes to the body of a function invalidate its analyses themselves.
+    void invalidateAnalysisForInst(IRGlobalValueWithCode* func);
+    void invalidateAllAnalysis();
+        /// Discard everything cached for `func`, which is being deallocated.
+    void removeAnalysisForInst(IRGlobalValueWithCode* func) { m_mapInstToAnalysis.remove(func); }
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+        /// Get the number of instructions with opcode `op` that have been created in this
+        /// module and not yet deallocated.
+        ///
+        /// Instructions that were removed from the module without being deallocated are still
+        /// counted, so this is an upper bound, but a count of zero means there are none.
+    UInt getInstCountForOp(IROp op) const
+    {
+        const auto index = UInt(op & kIROpMask_OpMask);
+        return index < UInt(kIROpCount) ? m_instCountForOp[index] : 0;
+    }
+
+        /// Track a change in the number of instructions with opcode `op`. Done by the IR itself
+        /// when instructions are allocated and deallocated.
+    void _addInstCountForOp(IROp op, Int delta)
+    {
+        const auto index = UInt(op & kIROpMask_OpMask);
+        if (index < UInt(kIROpCount))
+            m_instCountForOp[index] += delta;
+    }
+
+        /// The modification epochs of a global instruction, see getModificationEpochs.
+    struct ModificationEpochs
+    {
+            /// Increased when the instruction, or anything nested in it outside of the blocks
+            /// of its code, is modified. Covers the operands, type, decorations and children
+            /// of a global like a struct or witness table, and the decorations of a function.
+        UInt epoch = 0;
+            /// Increased when the blocks of the code of the instruction are modified.
+        UInt bodyEpoch = 0;
+    };
+
+        /// Enable or disable tracking of modifications to the global instructions of this module.
+        ///
+        /// Modifications made while tracking is disabled are not recorded, so the epochs can
+        /// only be compared across a span of time during which tracking stayed enabled.
+    void setModificationTrackingEnabled(bool enabled);
+    bool isModificationTrackingEnabled() const { return m_isModificationTrackingEnabled; }
+
+        /// Whether modification tracking is enabled on any module. Checked by the IR before it
+        /// looks for the module of a modified instruction, so that edits cost nothing extra while
+        /// no module is tracking them.
+    static bool isModificationTrackingEnabledOnAnyModule();
+
+        /// Get the modification epochs of `globalInst`, which must be a child of the module instruction.
+        ///
+        /// An instruction that has not been modified while tracking was enabled has epochs of zero.
+    ModificationEpochs getModificationEpochs(IRInst* globalInst) const
+    {
+        const ModificationEpochs* epochs = m_mapGlobalInstToModificationEpochs.tryGetValue(globalInst);
+        return epochs ? *epochs : ModificationEpochs();
+    }
+
+        /// Record that `globalInst`, a child of the module instruction, was modified. Done by the IR
+        /// itself when operands are set and instructions are inserted or removed.
+    void _noteGlobalInstModified(IRInst* globalInst, bool isBodyModified)
+    {
+        if (!m_isModificationTrackingEnabled)
+            return;
+        auto& epochs = m_mapGlobalInstToModificationEpochs[globalInst];
+        if (isBodyModified)
+            epochs.bodyEpoch++;
+        else
+            epochs.epoch++;
+    }
+
+        /// Get an index of the mangled names of the global instructions in this module.
+        ///
+        /// The index is built on first use, and is not updated if the module changes afterwards.
+        /// It should only be used on modules that are no longer modified, such as the modules of
+        /// the standard library.
+    IRMangledNameIndex* getMangledNameIndex();
+
         /// Create an empty instruction with the `op` opcode and space for
         /// a number of operands given by `operandCount`.
         ///
@@ -2414,8 +2568,20 @@ private:
         /// Holds the obfuscated source map for this module if applicable
     ComPtr<IBoxValue<SourceMap>> m_obfuscatedSourceMap;
 
+    RefObject* _findAnalysis(IRGlobalValueWithCode* func, Index kind);
+    void _setAnalysis(IRGlobalValueWithCode* func, Index kind, RefObject* value);
+
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
+        /// The number of live instructions for each opcode, see getInstCountForOp
+    UInt m_instCountForOp[kIROpCount] = {};
+
+    bool m_isModificationTrackingEnabled = false;
+        /// Global instructions that were modified while tracking was enabled, see getModificationEpochs
+    Dictionary<IRInst*, ModificationEpochs> m_mapGlobalInstToModificationEpochs;
+
+        /// Built on demand by getMangledNameIndex
+    RefPtr<IRMangledNameIndex> m_mangledNameIndex;
 };
 
 
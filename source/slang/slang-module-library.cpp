@@ -44,11 +44,9 @@ SlangResult loadModuleLibrary(const Byte* inBytes, size_t bytesCount, String pat
     auto library = new ModuleLibrary;
     ComPtr<IModuleLibrary> scopeLibrary(library);
 
-    // Load up the module
-    MemoryStreamBase memoryStream(FileAccess::Read, inBytes, bytesCount);
-
+    // Load up the module, referencing the payloads in `inBytes` directly
     RiffContainer riffContainer;
-    SLANG_RETURN_ON_FAIL(RiffUtil::read(&memoryStream, riffContainer));
+    SLANG_RETURN_ON_FAIL(RiffUtil::readBuffer(inBytes, bytesCount, riffContainer));
 
     auto linkage = req->getLinkage();
     {
@@ -339,6 +339,19 @@ void initCommandOptions(CommandOptions& options)
         { OptionKind::InputFilesRemain, "--", nullptr, "Treat the rest of the command line as input files."},
         { OptionKind::ReportDownstreamTime, "-report-downstream-time", nullptr, "Reports the time spent in the downstream compiler." },
         { OptionKind::ReportPerfBenchmark, "-report-perf-benchmark", nullptr, "Reports compiler performance benchmark results." },
+        { OptionKind::ReportPerfTrace, "-report-perf-trace", "-report-perf-trace <file>",
+        "Records each profiled compiler function invocation, and writes them to <file> in the Chrome trace event "
+        "JSON format, as can be viewed with chrome://tracing or Perfetto." },
+        { OptionKind::DownstreamCache, "-downstream-cache", "-downstream-cache <dir>",
+        "Caches the output of downstream compilers in <dir>, keyed by the source, options and compiler version. "
+        "Compilations that pass the same source and options to the same downstream compiler reuse the cached output. "
+        "Hits and misses are reported with -report-downstream-time." },
+        { OptionKind::ReportDownstreamPassTime, "-report-downstream-pass-time", nullptr,
+        "Reports the time taken by each pass of downstream optimizers that support it (currently spirv-opt), and how "
+        "the pass changed the size of the output. Passes are run one at a time, which makes optimization slower overall." },
+        { OptionKind::ParallelSPIRVOptimization, "-parallel-spirv-opt", nullptr,
+        "When generating SPIR-V for several entry points, run spirv-opt for all of them concurrently after code has been "
+        "generated for each of them, rather than for each one in turn." },
         { OptionKind::SkipSPIRVValidation, "-skip-spirv-validation", nullptr, "Skips spirv validation." },
         { OptionKind::SourceEmbedStyle, "-source-embed-style", "-source-embed-style <source-embed-style>",
         "If source embedding is enabled, defines the style used. When enabled (with any style other than `none`), "
@@ -531,6 +544,12 @@ void initCommandOptions(CommandOptions& options)
         { OptionKind::ValidateUniformity, "-validate-uniformity", nullptr, "Perform uniformity validation analysis." },
         { OptionKind::AllowGLSL, "-allow-glsl", nullptr, "Enable GLSL as an input language." },
         { OptionKind::EnableExperimentalPasses, "-enable-experimental-passes", nullptr, "Enable experimental compiler passes" },
+        { OptionKind::IncrementalSimplification, "-incremental-simplification", nullptr,
+        "Only re-run per-function IR simplification on functions that changed in the previous iteration "
+        "of the simplification loop, instead of revisiting every function until the whole module converges." },
+        { OptionKind::SpecializationCache, "-specialization-cache", nullptr,
+        "Reuse generic functions specialized for one entry point when linking the other entry points of the "
+        "same program and target, instead of specializing them again for each entry point." },
     };
     _addOptions(makeConstArrayView(experimentalOpts), options);
 
@@ -1715,12 +1734,16 @@ SlangResult OptionsParser::_parse(
             case OptionKind::ValidateUniformity:
             case OptionKind::AllowGLSL:
             case OptionKind::EnableExperimentalPasses:
+            case OptionKind::IncrementalSimplification:
+            case OptionKind::SpecializationCache:
             case OptionKind::EmitIr:
             case OptionKind::DumpIntermediates:
             case OptionKind::DumpReproOnError:
             case OptionKind::ReportDownstreamTime:
             case OptionKind::ReportPerfBenchmark:
             case OptionKind::SkipSPIRVValidation:
+            case OptionKind::ReportDownstreamPassTime:
+            case OptionKind::ParallelSPIRVOptimization:
             case OptionKind::DisableSpecialization:
             case OptionKind::DisableDynamicDispatch:
             case OptionKind::TrackLiveness:
@@ -1829,6 +1852,20 @@ SlangResult OptionsParser::_parse(
                 linkage->m_optionSet.set(CompilerOptionName::Doc, true);
                 break;
             }
+            case OptionKind::ReportPerfTrace:
+            {
+                CommandLineArg tracePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(tracePath));
+                linkage->m_optionSet.set(optionKind, tracePath.value);
+                break;
+            }
+            case OptionKind::DownstreamCache:
+            {
+                CommandLineArg cacheDirectory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cacheDirectory));
+                linkage->m_optionSet.set(optionKind, cacheDirectory.value);
+                break;
+            }
             case OptionKind::DumpRepro:
             {
                 CommandLineArg dumpRepro;
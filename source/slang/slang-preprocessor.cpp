@@ -942,6 +942,11 @@ struct InputFile
     {
         auto conditional = m_conditional;
         SLANG_ASSERT(conditional);
+        if (conditional == m_includeGuardConditional)
+        {
+            m_includeGuardState = IncludeGuardState::Closed;
+            m_includeGuardConditional = nullptr;
+        }
         m_conditional = conditional->parent;
         delete conditional;
     }
@@ -958,6 +963,57 @@ struct InputFile
 
     bool isIncludedFile() { return m_parent != nullptr; }
 
+        /// Tracks whether the whole file is wrapped in an include guard.
+        ///
+        /// A file is guarded if its first directive is an `#ifndef` (without `#else`
+        /// or `#elif`), and nothing but whitespace and comments appears outside of it.
+        /// Including such a file again while the guard macro is defined produces
+        /// no tokens, so the file can be skipped without being read.
+        ///
+    enum class IncludeGuardState
+    {
+        Initial,        ///< Nothing has been seen outside of a conditional yet
+        Inside,         ///< Inside the `#ifndef` that is the candidate guard
+        Closed,         ///< The candidate guard has been closed by its `#endif`
+        NotGuarded,     ///< The file is not wrapped in an include guard
+    };
+
+        /// Note that a token or directive was read outside of any conditional
+    void noteTopLevelContent()
+    {
+        if (m_includeGuardState != IncludeGuardState::Inside)
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+    }
+
+        /// Note that `conditional` was pushed for an `#ifndef` testing `name`
+    void noteIfNDef(Conditional* conditional, Name* name)
+    {
+        if (m_includeGuardState == IncludeGuardState::Initial && conditional->parent == nullptr)
+        {
+            m_includeGuardState = IncludeGuardState::Inside;
+            m_includeGuardName = name;
+            m_includeGuardConditional = conditional;
+        }
+    }
+
+        /// Note that `conditional` has an `#else` or `#elif` branch
+    void noteElseBranch(Conditional* conditional)
+    {
+        if (conditional == m_includeGuardConditional)
+        {
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+            m_includeGuardConditional = nullptr;
+        }
+    }
+
+        /// Get the name of the macro guarding the whole file, or nullptr if the file is not guarded
+    Name* getIncludeGuardName()
+    {
+        return m_includeGuardState == IncludeGuardState::Closed ? m_includeGuardName : nullptr;
+    }
+
+    SourceFile* getSourceFile() { return m_sourceFile; }
+
 private:
     friend struct Preprocessor;
 
@@ -979,6 +1035,15 @@ private:
 
         /// An input stream that applies macro expansion to `m_lexerStream`
     ExpansionInputStream* m_expansionStream;
+
+        /// The source file being read
+    SourceFile* m_sourceFile = nullptr;
+
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Initial;
+        /// The macro tested by the candidate include guard
+    Name* m_includeGuardName = nullptr;
+        /// The conditional for the candidate include guard, while it is `Inside`
+    Conditional* m_includeGuardConditional = nullptr;
 };
 
     /// State of the preprocessor
@@ -1012,6 +1077,10 @@ struct Preprocessor
         /// stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
+        /// Maps the unique identities of files that are wholly wrapped in an include guard
+        /// to the name of the guard macro.
+    Dictionary<String, Name*>               includeGuardNames;
+
         /// Name pool to use when creating `Name`s from strings
     NamePool*                               namePool = nullptr;
 
@@ -1118,6 +1187,7 @@ InputFile::InputFile(
     SourceView*     sourceView)
 {
     m_preprocessor = preprocessor;
+    m_sourceFile = sourceView->getSourceFile();
 
     m_lexerStream = new LexerInputStream(preprocessor, sourceView);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
@@ -2852,6 +2922,9 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    InputFile* inputFile = getInputFile(context);
+    inputFile->noteIfNDef(inputFile->getInnerMostConditional(), name);
 }
 
 // Handle a `#else` directive
@@ -2868,6 +2941,10 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // A file with an `#else` or `#elif` for its outer-most `#ifndef` can produce tokens
+    // when the macro is defined, so it isn't wrapped in an include guard.
+    inputFile->noteElseBranch(conditional);
+
     // if we've already seen a `#else`, then it is an error
     if (conditional->elseToken.type != TokenType::Unknown)
     {
@@ -2923,6 +3000,10 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // A file with an `#else` or `#elif` for its outer-most `#ifndef` can produce tokens
+    // when the macro is defined, so it isn't wrapped in an include guard.
+    inputFile->noteElseBranch(conditional);
+
     // if we've already seen a `#else`, then it is an error
     if (conditional->elseToken.type != TokenType::Unknown)
     {
@@ -3097,6 +3178,14 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether the file is wrapped in an include guard whose macro is defined. If it
+    // is, including it would produce no tokens, so we don't need to read it again.
+    if (auto guardName = context->m_preprocessor->includeGuardNames.tryGetValue(filePathInfo.uniqueIdentity))
+    {
+        if (LookupMacro(context, *guardName))
+            return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3876,6 +3965,18 @@ void Preprocessor::popInputFile()
         GetSink(this)->diagnose(conditional->ifToken, Diagnostics::seeDirective, conditional->ifToken.getContent());
     }
 
+    // Remember if the file is wrapped in an include guard, so that including it
+    // again while the guard macro is defined can skip the file entirely.
+    //
+    if (auto guardName = inputFile->getIncludeGuardName())
+    {
+        const PathInfo& pathInfo = inputFile->getSourceFile()->getPathInfo();
+        if (pathInfo.hasUniqueIdentity())
+        {
+            includeGuardNames.set(pathInfo.uniqueIdentity, guardName);
+        }
+    }
+
     // We will update the current file to the parent of whatever
     // the `inputFile` was (usually the file that `#include`d it).
     //
@@ -3927,8 +4028,13 @@ static Token ReadToken(Preprocessor* preprocessor)
             directiveContext.m_haveDoneEndOfDirectiveChecks = false;
             directiveContext.m_inputFile = inputFile;
 
+            const bool isTopLevel = inputFile->getInnerMostConditional() == nullptr;
+
             // Parse and handle the directive
             HandleDirective(&directiveContext);
+
+            if (isTopLevel)
+                inputFile->noteTopLevelContent();
             continue;
         }
 
@@ -3946,6 +4052,9 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        if (!inputFile->getInnerMostConditional())
+            inputFile->noteTopLevelContent();
+
         expansionStream->readToken();
         return token;
     }
@@ -9,6 +9,7 @@
 #include "slang-type-layout.h"
 #include "slang-syntax.h"
 #include "slang-check.h"
+#include "slang-reflection-flat.h"
 #include <assert.h>
 
 // Don't signal errors for stuff we don't implement here,
@@ -3568,6 +3569,11 @@ SLANG_API SlangReflectionVariableLayout* spReflection_getGlobalParamsVarLayout(S
     return convert(program->parametersLayout);
 }
 
+SLANG_API SlangResult spReflection_writeFlatBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+{
+    return writeFlatReflection((slang::ProgramLayout*)reflection, outBlob);
+}
+
 SLANG_API unsigned int spReflection_GetTypeParameterCount(SlangReflection * reflection)
 {
     auto program = convert(reflection);
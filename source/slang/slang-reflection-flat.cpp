@@ -0,0 +1,306 @@
+// slang-reflection-flat.cpp
+#include "slang-reflection-flat.h"
+
+#include "../core/slang-blob.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+struct FlatReflectionWriter
+{
+    static const uint32_t kInvalid = SLANG_FLAT_REFLECTION_INVALID_INDEX;
+
+    uint32_t addString(const char* text)
+    {
+        if (!text)
+        {
+            return kInvalid;
+        }
+
+        // Reflection strings live as long as the program layout, so they can be used as keys
+        // without copying them.
+        const UnownedStringSlice slice(text);
+        if (auto found = m_stringOffsets.tryGetValue(slice))
+        {
+            return *found;
+        }
+
+        const uint32_t offset = uint32_t(m_strings.getCount());
+        m_strings.addRange(slice.begin(), slice.getLength());
+        m_strings.add(0);
+        m_stringOffsets.add(slice, offset);
+        return offset;
+    }
+
+    uint32_t addTypeLayout(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+        {
+            return kInvalid;
+        }
+        if (auto found = m_typeLayoutIndices.tryGetValue(typeLayout))
+        {
+            return *found;
+        }
+
+        // The entry is added before it is written, so that a type that refers to itself
+        // (through a pointer) refers to this entry.
+        const uint32_t index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayouts.add(SlangFlatReflectionTypeLayout{});
+        m_typeLayoutIndices.add(typeLayout, index);
+
+        SlangFlatReflectionTypeLayout entry = {};
+
+        const auto kind = typeLayout->getKind();
+        entry.kind = uint32_t(kind);
+        entry.name = addString(typeLayout->getName());
+        entry.scalarType = uint32_t(typeLayout->getScalarType());
+        entry.rowCount = typeLayout->getRowCount();
+        entry.columnCount = typeLayout->getColumnCount();
+        entry.resourceShape = uint32_t(typeLayout->getResourceShape());
+        entry.resourceAccess = uint32_t(typeLayout->getResourceAccess());
+        entry.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+        entry.elementCount = (kind == slang::TypeReflection::Kind::Array) ? typeLayout->getElementCount() : 0;
+        entry.uniformStride = typeLayout->getStride();
+        entry.uniformAlignment = typeLayout->getAlignment();
+
+        entry.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+        entry.elementVarLayout = addVarLayout(typeLayout->getElementVarLayout());
+        entry.containerVarLayout = addVarLayout(typeLayout->getContainerVarLayout());
+
+        const unsigned fieldCount = typeLayout->getFieldCount();
+        entry.firstField = reserveVarLayouts(fieldCount);
+        entry.fieldCount = fieldCount;
+        for (unsigned i = 0; i < fieldCount; ++i)
+        {
+            writeVarLayout(entry.firstField + i, typeLayout->getFieldByIndex(i));
+        }
+
+        const unsigned categoryCount = typeLayout->getCategoryCount();
+        entry.firstSize = uint32_t(m_sizes.getCount());
+        entry.sizeCount = categoryCount;
+        for (unsigned i = 0; i < categoryCount; ++i)
+        {
+            const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+            SlangFlatReflectionSize size = {};
+            size.category = uint32_t(category);
+            size.size = typeLayout->getSize(category);
+            m_sizes.add(size);
+        }
+
+        // The leaf type layouts can add binding ranges of their own, so the ranges for this
+        // type are reserved up front to keep them together.
+        const SlangInt bindingRangeCount = typeLayout->getBindingRangeCount();
+        entry.firstBindingRange = uint32_t(m_bindingRanges.getCount());
+        entry.bindingRangeCount = uint32_t(bindingRangeCount);
+        m_bindingRanges.setCount(m_bindingRanges.getCount() + bindingRangeCount);
+        for (SlangInt i = 0; i < bindingRangeCount; ++i)
+        {
+            SlangFlatReflectionBindingRange bindingRange = {};
+            bindingRange.bindingCount = typeLayout->getBindingRangeBindingCount(i);
+            bindingRange.bindingType = uint32_t(typeLayout->getBindingRangeType(i));
+            bindingRange.leafTypeLayout = addTypeLayout(typeLayout->getBindingRangeLeafTypeLayout(i));
+            auto leafVariable = typeLayout->getBindingRangeLeafVariable(i);
+            bindingRange.leafVariableName = leafVariable ? addString(leafVariable->getName()) : kInvalid;
+            bindingRange.descriptorSetIndex = int32_t(typeLayout->getBindingRangeDescriptorSetIndex(i));
+            m_bindingRanges[entry.firstBindingRange + i] = bindingRange;
+        }
+
+        m_typeLayouts[index] = entry;
+        return index;
+    }
+
+        /// Reserve `count` consecutive var layout entries, returning the index of the first
+    uint32_t reserveVarLayouts(Index count)
+    {
+        const uint32_t first = uint32_t(m_varLayouts.getCount());
+        m_varLayouts.setCount(m_varLayouts.getCount() + count);
+        return first;
+    }
+
+    uint32_t addVarLayout(slang::VariableLayoutReflection* varLayout)
+    {
+        if (!varLayout)
+        {
+            return kInvalid;
+        }
+        const uint32_t index = reserveVarLayouts(1);
+        writeVarLayout(index, varLayout);
+        return index;
+    }
+
+    void writeVarLayout(uint32_t index, slang::VariableLayoutReflection* varLayout)
+    {
+        SlangFlatReflectionVarLayout entry = {};
+        if (varLayout)
+        {
+            auto variable = varLayout->getVariable();
+            entry.name = variable ? addString(variable->getName()) : kInvalid;
+            entry.stage = uint32_t(varLayout->getStage());
+            entry.semanticName = addString(varLayout->getSemanticName());
+            entry.semanticIndex = uint32_t(varLayout->getSemanticIndex());
+
+            auto typeLayout = varLayout->getTypeLayout();
+            entry.typeLayout = addTypeLayout(typeLayout);
+
+            const unsigned categoryCount = typeLayout ? typeLayout->getCategoryCount() : 0;
+            entry.firstOffset = uint32_t(m_offsets.getCount());
+            entry.offsetCount = categoryCount;
+            for (unsigned i = 0; i < categoryCount; ++i)
+            {
+                const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+                SlangFlatReflectionOffset offset = {};
+                offset.category = uint32_t(category);
+                offset.space = uint32_t(varLayout->getBindingSpace(category));
+                offset.offset = varLayout->getOffset(category);
+                m_offsets.add(offset);
+            }
+        }
+        else
+        {
+            entry.name = kInvalid;
+            entry.typeLayout = kInvalid;
+            entry.semanticName = kInvalid;
+        }
+        m_varLayouts[index] = entry;
+    }
+
+    void addEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        SlangFlatReflectionEntryPoint entry = {};
+        entry.name = addString(entryPoint->getName());
+        entry.nameOverride = addString(entryPoint->getNameOverride());
+        entry.stage = uint32_t(entryPoint->getStage());
+        entry.varLayout = addVarLayout(entryPoint->getVarLayout());
+        entry.resultVarLayout = addVarLayout(entryPoint->getResultVarLayout());
+
+        const unsigned parameterCount = entryPoint->getParameterCount();
+        entry.firstParameter = reserveVarLayouts(parameterCount);
+        entry.parameterCount = parameterCount;
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            writeVarLayout(entry.firstParameter + i, entryPoint->getParameterByIndex(i));
+        }
+
+        SlangUInt threadGroupSize[3] = { 1, 1, 1 };
+        entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+        for (Index i = 0; i < 3; ++i)
+        {
+            entry.threadGroupSize[i] = uint32_t(threadGroupSize[i]);
+        }
+
+        m_entryPoints.add(entry);
+    }
+
+    void addProgram(slang::ProgramLayout* programLayout)
+    {
+        m_header.globalParamsVarLayout = addVarLayout(programLayout->getGlobalParamsVarLayout());
+
+        const unsigned parameterCount = programLayout->getParameterCount();
+        m_header.firstParameter = reserveVarLayouts(parameterCount);
+        m_header.parameterCount = parameterCount;
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            writeVarLayout(m_header.firstParameter + i, programLayout->getParameterByIndex(i));
+        }
+
+        const SlangUInt entryPointCount = programLayout->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+        {
+            addEntryPoint(programLayout->getEntryPointByIndex(i));
+        }
+    }
+
+    template<typename T>
+    static Index _addTable(Index offset, const List<T>& entries, SlangFlatReflectionTable& outTable)
+    {
+        // Every table is 8 byte aligned, which is enough for any of the entry types
+        offset = (offset + 7) & ~Index(7);
+        outTable.offset = uint32_t(offset);
+        outTable.count = uint32_t(entries.getCount());
+        return offset + entries.getCount() * Index(sizeof(T));
+    }
+
+    template<typename T>
+    static void _writeTable(uint8_t* dst, const List<T>& entries, const SlangFlatReflectionTable& table)
+    {
+        if (entries.getCount())
+        {
+            ::memcpy(dst + table.offset, entries.getBuffer(), entries.getCount() * sizeof(T));
+        }
+    }
+
+    SlangResult write(ISlangBlob** outBlob)
+    {
+        m_header.magic = SLANG_FLAT_REFLECTION_MAGIC;
+        m_header.version = SLANG_FLAT_REFLECTION_VERSION;
+
+        Index size = Index(sizeof(m_header));
+        size = _addTable(size, m_strings, m_header.strings);
+        size = _addTable(size, m_typeLayouts, m_header.typeLayouts);
+        size = _addTable(size, m_varLayouts, m_header.varLayouts);
+        size = _addTable(size, m_sizes, m_header.sizes);
+        size = _addTable(size, m_offsets, m_header.offsets);
+        size = _addTable(size, m_bindingRanges, m_header.bindingRanges);
+        size = _addTable(size, m_entryPoints, m_header.entryPoints);
+
+        // Offsets are 32 bit
+        if (size > Index(0xffffffff))
+        {
+            return SLANG_FAIL;
+        }
+        m_header.size = uint32_t(size);
+
+        // Zero everything first so that padding is deterministic, and the blob can be compared
+        // or hashed.
+        List<uint8_t> data;
+        data.setCount(size);
+        ::memset(data.getBuffer(), 0, size);
+
+        uint8_t* dst = data.getBuffer();
+        ::memcpy(dst, &m_header, sizeof(m_header));
+        _writeTable(dst, m_strings, m_header.strings);
+        _writeTable(dst, m_typeLayouts, m_header.typeLayouts);
+        _writeTable(dst, m_varLayouts, m_header.varLayouts);
+        _writeTable(dst, m_sizes, m_header.sizes);
+        _writeTable(dst, m_offsets, m_header.offsets);
+        _writeTable(dst, m_bindingRanges, m_header.bindingRanges);
+        _writeTable(dst, m_entryPoints, m_header.entryPoints);
+
+        *outBlob = ListBlob::moveCreate(data).detach();
+        return SLANG_OK;
+    }
+
+    SlangFlatReflectionHeader m_header = {};
+
+    List<char> m_strings;
+    List<SlangFlatReflectionTypeLayout> m_typeLayouts;
+    List<SlangFlatReflectionVarLayout> m_varLayouts;
+    List<SlangFlatReflectionSize> m_sizes;
+    List<SlangFlatReflectionOffset> m_offsets;
+    List<SlangFlatReflectionBindingRange> m_bindingRanges;
+    List<SlangFlatReflectionEntryPoint> m_entryPoints;
+
+    Dictionary<UnownedStringSlice, uint32_t> m_stringOffsets;
+    Dictionary<slang::TypeLayoutReflection*, uint32_t> m_typeLayoutIndices;
+};
+
+} // anonymous
+
+SlangResult writeFlatReflection(slang::ProgramLayout* programLayout, ISlangBlob** outBlob)
+{
+    if (!programLayout || !outBlob)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    FlatReflectionWriter writer;
+    writer.addProgram(programLayout);
+    return writer.write(outBlob);
+}
+
+}
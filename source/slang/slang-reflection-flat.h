@@ -0,0 +1,12 @@
+// slang-reflection-flat.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "slang.h"
+
+namespace Slang
+{
+        /// Write the layout of `programLayout` to a flat reflection blob, as described by
+        /// `SlangFlatReflectionHeader` in slang.h
+    SlangResult writeFlatReflection(slang::ProgramLayout* programLayout, ISlangBlob** outBlob);
+}
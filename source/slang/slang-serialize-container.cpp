@@ -536,12 +536,23 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             {
                 if (!options.readHeaderOnly)
                 {
-                    IRSerialData serialData;
-                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    if (options.deferIRModule)
+                    {
+                        // Only read the serial data, the IRModule is constructed on demand
+                        module.deferredIRModule = new SerialDeferredIRModule;
+                        module.deferredIRModule->session = options.session;
+                        module.deferredIRModule->sourceLocReader = sourceLocReader;
+                        SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &module.deferredIRModule->serialData));
+                    }
+                    else
+                    {
+                        IRSerialData serialData;
+                        SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
 
-                    // Read IR back from serialData
-                    IRSerialReader reader;
-                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                        // Read IR back from serialData
+                        IRSerialReader reader;
+                        SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    }
                 }
 
                 // Onto next chunk
@@ -770,7 +781,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || module.deferredIRModule)
             {
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
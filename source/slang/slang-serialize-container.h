@@ -5,6 +5,7 @@
 #include "../core/slang-riff.h"
 #include "slang-serialize-types.h"
 #include "slang-ir-insts.h"
+#include "slang-serialize-ir.h"
 #include "slang-profile.h"
 
 namespace Slang {
@@ -33,6 +34,7 @@ struct SerialContainerBinary
 struct SerialContainerDataModule
 {
     RefPtr<IRModule> irModule;              ///< The IR for the module
+    RefPtr<SerialDeferredIRModule> deferredIRModule;    ///< The IR for the module if read with `deferIRModule`
     RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
     NodeBase* astRootNode = nullptr;        ///< The module decl
     List<String> dependentFiles;
@@ -97,6 +99,9 @@ struct SerialContainerUtil
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
+            /// If set, IR is read into `SerialContainerDataModule::deferredIRModule`, leaving
+            /// construction of the `IRModule` to whoever first needs it.
+        bool deferIRModule = false;
         String modulePath;
     };
 
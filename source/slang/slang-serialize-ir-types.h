@@ -18,6 +18,7 @@ namespace Slang {
 
 // Pre-declare
 class Name;
+class Session;
 
 struct IRSerialBinary
 {
@@ -253,6 +254,22 @@ SLANG_FORCE_INLINE int IRSerialData::getOperands(const Inst& inst, const InstInd
 }
 
 
+    /// IR for a module that has been read from a container, but not yet turned into an `IRModule`.
+    ///
+    /// Constructing the `IRModule` is the expensive part of reading IR, so holding on to the
+    /// serial data allows it to be put off until the IR is actually needed (or avoided entirely
+    /// if it never is).
+class SerialDeferredIRModule : public RefObject
+{
+public:
+        /// Construct the IRModule from the held serial data
+    SlangResult materialize(RefPtr<IRModule>& outModule);
+
+    IRSerialData serialData;
+    RefPtr<SerialSourceLocReader> sourceLocReader;
+    Session* session = nullptr;
+};
+
 } // namespace Slang
 
 #endif
@@ -941,4 +941,12 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialDeferredIRModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+SlangResult SerialDeferredIRModule::materialize(RefPtr<IRModule>& outModule)
+{
+    IRSerialReader reader;
+    return reader.read(serialData, session, sourceLocReader, outModule);
+}
+
 } // namespace Slang
@@ -403,6 +403,9 @@ SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
     // Let's try loading serialized modules and adding them
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
 
+    // Conversion costs are optional, as older archives won't contain them
+    _readConversionCostCache(fileSystem);
+
     finalizeSharedASTBuilder();
     return SLANG_OK;
 }
@@ -452,29 +455,85 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
         SLANG_RETURN_ON_FAIL(fileSystem->saveFile(builder.getBuffer(), contents.getBuffer(), contents.getCount()));
     }
 
+    SLANG_RETURN_ON_FAIL(_writeConversionCostCache(fileSystem));
+
     // Now need to convert into a blob
     SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(true, outBlob));
     return SLANG_OK;
 }
 
+// The conversion cost cache is stored in the stdlib archive as an array of uint32_t holding
+// a header followed by a (toType, fromType, cost) triple for each entry.
+static const char kConversionCostCacheFileName[] = "conversion-costs.bin";
+static const uint32_t kConversionCostCacheFourCC = SLANG_FOUR_CC('S', 'c', 'c', 'c');
+static const uint32_t kConversionCostCacheVersion = 0;
+
+SlangResult Session::_writeConversionCostCache(ISlangMutableFileSystem* fileSystem)
+{
+    auto cache = m_builtinLinkage->getTypeCheckingCache();
+
+    List<uint32_t> data;
+    {
+        std::lock_guard<std::mutex> lock(m_typeCheckingCacheMutex);
+
+        data.add(kConversionCostCacheFourCC);
+        data.add(kConversionCostCacheVersion);
+        data.add(uint32_t(cache->conversionCostCache.getCount()));
+        for (const auto& [key, cost] : cache->conversionCostCache)
+        {
+            data.add(key.type1.getRaw());
+            data.add(key.type2.getRaw());
+            data.add(uint32_t(cost));
+        }
+    }
+
+    return fileSystem->saveFile(kConversionCostCacheFileName, data.getBuffer(), data.getCount() * sizeof(uint32_t));
+}
+
+void Session::_readConversionCostCache(ISlangFileSystem* fileSystem)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(fileSystem->loadFile(kConversionCostCacheFileName, blob.writeRef())))
+    {
+        return;
+    }
+
+    const size_t wordCount = blob->getBufferSize() / sizeof(uint32_t);
+    List<uint32_t> data;
+    data.setCount(wordCount);
+    memcpy(data.getBuffer(), blob->getBufferPointer(), wordCount * sizeof(uint32_t));
+
+    if (wordCount < 3 ||
+        data[0] != kConversionCostCacheFourCC ||
+        data[1] != kConversionCostCacheVersion ||
+        wordCount != 3 + size_t(data[2]) * 3)
+    {
+        return;
+    }
+
+    auto cache = m_builtinLinkage->getTypeCheckingCache();
+    for (Index i = 3; i < data.getCount(); i += 3)
+    {
+        BasicTypeKeyPair key;
+        memcpy(&key.type1, &data[i], sizeof(uint32_t));
+        memcpy(&key.type2, &data[i + 1], sizeof(uint32_t));
+        cache->conversionCostCache.addIfNotExists(key, ConversionCost(data[i + 2]));
+    }
+}
+
 SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName)
 {
     // Get the name of the module
     StringBuilder moduleFilename;
     moduleFilename << moduleName << ".slang-module";
 
-    RiffContainer riffContainer;
-    {
-        // Load it
-        ComPtr<ISlangBlob> blob;
-        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
-
-        // Set up a stream
-        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+    // Load it. The blob is held for the duration of the read, as the container
+    // references its contents rather than copying them.
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
 
-        // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
-    }
+    RiffContainer riffContainer;
+    SLANG_RETURN_ON_FAIL(RiffUtil::readBuffer(blob->getBufferPointer(), blob->getBufferSize(), riffContainer));
 
     // Load up the module
 
@@ -494,6 +553,9 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     options.astBuilder = linkage->getASTBuilder();
     options.sourceManager = sourceManger;
     options.linkage = linkage;
+    // Most sessions only ever touch a fraction of the builtin module, and many never
+    // generate code at all, so only construct the IR once it is needed.
+    options.deferIRModule = true;
 
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
@@ -520,7 +582,10 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
             module->setModuleDecl(moduleDecl);
         }
 
-        module->setIRModule(srcModule.irModule);
+        if (srcModule.deferredIRModule)
+            module->setDeferredIRModule(srcModule.deferredIRModule);
+        else
+            module->setIRModule(srcModule.irModule);
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.add(sessionNamePool->getName(moduleName), module);
@@ -1101,12 +1166,41 @@ TypeCheckingCache* Linkage::getTypeCheckingCache()
     if (!m_typeCheckingCache)
     {
         m_typeCheckingCache = new TypeCheckingCache();
+
+        // Start from the results cached by the builtin linkage. These only reference AST nodes
+        // owned by the builtin linkage, which outlives this one, in the same way as the
+        // `m_cachedNodes` copied from its ASTBuilder.
+        Linkage* builtinLinkage = m_session->getBuiltinLinkage();
+        if (builtinLinkage && builtinLinkage != this)
+        {
+            std::lock_guard<std::mutex> lock(m_session->m_typeCheckingCacheMutex);
+            if (auto builtinCache = builtinLinkage->m_typeCheckingCache)
+            {
+                m_typeCheckingCache->resolvedOperatorOverloadCache = builtinCache->resolvedOperatorOverloadCache;
+                m_typeCheckingCache->conversionCostCache = builtinCache->conversionCostCache;
+            }
+        }
     }
     return m_typeCheckingCache;
 }
 
 void Linkage::destroyTypeCheckingCache()
 {
+    // Conversion costs between basic types only depend on the standard library, and
+    // hold no references to AST nodes, so we add the ones this linkage computed to the
+    // builtin linkage for any linkage created later. Resolved overloads can reference
+    // nodes owned by this linkage, so they can't be kept.
+    Linkage* builtinLinkage = m_session ? m_session->getBuiltinLinkage() : nullptr;
+    if (m_typeCheckingCache && builtinLinkage && builtinLinkage != this)
+    {
+        std::lock_guard<std::mutex> lock(m_session->m_typeCheckingCacheMutex);
+        auto builtinCache = builtinLinkage->getTypeCheckingCache();
+        for (const auto& [key, cost] : m_typeCheckingCache->conversionCostCache)
+        {
+            builtinCache->conversionCostCache.addIfNotExists(key, cost);
+        }
+    }
+
     delete m_typeCheckingCache;
     m_typeCheckingCache = nullptr;
 }
@@ -3573,9 +3667,9 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     String mostUniqueIdentity = filePathInfo.getMostUniqueIdentity();
     SLANG_ASSERT(mostUniqueIdentity.getLength() > 0);
 
+    // The container references the blob contents in place, which outlive it.
     RiffContainer container;
-    MemoryStreamBase readStream(FileAccess::Read, fileContentsBlob->getBufferPointer(), fileContentsBlob->getBufferSize());
-    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::read(&readStream, container));
+    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::readBuffer(fileContentsBlob->getBufferPointer(), fileContentsBlob->getBufferSize(), container));
 
     if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
     {
@@ -3981,8 +4075,7 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
 SLANG_NO_THROW bool SLANG_MCALL Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
     RiffContainer container;
-    MemoryStreamBase readStream(FileAccess::Read, binaryModuleBlob->getBufferPointer(), binaryModuleBlob->getBufferSize());
-    if (SLANG_FAILED(RiffUtil::read(&readStream, container)))
+    if (SLANG_FAILED(RiffUtil::readBuffer(binaryModuleBlob->getBufferPointer(), binaryModuleBlob->getBufferSize(), container)))
         return false;
     return isBinaryModuleUpToDate(modulePath, &container);
 }
@@ -4182,6 +4275,27 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
     addModuleDependency(this);
 }
 
+void Module::setDeferredIRModule(SerialDeferredIRModule* deferredIRModule)
+{
+    SLANG_ASSERT(!m_irModule && !m_hasDeferredIRModule);
+    m_deferredIRModule = deferredIRModule;
+    m_hasDeferredIRModule = true;
+}
+
+void Module::_materializeDeferredIRModule()
+{
+    // Called through `m_deferredIRModuleOnceFlag`. Release the serial data whether or not
+    // construction succeeds, so we only try once.
+    RefPtr<SerialDeferredIRModule> deferredIRModule = _Move(m_deferredIRModule);
+
+    RefPtr<IRModule> irModule;
+    if (SLANG_FAILED(deferredIRModule->materialize(irModule)))
+    {
+        SLANG_UNEXPECTED("unable to read deferred IR module");
+    }
+    m_irModule = irModule;
+}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if(guid == IModule::getTypeGuid())
@@ -5536,6 +5650,10 @@ TargetProgram::TargetProgram(
     m_entryPointResults.setCount(componentType->getEntryPointCount());
     m_optionSet.overrideWith(m_program->getOptionSet());
     m_optionSet.inheritFrom(targetReq->getOptionSet());
+
+    // The cache is created up front, as links of the program can run on different threads
+    if (m_optionSet.getBoolOption(CompilerOptionName::SpecializationCache))
+        m_specializationCache = new IRSpecializationCache(componentType->getLinkage()->getSessionImpl());
 }
 
 //
@@ -6308,10 +6426,28 @@ SlangResult EndToEndCompileRequest::compile()
     double downstreamStartTime = 0.0;
     double totalStartTime = 0.0;
 
+    // The downstream cache is shared across the session, so we report the difference in its stats
+    PersistentCache* downstreamCache = nullptr;
+    PersistentCache::Stats downstreamCacheStartStats = {};
+
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamTime))
     {
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
         PerformanceProfiler::getProfiler()->clear();
+
+        const String downstreamCacheDirectory = getOptionSet().getStringOption(CompilerOptionName::DownstreamCache);
+        if (downstreamCacheDirectory.getLength())
+        {
+            downstreamCache = getSession()->getDownstreamArtifactCache(downstreamCacheDirectory);
+            downstreamCacheStartStats = downstreamCache->getStats();
+        }
+    }
+
+    const String perfTracePath = getOptionSet().getStringOption(CompilerOptionName::ReportPerfTrace);
+    if (perfTracePath.getLength())
+    {
+        PerformanceProfiler::getProfiler()->clear();
+        PerformanceProfiler::getProfiler()->setTraceEnabled(true);
     }
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
@@ -6375,6 +6511,14 @@ SlangResult EndToEndCompileRequest::compile()
         double downstreamTime = downstreamEndTime - downstreamStartTime;
         String downstreamTimeStr = String(downstreamTime, "%.2f");
         getSink()->diagnose(SourceLoc(), Diagnostics::downstreamCompileTime, downstreamTimeStr);
+
+        if (downstreamCache)
+        {
+            const auto stats = downstreamCache->getStats();
+            getSink()->diagnose(SourceLoc(), Diagnostics::downstreamCacheStats,
+                stats.hitCount - downstreamCacheStartStats.hitCount,
+                stats.missCount - downstreamCacheStartStats.missCount);
+        }
     }
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmark))
     {
@@ -6383,6 +6527,18 @@ SlangResult EndToEndCompileRequest::compile()
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
         getSink()->diagnose(SourceLoc(), Diagnostics::performanceBenchmarkResult, perfResult.produceString());
     }
+    if (perfTracePath.getLength())
+    {
+        auto profiler = PerformanceProfiler::getProfiler();
+        profiler->setTraceEnabled(false);
+
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+        if (SLANG_FAILED(File::writeAllText(perfTracePath, trace)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, perfTracePath);
+        }
+    }
 
     // Repro dump handling
     {
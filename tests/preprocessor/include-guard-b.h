@@ -0,0 +1,14 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+
+float bar(float x) { return x; }
+
+#else
+
+float baz(float x) { return x; }
+
+#endif
@@ -0,0 +1,123 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // Dispatches a grid of 5x3x2 groups, and checks that every group ran exactly once.
+    void cpuParallelDispatchTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-parallel-dispatch", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        // Must match the dispatch below, and the group size in the shader
+        const GfxCount groupCountX = 5, groupCountY = 3, groupCountZ = 2;
+        const GfxCount numberCount = (groupCountX * 4) * (groupCountY * 2) * groupCountZ;
+
+        Slang::List<uint32_t> initialData;
+        Slang::List<uint32_t> expectedData;
+        for (GfxIndex i = 0; i < numberCount; ++i)
+        {
+            initialData.add(uint32_t(i * 2));
+            expectedData.add(uint32_t(i * 3 + 1));
+        }
+
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(uint32_t);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData.getBuffer(),
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor(rootObject).getPath("buffer").setResource(bufferView);
+
+            encoder->dispatchCompute(groupCountX, groupCountY, groupCountZ);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+        }
+
+        compareComputeResult(
+            device,
+            numbersBuffer,
+            0,
+            expectedData.getBuffer(),
+            size_t(expectedData.getCount()) * sizeof(uint32_t));
+    }
+
+    // Runs the dispatch with the given number of CPU device dispatch threads
+    static void _runCPUParallelDispatchTest(UnitTestContext* context, GfxCount dispatchThreadCount)
+    {
+        CPUDeviceExtendedDesc cpuDesc = {};
+        cpuDesc.dispatchThreadCount = dispatchThreadCount;
+
+        runTestImpl(
+            cpuParallelDispatchTestImpl,
+            context,
+            Slang::RenderApiFlag::CPU,
+            {},
+            {},
+            PipelineSpecializationMode::Synchronous,
+            Slang::List<void*>((void*)&cpuDesc));
+    }
+
+    SLANG_UNIT_TEST(cpuDispatchSingleThread)
+    {
+        _runCPUParallelDispatchTest(unitTestContext, 1);
+    }
+
+    SLANG_UNIT_TEST(cpuDispatchFourThreads)
+    {
+        _runCPUParallelDispatchTest(unitTestContext, 4);
+    }
+
+    SLANG_UNIT_TEST(cpuDispatchHardwareThreads)
+    {
+        _runCPUParallelDispatchTest(unitTestContext, 0);
+    }
+}
@@ -242,7 +242,9 @@ namespace gfx_test
         UnitTestContext* context,
         Slang::RenderApiFlag::Enum api,
         Slang::List<const char*> additionalSearchPaths,
-        gfx::IDevice::ShaderCacheDesc shaderCache)
+        gfx::IDevice::ShaderCacheDesc shaderCache,
+        gfx::PipelineSpecializationMode pipelineSpecializationMode,
+        Slang::List<void*> additionalExtendedDescs)
     {
         Slang::ComPtr<gfx::IDevice> device;
         gfx::IDevice::Desc deviceDesc = {};
@@ -294,9 +296,16 @@ namespace gfx_test
         slangExtDesc.compilerOptionEntries = entries.getBuffer();
         slangExtDesc.compilerOptionEntryCount = (uint32_t)entries.getCount();
 
-        deviceDesc.extendedDescCount = 2;
-        void* extDescPtrs[2] = { &extDesc, &slangExtDesc };
-        deviceDesc.extendedDescs = extDescPtrs;
+        gfx::PipelineSpecializationDesc specializationDesc = {};
+        specializationDesc.mode = pipelineSpecializationMode;
+
+        Slang::List<void*> extDescPtrs;
+        extDescPtrs.add(&extDesc);
+        extDescPtrs.add(&slangExtDesc);
+        extDescPtrs.add(&specializationDesc);
+        extDescPtrs.addRange(additionalExtendedDescs);
+        deviceDesc.extendedDescCount = (gfx::GfxCount)extDescPtrs.getCount();
+        deviceDesc.extendedDescs = extDescPtrs.getBuffer();
 
         // TODO: We should also set the debug callback
         // (And in general reduce the differences (and duplication) between
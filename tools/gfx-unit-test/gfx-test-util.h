@@ -86,7 +86,10 @@ namespace gfx_test
         UnitTestContext* context,
         Slang::RenderApiFlag::Enum api,
         Slang::List<const char*> additionalSearchPaths = {},
-        gfx::IDevice::ShaderCacheDesc shaderCache = {});
+        gfx::IDevice::ShaderCacheDesc shaderCache = {},
+        gfx::PipelineSpecializationMode pipelineSpecializationMode =
+            gfx::PipelineSpecializationMode::Synchronous,
+        Slang::List<void*> additionalExtendedDescs = {});
     
     Slang::List<const char*> getSlangSearchPaths();
 
@@ -100,13 +103,17 @@ namespace gfx_test
         UnitTestContext* context,
         Slang::RenderApiFlag::Enum api,
         Slang::List<const char*> searchPaths = {},
-        gfx::IDevice::ShaderCacheDesc shaderCache = {})
+        gfx::IDevice::ShaderCacheDesc shaderCache = {},
+        gfx::PipelineSpecializationMode pipelineSpecializationMode =
+            gfx::PipelineSpecializationMode::Synchronous,
+        Slang::List<void*> additionalExtendedDescs = {})
     {
         if ((api & context->enabledApis) == 0)
         {
             SLANG_IGNORE_TEST
         }
-        auto device = createTestingDevice(context, api, searchPaths, shaderCache);
+        auto device = createTestingDevice(
+            context, api, searchPaths, shaderCache, pipelineSpecializationMode, additionalExtendedDescs);
         if (!device)
         {
             SLANG_IGNORE_TEST
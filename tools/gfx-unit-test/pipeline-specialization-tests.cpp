@@ -0,0 +1,392 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // Dispatches `compute-smoke` with an `AddTransformer` bound to its `ITransformer`
+    // parameter, on a device that specializes pipelines on a background worker.
+    void pipelineSpecializationTestImpl(IDevice* device, UnitTestContext* context, bool prewarm)
+    {
+        ComPtr<IPipelineSpecializer> specializer;
+        GFX_CHECK_CALL_ABORT(device->queryInterface(
+            SLANG_UUID_IPipelineSpecializer, (void**)specializer.writeRef()));
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-smoke", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        slang::TypeReflection* addTransformerType =
+            slangReflection->findTypeByName("AddTransformer");
+
+        if (prewarm)
+        {
+            slang::SpecializationArg arg = slang::SpecializationArg::fromType(addTransformerType);
+            SpecializedPipelineKey key = {};
+            key.pipeline = pipelineState;
+            key.specializationArgs = &arg;
+            key.specializationArgCount = 1;
+            GFX_CHECK_CALL_ABORT(specializer->prewarmSpecializedPipelines(&key, 1));
+            GFX_CHECK_CALL_ABORT(specializer->waitForPipelineSpecializations());
+
+            PipelineSpecializationStats stats = {};
+            GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+            SLANG_CHECK(stats.pendingCount == 0);
+            SLANG_CHECK(stats.completedCount == 1);
+            SLANG_CHECK(stats.failedCount == 0);
+        }
+
+        const int numberCount = 4;
+        float initialData[] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(float);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData,
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+
+            ComPtr<IShaderObject> transformer;
+            GFX_CHECK_CALL_ABORT(device->createShaderObject(
+                addTransformerType, ShaderObjectContainerType::None, transformer.writeRef()));
+            float c = 1.0f;
+            ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+            entryPointCursor.getPath("transformer").setObject(transformer);
+
+            // Without prewarming, the dispatch waits for the worker to specialize the pipeline.
+            GFX_CHECK_CALL_ABORT(encoder->dispatchCompute(1, 1, 1));
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+        }
+
+        compareComputeResult(
+            device,
+            numbersBuffer,
+            Slang::makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+
+        GFX_CHECK_CALL_ABORT(specializer->waitForPipelineSpecializations());
+        PipelineSpecializationStats stats = {};
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.pendingCount == 0);
+        SLANG_CHECK(stats.failedCount == 0);
+        SLANG_CHECK(stats.skippedCount == 0);
+    }
+
+    // Creates the `compute-smoke` pipeline and the buffer it transforms, and binds them with an
+    // `AddTransformer` to a compute encoder.
+    struct TransformerDispatch
+    {
+        ComPtr<ITransientResourceHeap> transientHeap;
+        ComPtr<ICommandQueue> queue;
+        ComPtr<IPipelineState> pipelineState;
+        slang::TypeReflection* addTransformerType = nullptr;
+        ComPtr<IBufferResource> numbersBuffer;
+        ComPtr<IResourceView> bufferView;
+        ComPtr<IShaderObject> transformer;
+
+        void init(IDevice* device, UnitTestContext* context)
+        {
+            ITransientResourceHeap::Desc transientHeapDesc = {};
+            transientHeapDesc.constantBufferSize = 4096;
+            GFX_CHECK_CALL_ABORT(
+                device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            GFX_CHECK_CALL_ABORT(device->createCommandQueue(queueDesc, queue.writeRef()));
+
+            ComPtr<IShaderProgram> shaderProgram;
+            slang::ProgramLayout* slangReflection;
+            GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-smoke", "computeMain", slangReflection));
+
+            ComputePipelineStateDesc pipelineDesc = {};
+            pipelineDesc.program = shaderProgram.get();
+            GFX_CHECK_CALL_ABORT(
+                device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+            addTransformerType = slangReflection->findTypeByName("AddTransformer");
+
+            const int numberCount = 4;
+            float initialData[] = { 0.0f, 1.0f, 2.0f, 3.0f };
+            IBufferResource::Desc bufferDesc = {};
+            bufferDesc.sizeInBytes = numberCount * sizeof(float);
+            bufferDesc.format = gfx::Format::Unknown;
+            bufferDesc.elementSize = sizeof(float);
+            bufferDesc.allowedStates = ResourceStateSet(
+                ResourceState::ShaderResource,
+                ResourceState::UnorderedAccess,
+                ResourceState::CopyDestination,
+                ResourceState::CopySource);
+            bufferDesc.defaultState = ResourceState::UnorderedAccess;
+            bufferDesc.memoryType = MemoryType::DeviceLocal;
+            GFX_CHECK_CALL_ABORT(device->createBufferResource(
+                bufferDesc,
+                (void*)initialData,
+                numbersBuffer.writeRef()));
+
+            IResourceView::Desc viewDesc = {};
+            viewDesc.type = IResourceView::Type::UnorderedAccess;
+            viewDesc.format = Format::Unknown;
+            GFX_CHECK_CALL_ABORT(
+                device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+            GFX_CHECK_CALL_ABORT(device->createShaderObject(
+                addTransformerType, ShaderObjectContainerType::None, transformer.writeRef()));
+            float c = 1.0f;
+            ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+        }
+
+        // Records a dispatch, and executes it if it was recorded. Returns the result of
+        // `dispatchCompute`.
+        Result dispatch()
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+            entryPointCursor.getPath("transformer").setObject(transformer);
+
+            auto result = encoder->dispatchCompute(1, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+            return result;
+        }
+    };
+
+    // While the specialized pipeline is compiled, the dispatch uses the pipeline specialized
+    // with `__Dynamic`, which must give the same result.
+    void fallbackToDynamicPipelineTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        ComPtr<IPipelineSpecializer> specializer;
+        GFX_CHECK_CALL_ABORT(device->queryInterface(
+            SLANG_UUID_IPipelineSpecializer, (void**)specializer.writeRef()));
+
+        TransformerDispatch dispatch;
+        dispatch.init(device, context);
+
+        // Only create the dynamic pipeline ahead of the dispatch.
+        ComPtr<slang::ISession> slangSession;
+        GFX_CHECK_CALL_ABORT(device->getSlangSession(slangSession.writeRef()));
+        slang::SpecializationArg dynamicArg =
+            slang::SpecializationArg::fromType(slangSession->getDynamicType());
+        SpecializedPipelineKey key = {};
+        key.pipeline = dispatch.pipelineState;
+        key.specializationArgs = &dynamicArg;
+        key.specializationArgCount = 1;
+        GFX_CHECK_CALL_ABORT(specializer->prewarmSpecializedPipelines(&key, 1));
+        GFX_CHECK_CALL_ABORT(specializer->waitForPipelineSpecializations());
+
+        PipelineSpecializationStats stats = {};
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.completedCount == 1);
+        SLANG_CHECK(stats.fallbackCount == 0);
+
+        // The `AddTransformer` specialization has only just been queued, so the dynamic
+        // pipeline is used.
+        GFX_CHECK_CALL_ABORT(dispatch.dispatch());
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.fallbackCount == 1);
+        SLANG_CHECK(stats.skippedCount == 0);
+
+        compareComputeResult(
+            device,
+            dispatch.numbersBuffer,
+            Slang::makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+
+        GFX_CHECK_CALL_ABORT(specializer->waitForPipelineSpecializations());
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.pendingCount == 0);
+        SLANG_CHECK(stats.completedCount == 2);
+        SLANG_CHECK(stats.failedCount == 0);
+        SLANG_CHECK(stats.fallbackCount == 1);
+    }
+
+    // A dispatch whose specialized pipeline is not ready is not recorded, and is recorded once
+    // the pipeline has been created.
+    void skipPendingPipelineTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        ComPtr<IPipelineSpecializer> specializer;
+        GFX_CHECK_CALL_ABORT(device->queryInterface(
+            SLANG_UUID_IPipelineSpecializer, (void**)specializer.writeRef()));
+
+        TransformerDispatch dispatch;
+        dispatch.init(device, context);
+
+        SLANG_CHECK(dispatch.dispatch() == SLANG_E_PENDING);
+
+        PipelineSpecializationStats stats = {};
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.skippedCount == 1);
+        SLANG_CHECK(stats.fallbackCount == 0);
+
+        // The skipped dispatch left the buffer unchanged.
+        compareComputeResult(
+            device,
+            dispatch.numbersBuffer,
+            Slang::makeArray<float>(0.0f, 1.0f, 2.0f, 3.0f));
+
+        GFX_CHECK_CALL_ABORT(specializer->waitForPipelineSpecializations());
+        GFX_CHECK_CALL_ABORT(dispatch.dispatch());
+
+        compareComputeResult(
+            device,
+            dispatch.numbersBuffer,
+            Slang::makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+
+        GFX_CHECK_CALL_ABORT(specializer->getPipelineSpecializationStats(&stats));
+        SLANG_CHECK(stats.pendingCount == 0);
+        SLANG_CHECK(stats.completedCount == 1);
+        SLANG_CHECK(stats.failedCount == 0);
+        SLANG_CHECK(stats.skippedCount == 1);
+    }
+
+    void prewarmSpecializedPipelineTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        pipelineSpecializationTestImpl(device, context, true);
+    }
+
+    void waitForSpecializedPipelineTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        pipelineSpecializationTestImpl(device, context, false);
+    }
+
+    SLANG_UNIT_TEST(prewarmSpecializedPipelineD3D12)
+    {
+        runTestImpl(
+            prewarmSpecializedPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::D3D12,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncWait);
+    }
+
+    SLANG_UNIT_TEST(prewarmSpecializedPipelineVulkan)
+    {
+        runTestImpl(
+            prewarmSpecializedPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::Vulkan,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncWait);
+    }
+
+    SLANG_UNIT_TEST(waitForSpecializedPipelineD3D12)
+    {
+        runTestImpl(
+            waitForSpecializedPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::D3D12,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncWait);
+    }
+
+    SLANG_UNIT_TEST(waitForSpecializedPipelineVulkan)
+    {
+        runTestImpl(
+            waitForSpecializedPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::Vulkan,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncWait);
+    }
+
+    SLANG_UNIT_TEST(fallbackToDynamicPipelineD3D12)
+    {
+        runTestImpl(
+            fallbackToDynamicPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::D3D12,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncFallbackToDynamic);
+    }
+
+    SLANG_UNIT_TEST(fallbackToDynamicPipelineVulkan)
+    {
+        runTestImpl(
+            fallbackToDynamicPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::Vulkan,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncFallbackToDynamic);
+    }
+
+    SLANG_UNIT_TEST(skipPendingPipelineD3D12)
+    {
+        runTestImpl(
+            skipPendingPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::D3D12,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncSkip);
+    }
+
+    SLANG_UNIT_TEST(skipPendingPipelineVulkan)
+    {
+        runTestImpl(
+            skipPendingPipelineTestImpl,
+            unitTestContext,
+            Slang::RenderApiFlag::Vulkan,
+            {},
+            {},
+            PipelineSpecializationMode::AsyncSkip);
+    }
+
+}
@@ -21,6 +21,7 @@ namespace cpu
     {
         m_currentPipeline = nullptr;
         m_currentRootObject = nullptr;
+        m_threadPool = nullptr;
     }
 
     SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
@@ -35,6 +36,25 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        GfxCount dispatchThreadCount = 1;
+        for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+        {
+            StructType stype;
+            memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+            if (stype == StructType::CPUDeviceExtendedDesc)
+            {
+                dispatchThreadCount = static_cast<CPUDeviceExtendedDesc*>(desc.extendedDescs[i])->dispatchThreadCount;
+            }
+        }
+        if (dispatchThreadCount <= 0)
+        {
+            dispatchThreadCount = Math::Max(GfxCount(std::thread::hardware_concurrency()), GfxCount(1));
+        }
+        if (dispatchThreadCount > 1)
+        {
+            m_threadPool = new ThreadPool(dispatchThreadCount);
+        }
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -271,17 +291,68 @@ namespace cpu
 
         auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-        slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
-
         auto globalParamsData = m_currentRootObject->getDataBuffer();
         auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+
+        if (!m_threadPool || x <= 0 || y <= 0 || z <= 0 || int64_t(x) * y * z <= 1)
+        {
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = 0;
+            varyingInput.startGroupID.y = 0;
+            varyingInput.startGroupID.z = 0;
+            varyingInput.endGroupID.x = x;
+            varyingInput.endGroupID.y = y;
+            varyingInput.endGroupID.z = z;
+
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+            return;
+        }
+
+        // Split the group grid into tiles, each a run of groups along x within a single (y, z) row.
+        // We aim for several tiles per thread, so threads that finish early can pick up remaining work.
+        struct DispatchContext
+        {
+            slang_prelude::ComputeFunc func;
+            void* entryPointParamsData;
+            void* globalParamsData;
+            uint32_t tileSizeX;
+            uint32_t tilesPerRow;
+            uint32_t sizeX;
+            uint32_t sizeY;
+        };
+
+        const int64_t groupCount = int64_t(x) * y * z;
+        const int64_t targetTileCount = int64_t(m_threadPool->getThreadCount()) * 4;
+        const int64_t tileSizeX = Math::Min(int64_t(x), Math::Max(int64_t(1), groupCount / targetTileCount));
+
+        DispatchContext context;
+        context.func = func;
+        context.entryPointParamsData = entryPointParamsData;
+        context.globalParamsData = globalParamsData;
+        context.tileSizeX = uint32_t(tileSizeX);
+        context.tilesPerRow = uint32_t((x + tileSizeX - 1) / tileSizeX);
+        context.sizeX = uint32_t(x);
+        context.sizeY = uint32_t(y);
+
+        const Index tileCount = Index(context.tilesPerRow) * y * z;
+
+        m_threadPool->run(tileCount, [](void* inContext, Index tileIndex)
+        {
+            const auto& context = *(const DispatchContext*)inContext;
+
+            const uint32_t tileX = uint32_t(tileIndex % context.tilesPerRow);
+            const Index row = tileIndex / context.tilesPerRow;
+
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = tileX * context.tileSizeX;
+            varyingInput.startGroupID.y = uint32_t(row % context.sizeY);
+            varyingInput.startGroupID.z = uint32_t(row / context.sizeY);
+            varyingInput.endGroupID.x = Math::Min(varyingInput.startGroupID.x + context.tileSizeX, context.sizeX);
+            varyingInput.endGroupID.y = varyingInput.startGroupID.y + 1;
+            varyingInput.endGroupID.z = varyingInput.startGroupID.z + 1;
+
+            context.func(&varyingInput, context.entryPointParamsData, context.globalParamsData);
+        }, &context);
     }
 
     void DeviceImpl::copyBuffer(
@@ -4,6 +4,7 @@
 
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
+#include "cpu-thread-pool.h"
 
 namespace gfx
 {
@@ -80,6 +81,8 @@ private:
     RefPtr<PipelineStateImpl> m_currentPipeline = nullptr;
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
+    // Used to execute the groups of a dispatch in parallel, if more than one thread is enabled.
+    RefPtr<ThreadPool> m_threadPool;
 
     virtual void setPipelineState(IPipelineState* state) override;
 
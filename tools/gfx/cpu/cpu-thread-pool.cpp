@@ -0,0 +1,121 @@
+// cpu-thread-pool.cpp
+#include "cpu-thread-pool.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+ThreadPool::ThreadPool(Index threadCount)
+{
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_workers.add(std::thread([this]() { _workerMain(); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_workAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::_runTasks(TaskFunc func, void* context, Index taskCount)
+{
+    while (true)
+    {
+        const Index taskIndex = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (taskIndex >= taskCount)
+        {
+            break;
+        }
+        func(context, taskIndex);
+    }
+}
+
+void ThreadPool::_workerMain()
+{
+    uint64_t lastJobId = 0;
+    while (true)
+    {
+        TaskFunc func;
+        void* context;
+        Index taskCount;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [&]() { return m_quit || m_jobId != lastJobId; });
+            if (m_quit)
+            {
+                return;
+            }
+
+            // Take a copy of the job whilst holding the lock. A new job can't be started until
+            // this worker is no longer active, so the copy stays consistent with m_nextTask.
+            lastJobId = m_jobId;
+            func = m_func;
+            context = m_context;
+            taskCount = m_taskCount;
+            m_activeWorkerCount++;
+        }
+
+        _runTasks(func, context, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_activeWorkerCount == 0)
+            {
+                m_workDone.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::run(Index taskCount, TaskFunc func, void* context)
+{
+    if (taskCount <= 0)
+    {
+        return;
+    }
+
+    // If there isn't anything to run in parallel, just run on this thread
+    if (m_workers.getCount() == 0 || taskCount == 1)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            func(context, i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Workers that woke up late for a previous job may still be draining it
+        m_workDone.wait(lock, [&]() { return m_activeWorkerCount == 0; });
+
+        m_func = func;
+        m_context = context;
+        m_taskCount = taskCount;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_jobId++;
+    }
+    m_workAvailable.notify_all();
+
+    _runTasks(func, context, taskCount);
+
+    // All tasks have been claimed, wait for the workers to complete the ones they hold
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workDone.wait(lock, [&]() { return m_activeWorkerCount == 0; });
+}
+
+} // namespace cpu
+} // namespace gfx
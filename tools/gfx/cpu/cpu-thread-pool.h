@@ -0,0 +1,60 @@
+// cpu-thread-pool.h
+#pragma once
+#include "cpu-base.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+/// A fixed set of worker threads used to execute the tasks of a single job in parallel.
+///
+/// Tasks are not assigned to threads up front. Each participating thread (including the
+/// thread calling `run`) repeatedly claims the next unclaimed task, so threads that finish
+/// early take on the remaining work of slower ones.
+class ThreadPool : public RefObject
+{
+public:
+    typedef void (*TaskFunc)(void* context, Index taskIndex);
+
+        /// Run `func` for each task index in [0, taskCount). Blocks until all tasks have completed.
+        /// The calling thread participates in executing tasks.
+    void run(Index taskCount, TaskFunc func, void* context);
+
+        /// The total number of threads that can execute tasks, including the calling thread.
+    Index getThreadCount() const { return m_workers.getCount() + 1; }
+
+        /// Create a pool with `threadCount` threads in total (including the calling thread).
+    explicit ThreadPool(Index threadCount);
+    ~ThreadPool();
+
+protected:
+    void _workerMain();
+    void _runTasks(TaskFunc func, void* context, Index taskCount);
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+
+    List<std::thread> m_workers;
+
+    // The current job. Only modified with m_mutex held, and when no workers are active.
+    TaskFunc m_func = nullptr;
+    void* m_context = nullptr;
+    Index m_taskCount = 0;
+    uint64_t m_jobId = 0;
+
+    std::atomic<Index> m_nextTask = 0;
+    Index m_activeWorkerCount = 0;
+    bool m_quit = false;
+};
+
+} // namespace cpu
+} // namespace gfx
@@ -203,6 +203,8 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
             fillCommonGraphicsState(meshDesc);
             if (m_device->m_pipelineCreationAPIDispatcher)
             {
+                // The dispatcher is given the Slang program, which it may call into.
+                std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
                 SLANG_RETURN_ON_FAIL(
                     m_device->m_pipelineCreationAPIDispatcher->createMeshPipelineState(
                         m_device,
@@ -261,6 +263,7 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
 
             if (m_device->m_pipelineCreationAPIDispatcher)
             {
+                std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
                 SLANG_RETURN_ON_FAIL(
                     m_device->m_pipelineCreationAPIDispatcher->createGraphicsPipelineState(
                         m_device,
@@ -327,6 +330,7 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
             {
                 if (m_device->m_pipelineCreationAPIDispatcher)
                 {
+                    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
                     SLANG_RETURN_ON_FAIL(
                         m_device->m_pipelineCreationAPIDispatcher->createComputePipelineState(
                             m_device,
@@ -373,6 +377,10 @@ Result RayTracingPipelineStateImpl::ensureAPIPipelineStateCreated()
     if (m_stateObject)
         return SLANG_OK;
 
+    // The entry points are reflected on and compiled below, and the API dispatcher is given
+    // the Slang program, all of which call into the Slang session.
+    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
+
     auto program = static_cast<ShaderProgramImpl*>(m_program.Ptr());
     auto slangGlobalScope = program->linkedProgram;
     auto programLayout = slangGlobalScope->getLayout();
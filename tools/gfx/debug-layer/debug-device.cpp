@@ -36,6 +36,15 @@ SlangResult DebugDevice::queryInterface(SlangUUID const& uuid, void** outObject)
         return SLANG_OK;
     }
 
+    if (uuid == GfxGUID::IID_IPipelineSpecializer)
+    {
+        // Wrap the specializer so that it is handed the inner pipeline objects.
+        RefPtr<DebugPipelineSpecializer> result = new DebugPipelineSpecializer();
+        SLANG_RETURN_ON_FAIL(baseObject->queryInterface(uuid, (void**)result->baseObject.writeRef()));
+        returnComPtr((IPipelineSpecializer**)outObject, result);
+        return SLANG_OK;
+    }
+
     // Fallback to trying to get the interface from the debugged object
     return baseObject->queryInterface(uuid, outObject);
 }
@@ -655,5 +664,31 @@ Result DebugDevice::createShaderTable(const IShaderTable::Desc& desc, IShaderTab
     return SLANG_OK;
 }
 
+Result DebugPipelineSpecializer::getPipelineSpecializationStats(PipelineSpecializationStats* outStats)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->getPipelineSpecializationStats(outStats);
+}
+
+Result DebugPipelineSpecializer::prewarmSpecializedPipelines(
+    const SpecializedPipelineKey* keys, GfxCount keyCount)
+{
+    SLANG_GFX_API_FUNC;
+    List<SpecializedPipelineKey> innerKeys;
+    for (GfxIndex i = 0; i < keyCount; i++)
+    {
+        auto innerKey = keys[i];
+        innerKey.pipeline = getInnerObj(keys[i].pipeline);
+        innerKeys.add(innerKey);
+    }
+    return baseObject->prewarmSpecializedPipelines(innerKeys.getBuffer(), keyCount);
+}
+
+Result DebugPipelineSpecializer::waitForPipelineSpecializations()
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->waitForPipelineSpecializations();
+}
+
 } // namespace debug
 } // namespace gfx
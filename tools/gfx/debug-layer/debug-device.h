@@ -157,5 +157,19 @@ public:
         createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable) override;
 };
 
+class DebugPipelineSpecializer : public DebugObject<IPipelineSpecializer>
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL;
+
+public:
+    IPipelineSpecializer* getInterface(const Slang::Guid& guid);
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        getPipelineSpecializationStats(PipelineSpecializationStats* outStats) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        prewarmSpecializedPipelines(const SpecializedPipelineKey* keys, GfxCount keyCount) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL waitForPipelineSpecializations() override;
+};
+
 } // namespace debug
 } // namespace gfx
@@ -28,6 +28,7 @@ SLANG_GFX_DEBUG_GET_INTERFACE_IMPL(QueryPool)
 SLANG_GFX_DEBUG_GET_INTERFACE_IMPL_PARENT(AccelerationStructure, ResourceView)
 SLANG_GFX_DEBUG_GET_INTERFACE_IMPL(Fence)
 SLANG_GFX_DEBUG_GET_INTERFACE_IMPL(ShaderTable)
+SLANG_GFX_DEBUG_GET_INTERFACE_IMPL(PipelineSpecializer)
 
 String _gfxGetFuncName(const char* input)
 {
@@ -39,6 +39,7 @@ static bool shouldDumpPipeline()
 
 DeviceImpl::~DeviceImpl()
 {
+    shutdownPipelineSpecialization();
 }
 
 Result DeviceImpl::getNativeDeviceHandles(InteropHandles* outHandles)
@@ -682,6 +683,7 @@ Result DeviceImpl::createProgram(
 {
     AUTORELEASEPOOL
 
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
     shaderProgram->init(desc);
 
@@ -188,7 +188,10 @@ Result PipelineStateImpl::createMetalComputePipelineState()
 
     // Query thread group size for use during dispatch.
     SlangUInt threadGroupSize[3];
-    programImpl->linkedProgram->getLayout()->getEntryPointByIndex(0)->getComputeThreadGroupSize(3, threadGroupSize);
+    {
+        std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
+        programImpl->linkedProgram->getLayout()->getEntryPointByIndex(0)->getComputeThreadGroupSize(3, threadGroupSize);
+    }
     m_threadGroupSize = MTL::Size(threadGroupSize[0], threadGroupSize[1], threadGroupSize[2]);
 
     return m_computePipelineState ? SLANG_OK : SLANG_FAIL;
@@ -29,6 +29,7 @@ const Slang::Guid GfxGUID::IID_IBufferResource = SLANG_UUID_IBufferResource;
 const Slang::Guid GfxGUID::IID_ITextureResource = SLANG_UUID_ITextureResource;
 const Slang::Guid GfxGUID::IID_IDevice = SLANG_UUID_IDevice;
 const Slang::Guid GfxGUID::IID_IShaderCache = SLANG_UUID_IShaderCache;
+const Slang::Guid GfxGUID::IID_IPipelineSpecializer = SLANG_UUID_IPipelineSpecializer;
 const Slang::Guid GfxGUID::IID_IShaderObject = SLANG_UUID_IShaderObject;
 
 const Slang::Guid GfxGUID::IID_IRenderPassLayout = SLANG_UUID_IRenderPassLayout;
@@ -339,24 +340,52 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
-    // Immediately call getEntryPointCode if no shader cache has been initialized
-    if (!persistentShaderCache)
+    // Calls into the Slang session are serialized with the specialization worker. The lock is
+    // only held around each call, and not while the shader cache is read or written.
+    PersistentCache::Key cacheKey;
     {
-        return program->getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
-    }
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+
+        // Immediately call getEntryPointCode if the code can't have been generated before.
+        if (!persistentShaderCache && m_pregeneratedEntryPointCode.getCount() == 0)
+        {
+            return program->getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
+        }
 
-    // Hash all relevant state for generating the entry point shader code to use as a key
-    // for the shader cache.
-    ComPtr<ISlangBlob> hashBlob;
-    program->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
-    PersistentCache::Key cacheKey(hashBlob);
+        // Hash all relevant state for generating the entry point shader code to use as a key
+        // for the shader cache.
+        ComPtr<ISlangBlob> hashBlob;
+        program->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
+        cacheKey = PersistentCache::Key(hashBlob);
+
+        // Code generated ahead of time by the pipeline specialization worker takes precedence
+        // over the shader cache.
+        if (auto pregeneratedCode = m_pregeneratedEntryPointCode.tryGetValue(cacheKey))
+        {
+            ComPtr<ISlangBlob> codeBlob = pregeneratedCode->code;
+            *outCode = codeBlob.detach();
+            if (outDiagnostics)
+            {
+                ComPtr<ISlangBlob> diagnosticsBlob = pregeneratedCode->diagnostics;
+                *outDiagnostics = diagnosticsBlob.detach();
+            }
+            return SLANG_OK;
+        }
+        if (!persistentShaderCache)
+        {
+            return program->getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics);
+        }
+    }
 
     // Query the shader cache.
     ComPtr<ISlangBlob> codeBlob;
     if (persistentShaderCache->readEntry(cacheKey, codeBlob.writeRef()) != SLANG_OK)
     {
         // No cached entry found. Generate the code and add it to the cache.
-        SLANG_RETURN_ON_FAIL(program->getEntryPointCode(entryPointIndex, targetIndex, codeBlob.writeRef(), outDiagnostics));
+        {
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+            SLANG_RETURN_ON_FAIL(program->getEntryPointCode(entryPointIndex, targetIndex, codeBlob.writeRef(), outDiagnostics));
+        }
         persistentShaderCache->writeEntry(cacheKey, codeBlob);
     }
 
@@ -373,6 +402,12 @@ SlangResult RendererBase::queryInterface(SlangUUID const& uuid, void** outObject
         addRef();
         return SLANG_OK;
     }
+    if (uuid == GfxGUID::IID_IPipelineSpecializer)
+    {
+        *outObject = static_cast<IPipelineSpecializer*>(this);
+        addRef();
+        return SLANG_OK;
+    }
 
     *outObject = getInterface(uuid);
     return SLANG_OK;
@@ -396,6 +431,33 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
         persistentShaderCache = new PersistentCache(cacheDesc);
     }
 
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        if (stype == StructType::PipelineSpecializationDesc)
+        {
+            m_pipelineSpecializationMode = static_cast<PipelineSpecializationDesc*>(desc.extendedDescs[i])->mode;
+        }
+    }
+    // Compiling in the background relies on pipeline state objects being created lazily,
+    // and on draws and dispatches reporting failure to the caller. The other devices always
+    // specialize on the calling thread.
+    switch (desc.deviceType)
+    {
+    case DeviceType::DirectX12:
+    case DeviceType::Vulkan:
+    case DeviceType::Metal:
+        break;
+    default:
+        m_pipelineSpecializationMode = PipelineSpecializationMode::Synchronous;
+        break;
+    }
+    if (m_pipelineSpecializationMode != PipelineSpecializationMode::Synchronous)
+    {
+        m_specializationWorker = std::thread([this]() { _pipelineSpecializationWorkerMain(); });
+    }
+
     if (desc.apiCommandDispatcher)
     {
         if (desc.deviceType == DeviceType::Vulkan)
@@ -562,6 +624,7 @@ Result RendererBase::createProgram2(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnostic)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
     auto slangSession = slangContext.session.get();
     slang::IModule* module = nullptr;
     ComPtr<slang::IBlob> diagnosticsBlob;
@@ -725,6 +788,7 @@ Result RendererBase::getShaderObjectLayout(
     ShaderObjectContainerType container,
     ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
     switch (container)
     {
     case ShaderObjectContainerType::StructuredBuffer:
@@ -751,6 +815,7 @@ Result RendererBase::getShaderObjectLayout(
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.tryGetValue(typeLayout, shaderObjectLayout))
     {
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
         SLANG_RETURN_ON_FAIL(createShaderObjectLayout(session, typeLayout, shaderObjectLayout.writeRef()));
         m_shaderObjectLayoutCache.add(typeLayout, shaderObjectLayout);
     }
@@ -861,6 +926,11 @@ void ShaderObjectLayoutBase::initBase(RendererBase* renderer, slang::ISession* s
     m_componentID = m_renderer->shaderCache.getComponentId(m_elementTypeLayout->getType());
 }
 
+std::recursive_mutex& ShaderObjectBase::getSlangSessionMutex()
+{
+    return getRenderer()->m_slangSessionMutex;
+}
+
 // Get the final type this shader object represents. If the shader object's type has existential fields,
 // this function will return a specialized type using the bound sub-objects' type as specialization argument.
 Result ShaderObjectBase::getSpecializedShaderObjectType(ExtendedShaderObjectType* outType)
@@ -878,13 +948,29 @@ Result ShaderObjectBase::_getSpecializedShaderObjectType(ExtendedShaderObjectTyp
     {
         shaderObjectType.componentID = getLayoutBase()->getComponentID();
         shaderObjectType.slangType = getLayoutBase()->getElementTypeLayout()->getType();
+        m_specializedTypeArgIDs.clear();
     }
     else
     {
-        shaderObjectType.slangType = getRenderer()->slangContext.session->specializeType(
-            _getElementTypeLayout()->getType(),
-            specializationArgs.components.getArrayView().getBuffer(), specializationArgs.getCount());
-        shaderObjectType.componentID = getRenderer()->shaderCache.getComponentId(shaderObjectType.slangType);
+        // Specializing the type calls into Slang, which may be busy on the specialization
+        // worker, so only do it when the bound sub-objects have changed.
+        bool argsChanged = !shaderObjectType.slangType ||
+            m_specializedTypeArgIDs.getCount() != specializationArgs.getCount();
+        for (Index i = 0; !argsChanged && i < specializationArgs.getCount(); i++)
+        {
+            argsChanged = m_specializedTypeArgIDs[i] != specializationArgs.componentIDs[i];
+        }
+        if (argsChanged)
+        {
+            auto renderer = getRenderer();
+            std::lock_guard<std::recursive_mutex> slangLock(renderer->m_slangSessionMutex);
+            shaderObjectType.slangType = renderer->slangContext.session->specializeType(
+                _getElementTypeLayout()->getType(),
+                specializationArgs.components.getArrayView().getBuffer(), specializationArgs.getCount());
+            shaderObjectType.componentID = renderer->shaderCache.getComponentId(shaderObjectType.slangType);
+            m_specializedTypeArgIDs.clear();
+            m_specializedTypeArgIDs.addRange(specializationArgs.componentIDs);
+        }
     }
     *outType = shaderObjectType;
     return SLANG_OK;
@@ -916,8 +1002,11 @@ Result ShaderObjectBase::setExistentialHeader(
     // fact and error out.
     //
     uint32_t conformanceID = 0xFFFFFFFF;
-    SLANG_RETURN_ON_FAIL(getLayoutBase()->m_slangSession->getTypeConformanceWitnessSequentialID(
-        concreteType, existentialType, &conformanceID));
+    {
+        std::lock_guard<std::recursive_mutex> slangLock(getRenderer()->m_slangSessionMutex);
+        SLANG_RETURN_ON_FAIL(getLayoutBase()->m_slangSession->getTypeConformanceWitnessSequentialID(
+            concreteType, existentialType, &conformanceID));
+    }
     //
     // Once we have the conformance ID, then we can write it into the object
     // at the required offset.
@@ -1028,6 +1117,8 @@ void ShaderProgramBase::init(const IShaderProgram::Desc& inDesc)
 
 Result ShaderProgramBase::compileShaders(RendererBase* device)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(device->m_slangSessionMutex);
+
     // For a fully specialized program, read and store its kernel code in `shaderProgram`.
     auto compileShader = [&](slang::EntryPointReflection* entryPointInfo,
                              slang::IComponentType* entryPointComponent,
@@ -1105,109 +1196,535 @@ bool ShaderProgramBase::isMeshShaderProgram() const
     return false;
 }
 
+static PipelineKey _makePipelineKey(
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& args)
+{
+    PipelineKey pipelineKey;
+    pipelineKey.pipeline = pipeline;
+    pipelineKey.specializationArgs.addRange(args.componentIDs);
+    pipelineKey.updateHash();
+    return pipelineKey;
+}
+
+// The desc of the program `request` creates, which replaces the global scope of the
+// unspecialized program with the specialized one.
+static IShaderProgram::Desc _getSpecializedProgramDesc(PipelineSpecializationRequest* request)
+{
+    IShaderProgram::Desc specializedProgramDesc = request->getUnspecializedProgram()->desc;
+    specializedProgramDesc.slangGlobalScope = request->specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already contains
+        // entry-points, so we do not need to supply them again when creating the specialized
+        // pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    return specializedProgramDesc;
+}
+
+ShaderProgramBase* PipelineSpecializationRequest::getUnspecializedProgram()
+{
+    return unspecializedPipeline->desc.getProgram();
+}
+
 Result RendererBase::maybeSpecializePipeline(
     PipelineStateBase* currentPipeline,
     ShaderObjectBase* rootObject,
     RefPtr<PipelineStateBase>& outNewPipeline)
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
-    
-    auto pipelineType = currentPipeline->desc.type;
+
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound shader objects.
-    if (currentPipeline->isSpecializable)
+    if (!currentPipeline->isSpecializable)
+        return SLANG_OK;
+
+    specializationArgs.clear();
+    SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
+
+    // Construct a shader cache key that represents the specialized shader kernels, and
+    // try to find the specialized pipeline from shader cache.
+    auto pipelineKey = _makePipelineKey(currentPipeline, specializationArgs);
+    if (auto specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey))
     {
-        specializationArgs.clear();
-        SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
+        outNewPipeline = specializedPipelineState;
+        return SLANG_OK;
+    }
 
-        // Construct a shader cache key that represents the specialized shader kernels.
-        PipelineKey pipelineKey;
-        pipelineKey.pipeline = currentPipeline;
-        pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
-        pipelineKey.updateHash();
+    if (m_pipelineSpecializationMode == PipelineSpecializationMode::Synchronous)
+        return _specializePipelineSynchronously(currentPipeline, specializationArgs, outNewPipeline);
 
-        RefPtr<PipelineStateBase> specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
-        // Try to find specialized pipeline from shader cache.
-        if (!specializedPipelineState)
+    auto request = _requestPipelineSpecialization(currentPipeline, specializationArgs, false);
+    const bool wait = m_pipelineSpecializationMode == PipelineSpecializationMode::AsyncWait;
+    auto result = _finishPipelineSpecialization(request, wait, outNewPipeline);
+    if (result != SLANG_E_PENDING)
+        return result;
+
+    // The specialized pipeline is not ready yet.
+    if (m_pipelineSpecializationMode == PipelineSpecializationMode::AsyncFallbackToDynamic)
+    {
+        RefPtr<PipelineStateBase> dynamicPipeline;
+        result = _getDynamicPipeline(currentPipeline, specializationArgs.getCount(), dynamicPipeline);
+        if (SLANG_SUCCEEDED(result))
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
-                ? currentPipeline->desc.compute.program
-                : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
-            {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
-            }
-            SLANG_RETURN_ON_FAIL(compileRs);
+            outNewPipeline = dynamicPipeline;
+            std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+            m_pipelineSpecializationStats.fallbackCount++;
+            return SLANG_OK;
+        }
+        if (result != SLANG_E_PENDING)
+            return result;
+    }
+    std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+    m_pipelineSpecializationStats.skippedCount++;
+    return SLANG_E_PENDING;
+}
 
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
+Result RendererBase::_specializeProgram(PipelineSpecializationRequest* request)
+{
+    auto unspecializedProgram = request->getUnspecializedProgram();
+    return unspecializedProgram->linkedProgram->specialize(
+        request->specializationArgs.components.getArrayView().getBuffer(),
+        request->specializationArgs.getCount(),
+        request->specializedComponentType.writeRef(),
+        request->diagnostics.writeRef());
+}
 
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+void RendererBase::_pregenerateSpecializedCode(PipelineSpecializationRequest* request)
+{
+    // Link the specialized program the same way creating it will, so that the entry points
+    // hash to the same keys.
+    RefPtr<ShaderProgramBase> program = new ShaderProgramBase();
+    List<slang::IComponentType*> entryPointPrograms;
+    List<SlangInt> entryPointIndices;
+    {
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+        program->init(_getSpecializedProgramDesc(request));
+        if (program->linkedEntryPoints.getCount() == 0)
+        {
+            auto entryPointCount = (SlangInt)program->linkedProgram->getLayout()->getEntryPointCount();
+            for (SlangInt i = 0; i < entryPointCount; i++)
             {
-                // When linking style is GraphicsCompute, the specialized global scope already contains
-                // entry-points, so we do not need to supply them again when creating the specialized
-                // pipeline.
-                specializedProgramDesc.entryPointCount = 0;
+                entryPointPrograms.add(program->linkedProgram);
+                entryPointIndices.add(i);
             }
-            SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
-
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
-            {
-            case PipelineType::Compute:
+        }
+        else
+        {
+            for (auto& entryPoint : program->linkedEntryPoints)
             {
-                auto pipelineDesc = currentPipeline->desc.compute;
-                pipelineDesc.program = specializedProgram;
-                SLANG_RETURN_ON_FAIL(
-                    createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
+                entryPointPrograms.add(entryPoint);
+                entryPointIndices.add(0);
             }
-            case PipelineType::Graphics:
+        }
+    }
+
+    // Each entry point is hashed and compiled under its own lock of the Slang session, so that
+    // the thread using the device waits for at most one of them.
+    for (Index i = 0; i < entryPointPrograms.getCount(); i++)
+    {
+        PersistentCache::Key cacheKey;
+        {
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+            ComPtr<ISlangBlob> hashBlob;
+            entryPointPrograms[i]->getEntryPointHash(entryPointIndices[i], 0, hashBlob.writeRef());
+            cacheKey = PersistentCache::Key(hashBlob);
+        }
+
+        // Entry points that fail to compile are left to the calling thread, which reports
+        // the errors when it creates the program.
+        PregeneratedEntryPointCode code;
+        if (SLANG_FAILED(getEntryPointCodeFromShaderCache(
+                entryPointPrograms[i],
+                entryPointIndices[i],
+                0,
+                code.code.writeRef(),
+                code.diagnostics.writeRef())))
+        {
+            continue;
+        }
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+        m_pregeneratedEntryPointCode[cacheKey] = code;
+        request->pregeneratedCodeKeys.add(cacheKey);
+    }
+
+    // Releasing the linked components releases Slang objects the device may share.
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+    entryPointPrograms.clear();
+    program = nullptr;
+}
+
+Result RendererBase::_createPipelineFromSpecializedProgram(
+    PipelineSpecializationRequest* request,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    auto unspecializedPipeline = request->unspecializedPipeline;
+
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    SLANG_RETURN_ON_FAIL(createProgram(_getSpecializedProgramDesc(request), specializedProgram.writeRef()));
+
+    // Create specialized pipeline state.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (unspecializedPipeline->desc.type)
+    {
+    case PipelineType::Compute:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.compute;
+        pipelineDesc.program = specializedProgram;
+        SLANG_RETURN_ON_FAIL(
+            createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::Graphics:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.graphics;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
+            pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::RayTracing:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.rayTracing;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+            pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    default:
+        break;
+    }
+    RefPtr<PipelineStateBase> specializedPipelineState =
+        static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    specializedPipelineState->unspecializedPipelineState = unspecializedPipeline;
+    shaderCache.addSpecializedPipeline(request->key, specializedPipelineState);
+    outPipeline = specializedPipelineState;
+    return SLANG_OK;
+}
+
+Result RendererBase::_createSpecializedPipeline(
+    PipelineSpecializationRequest* request,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    // Report the diagnostics from specializing the program, which may have happened on the
+    // specialization worker.
+    if (request->diagnostics)
+    {
+        getDebugCallback()->handleMessage(
+            SLANG_SUCCEEDED(request->result) ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)request->diagnostics->getBufferPointer());
+        request->diagnostics = nullptr;
+    }
+
+    if (SLANG_SUCCEEDED(request->result))
+    {
+        request->result = _createPipelineFromSpecializedProgram(request, outPipeline);
+    }
+
+    // Code generated ahead of time has either been used by now, or won't be.
+    for (auto& cacheKey : request->pregeneratedCodeKeys)
+    {
+        m_pregeneratedEntryPointCode.remove(cacheKey);
+    }
+    request->pregeneratedCodeKeys.clear();
+
+    std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+    if (SLANG_FAILED(request->result))
+    {
+        if (!request->failureReported)
+        {
+            request->failureReported = true;
+            m_pipelineSpecializationStats.failedCount++;
+        }
+        return request->result;
+    }
+    m_pipelineSpecializationStats.completedCount++;
+    return SLANG_OK;
+}
+
+Result RendererBase::_specializePipelineSynchronously(
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& args,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    RefPtr<PipelineSpecializationRequest> request = new PipelineSpecializationRequest();
+    request->key = _makePipelineKey(pipeline, args);
+    request->unspecializedPipeline = pipeline;
+    request->specializationArgs.addRange(args);
+
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+    request->result = _specializeProgram(request);
+    return _createSpecializedPipeline(request, outPipeline);
+}
+
+PipelineSpecializationRequest* RendererBase::_requestPipelineSpecialization(
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& args,
+    bool isUrgent)
+{
+    auto pipelineKey = _makePipelineKey(pipeline, args);
+    RefPtr<PipelineSpecializationRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+        if (auto existingRequest = m_specializationRequests.tryGetValue(pipelineKey))
+            return *existingRequest;
+
+        request = new PipelineSpecializationRequest();
+        request->key = pipelineKey;
+        request->unspecializedPipeline = pipeline;
+        request->specializationArgs.addRange(args);
+        m_specializationRequests.add(pipelineKey, request);
+
+        if (isUrgent)
+            m_specializationQueue.insert(0, request);
+        else
+            m_specializationQueue.add(request);
+        m_pendingSpecializationCount++;
+    }
+    m_specializationQueued.notify_one();
+    return request;
+}
+
+Result RendererBase::_finishPipelineSpecialization(
+    PipelineSpecializationRequest* request,
+    bool wait,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_specializationQueueMutex);
+        if (wait)
+        {
+            m_specializationCompiled.wait(
+                lock,
+                [&]() { return request->state != PipelineSpecializationRequest::State::Queued; });
+        }
+        else if (request->state == PipelineSpecializationRequest::State::Queued)
+        {
+            return SLANG_E_PENDING;
+        }
+    }
+
+    // Creating the pipeline calls into Slang, which the worker may be busy with compiling
+    // another request.
+    std::unique_lock<std::recursive_mutex> slangLock(m_slangSessionMutex, std::defer_lock);
+    if (wait)
+        slangLock.lock();
+    else if (!slangLock.try_lock())
+        return SLANG_E_PENDING;
+
+    // Keep the request alive once it has been removed from `m_specializationRequests`.
+    RefPtr<PipelineSpecializationRequest> requestRef = request;
+    SLANG_RETURN_ON_FAIL(_createSpecializedPipeline(request, outPipeline));
+    std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+    m_specializationRequests.remove(request->key);
+    return SLANG_OK;
+}
+
+Result RendererBase::_getDynamicPipeline(
+    PipelineStateBase* pipeline,
+    Index argCount,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    if (!m_dynamicType.slangType)
+    {
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+        m_dynamicType.slangType = slangContext.session->getDynamicType();
+        m_dynamicType.componentID = shaderCache.getComponentId(m_dynamicType.slangType);
+    }
+    ExtendedShaderObjectTypeList dynamicArgs;
+    for (Index i = 0; i < argCount; i++)
+    {
+        dynamicArgs.add(m_dynamicType);
+    }
+
+    if (auto dynamicPipeline = shaderCache.getSpecializedPipelineState(_makePipelineKey(pipeline, dynamicArgs)))
+    {
+        outPipeline = dynamicPipeline;
+        return SLANG_OK;
+    }
+
+    // Every specialization of `pipeline` falls back to the same dynamic pipeline, so it is
+    // compiled ahead of the specializations that are already queued.
+    auto request = _requestPipelineSpecialization(pipeline, dynamicArgs, true);
+    return _finishPipelineSpecialization(request, false, outPipeline);
+}
+
+void RendererBase::_pipelineSpecializationWorkerMain()
+{
+    while (true)
+    {
+        // Requests are owned by `m_specializationRequests`, which doesn't release them
+        // while they are queued.
+        PipelineSpecializationRequest* request = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_specializationQueueMutex);
+            m_specializationQueued.wait(
+                lock,
+                [&]() { return m_stopSpecializationWorker || m_specializationQueue.getCount() != 0; });
+            if (m_stopSpecializationWorker)
             {
-                auto pipelineDesc = currentPipeline->desc.graphics;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                    pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
+                return;
             }
-            case PipelineType::RayTracing:
+            request = m_specializationQueue[0];
+            m_specializationQueue.removeAt(0);
+        }
+
+        // The Slang session lock is taken for each call into the session rather than for the
+        // whole request, so that the thread using the device can bind shader objects and
+        // record draws in between.
+        Result result;
+        {
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+            result = _specializeProgram(request);
+        }
+        if (SLANG_SUCCEEDED(result))
+        {
+            _pregenerateSpecializedCode(request);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+            request->result = result;
+            request->state = SLANG_SUCCEEDED(result)
+                ? PipelineSpecializationRequest::State::Compiled
+                : PipelineSpecializationRequest::State::Failed;
+            m_pendingSpecializationCount--;
+        }
+        m_specializationCompiled.notify_all();
+    }
+}
+
+void RendererBase::shutdownPipelineSpecialization()
+{
+    if (m_specializationWorker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+            m_stopSpecializationWorker = true;
+        }
+        m_specializationQueued.notify_all();
+        m_specializationWorker.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+        m_specializationQueue.clear();
+        m_pendingSpecializationCount = 0;
+        m_specializationRequests = decltype(m_specializationRequests)();
+    }
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+    m_pregeneratedEntryPointCode = decltype(m_pregeneratedEntryPointCode)();
+}
+
+RendererBase::~RendererBase()
+{
+    shutdownPipelineSpecialization();
+}
+
+Result RendererBase::getPipelineSpecializationStats(PipelineSpecializationStats* outStats)
+{
+    if (!outStats)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> lock(m_specializationQueueMutex);
+    *outStats = m_pipelineSpecializationStats;
+    outStats->pendingCount = (GfxCount)m_pendingSpecializationCount;
+    return SLANG_OK;
+}
+
+Result RendererBase::prewarmSpecializedPipelines(const SpecializedPipelineKey* keys, GfxCount keyCount)
+{
+    for (GfxIndex i = 0; i < keyCount; i++)
+    {
+        auto pipeline = static_cast<PipelineStateBase*>(keys[i].pipeline);
+        if (!pipeline)
+        {
+            return SLANG_E_INVALID_ARG;
+        }
+        if (pipeline->unspecializedPipelineState)
+            pipeline = pipeline->unspecializedPipelineState;
+        if (!pipeline->isSpecializable)
+            continue;
+
+        ExtendedShaderObjectTypeList args;
+        {
+            // Identifying the types reflects on them.
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
+            for (GfxIndex j = 0; j < keys[i].specializationArgCount; j++)
             {
-                auto pipelineDesc = currentPipeline->desc.rayTracing;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                    pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
-                break;
+                const auto& arg = keys[i].specializationArgs[j];
+                if (arg.kind != slang::SpecializationArg::Kind::Type)
+                {
+                    return SLANG_E_INVALID_ARG;
+                }
+                ExtendedShaderObjectType type;
+                type.slangType = arg.type;
+                type.componentID = shaderCache.getComponentId(arg.type);
+                args.add(type);
             }
-            default:
-                break;
+        }
+
+        if (m_pipelineSpecializationMode == PipelineSpecializationMode::AsyncFallbackToDynamic)
+        {
+            // Queue the dynamic pipeline first, so that draws have something to fall back to
+            // while the specializations are compiled.
+            RefPtr<PipelineStateBase> dynamicPipeline;
+            auto result = _getDynamicPipeline(pipeline, args.getCount(), dynamicPipeline);
+            if (SLANG_FAILED(result) && result != SLANG_E_PENDING)
+            {
+                return result;
             }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
-            shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
         }
-        auto specializedPipelineStateBase = static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+
+        if (shaderCache.getSpecializedPipelineState(_makePipelineKey(pipeline, args)))
+            continue;
+
+        if (m_pipelineSpecializationMode == PipelineSpecializationMode::Synchronous)
+        {
+            RefPtr<PipelineStateBase> specializedPipeline;
+            SLANG_RETURN_ON_FAIL(_specializePipelineSynchronously(pipeline, args, specializedPipeline));
+        }
+        else
+        {
+            _requestPipelineSpecialization(pipeline, args, false);
+        }
     }
     return SLANG_OK;
 }
 
+Result RendererBase::waitForPipelineSpecializations()
+{
+    // Create the pipelines of all compiled requests, so that draws and dispatches find them
+    // in the shader cache. Failures that have already been reported are not reported again.
+    List<RefPtr<PipelineSpecializationRequest>> requests;
+    {
+        std::unique_lock<std::mutex> lock(m_specializationQueueMutex);
+        m_specializationCompiled.wait(lock, [&]() { return m_pendingSpecializationCount == 0; });
+        for (const auto& [_, request] : m_specializationRequests)
+        {
+            requests.add(request);
+        }
+    }
+    Result result = SLANG_OK;
+    for (auto& request : requests)
+    {
+        const bool alreadyFailed = request->failureReported;
+        RefPtr<PipelineStateBase> specializedPipeline;
+        auto requestResult = _finishPipelineSpecialization(request, true, specializedPipeline);
+        if (SLANG_FAILED(requestResult) && !alreadyFailed)
+        {
+            result = requestResult;
+        }
+    }
+    return result;
+}
+
 IDebugCallback*& _getDebugCallback()
 {
     static IDebugCallback* callback = nullptr;
@@ -6,6 +6,10 @@
 #include "core/slang-com-object.h"
 #include "core/slang-persistent-cache.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "resource-desc-utils.h"
 
 namespace gfx
@@ -28,6 +32,7 @@ struct GfxGUID
     static const Slang::Guid IID_IInputLayout;
     static const Slang::Guid IID_IDevice;
     static const Slang::Guid IID_IShaderCache;
+    static const Slang::Guid IID_IPipelineSpecializer;
     static const Slang::Guid IID_IShaderObjectLayout;
     static const Slang::Guid IID_IShaderObject;
     static const Slang::Guid IID_IRenderPassLayout;
@@ -496,6 +501,9 @@ protected:
 
     // The specialized shader object type.
     ExtendedShaderObjectType shaderObjectType = { nullptr, kInvalidComponentID };
+    // The component IDs of the arguments `shaderObjectType` was specialized with, so that the
+    // type is only specialized again when the bound sub-objects change.
+    Slang::ShortList<ShaderComponentID, 16> m_specializedTypeArgIDs;
 
     Result _getSpecializedShaderObjectType(ExtendedShaderObjectType* outType);
     slang::TypeLayoutReflection* _getElementTypeLayout()
@@ -518,6 +526,9 @@ public:
 
     RendererBase* getRenderer() { return m_layout->getDevice(); }
 
+    // The lock on the Slang session of the device, `RendererBase::m_slangSessionMutex`.
+    std::recursive_mutex& getSlangSessionMutex();
+
     ShaderObjectLayoutBase* getLayoutBase() { return m_layout; }
 
     /// Sets the RTTI ID and RTTI witness table fields of an existential value.
@@ -614,6 +625,9 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
         setObject(ShaderOffset const& offset, IShaderObject* object) SLANG_OVERRIDE
     {
+        // Binding an object reflects on the type layouts of both objects, which calls into the
+        // Slang session.
+        std::lock_guard<std::recursive_mutex> slangLock(getSlangSessionMutex());
         auto layout = getLayout();
         auto subObject = static_cast<TShaderObjectImpl*>(object);
         // There are three different cases in `setObject`.
@@ -1143,6 +1157,43 @@ protected:
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
 
+// A specialization of a pipeline that has been requested from the specialization worker, but
+// whose specialized pipeline has not been created yet.
+class PipelineSpecializationRequest : public Slang::RefObject
+{
+public:
+    enum class State
+    {
+        // Waiting for, or being compiled by, the specialization worker.
+        Queued,
+        // The program has been specialized and the code of its entry points generated.
+        Compiled,
+        // Specializing the program or creating the pipeline failed.
+        Failed,
+    };
+
+    PipelineKey key;
+    // Holds `key.pipeline` alive.
+    Slang::RefPtr<PipelineStateBase> unspecializedPipeline;
+    ExtendedShaderObjectTypeList specializationArgs;
+
+    // Only accessed with `RendererBase::m_specializationQueueMutex` held.
+    State state = State::Queued;
+
+    // Written by the thread specializing the program, and only read by other threads once
+    // `state` is no longer `Queued`.
+    Result result = SLANG_OK;
+    Slang::ComPtr<slang::IComponentType> specializedComponentType;
+    Slang::ComPtr<ISlangBlob> diagnostics;
+    // The entry point hashes of the code generated ahead of creating the specialized program.
+    Slang::List<Slang::PersistentCache::Key> pregeneratedCodeKeys;
+
+    // Set once a failure has been reported, so that it is only counted and reported once.
+    bool failureReported = false;
+
+    ShaderProgramBase* getUnspecializedProgram();
+};
+
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
 {
 public:
@@ -1219,7 +1270,7 @@ public:
 
 // Renderer implementation shared by all platforms.
 // Responsible for shader compilation, specialization and caching.
-class RendererBase : public IDevice, public IShaderCache, public Slang::ComObject
+class RendererBase : public IDevice, public IShaderCache, public IPipelineSpecializer, public Slang::ComObject
 {
     friend class ShaderObjectBase;
 public:
@@ -1332,6 +1383,9 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
 
+    // Gets the code of an entry point. All backends go through here, so that code generated
+    // ahead of time by the pipeline specialization worker and the shader cache are used
+    // before any code is generated.
     Result getEntryPointCodeFromShaderCache(
         slang::IComponentType* program,
         SlangInt entryPointIndex,
@@ -1355,11 +1409,57 @@ public:
     // Given current pipeline and root shader object binding, generate and bind a specialized pipeline if necessary.
     // The newly specialized pipeline is held alive by the pipeline cache so users of `outNewPipeline` do not
     // need to maintain its lifespan.
+    // In `PipelineSpecializationMode::AsyncSkip` mode, returns `SLANG_E_PENDING` if the specialized
+    // pipeline is not ready yet.
     Result maybeSpecializePipeline(
         PipelineStateBase* currentPipeline,
         ShaderObjectBase* rootObject,
         Slang::RefPtr<PipelineStateBase>& outNewPipeline);
 
+    // Stops the specialization worker and releases all pending requests. Devices that support
+    // asynchronous specialization must call this before destroying any of their API state.
+    void shutdownPipelineSpecialization();
+
+protected:
+    // Specializes the program of `request->unspecializedPipeline`. Requires `m_slangSessionMutex`.
+    Result _specializeProgram(PipelineSpecializationRequest* request);
+    // Generates the code for the entry points of the specialized program, so that creating the
+    // program on the calling thread doesn't have to. Locks `m_slangSessionMutex` around each
+    // call into Slang.
+    void _pregenerateSpecializedCode(PipelineSpecializationRequest* request);
+    // Creates the specialized pipeline from a specialized program, and adds it to `shaderCache`.
+    // Requires `m_slangSessionMutex`.
+    Result _createSpecializedPipeline(
+        PipelineSpecializationRequest* request,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    // Specializes `pipeline` on the calling thread.
+    Result _specializePipelineSynchronously(
+        PipelineStateBase* pipeline,
+        const ExtendedShaderObjectTypeList& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    // Finds the request for specializing `pipeline` with `args`, or queues a new one.
+    PipelineSpecializationRequest* _requestPipelineSpecialization(
+        PipelineStateBase* pipeline,
+        const ExtendedShaderObjectTypeList& args,
+        bool isUrgent);
+    // Creates the pipeline of a request once it has been compiled. Returns `SLANG_E_PENDING`
+    // if the request is not ready, unless `wait` is set.
+    Result _finishPipelineSpecialization(
+        PipelineSpecializationRequest* request,
+        bool wait,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    Result _createPipelineFromSpecializedProgram(
+        PipelineSpecializationRequest* request,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    // Gets the pipeline that `pipeline` falls back to while a specialization is pending.
+    Result _getDynamicPipeline(
+        PipelineStateBase* pipeline,
+        Slang::Index argCount,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    void _pipelineSpecializationWorkerMain();
+
+public:
+
 
     virtual Result createShaderObjectLayout(
         slang::ISession* session,
@@ -1380,6 +1480,15 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getShaderCacheStats(ShaderCacheStats* outStats) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW Result SLANG_MCALL resetShaderCacheStats() SLANG_OVERRIDE;
 
+    // IPipelineSpecializer interface
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        getPipelineSpecializationStats(PipelineSpecializationStats* outStats) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        prewarmSpecializedPipelines(const SpecializedPipelineKey* keys, GfxCount keyCount) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW Result SLANG_MCALL waitForPipelineSpecializations() SLANG_OVERRIDE;
+
+    ~RendererBase();
+
 protected:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc);
 protected:
@@ -1392,6 +1501,44 @@ public:
 
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>> m_shaderObjectLayoutCache;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
+
+    // Serializes the calls gfx makes into Slang, which may come from the specialization worker
+    // as well as from the thread using the device. Every gfx path that calls into the session,
+    // including reflection of the layouts it owns, holds it. The worker holds it for one call
+    // at a time, so the thread using the device waits for at most one specialization or one
+    // entry point to be compiled, rather than for a whole pipeline.
+    std::recursive_mutex m_slangSessionMutex;
+
+    PipelineSpecializationMode m_pipelineSpecializationMode = PipelineSpecializationMode::Synchronous;
+    // `pendingCount` is tracked by `m_pendingSpecializationCount` instead. Only accessed with
+    // `m_specializationQueueMutex` held.
+    PipelineSpecializationStats m_pipelineSpecializationStats = {};
+    // The `__Dynamic` type that dynamic pipelines are specialized with, created on first use.
+    ExtendedShaderObjectType m_dynamicType = { nullptr, kInvalidComponentID };
+
+    // Specializations queued on the worker whose pipelines have not been created yet. Failed
+    // requests are kept so that they are not compiled again on every draw. Only accessed with
+    // `m_specializationQueueMutex` held.
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PipelineSpecializationRequest>> m_specializationRequests;
+
+    // Protects the queue, the requests and their state, `m_pendingSpecializationCount` and
+    // `m_pipelineSpecializationStats`. Never held while locking `m_slangSessionMutex`.
+    std::mutex m_specializationQueueMutex;
+    std::condition_variable m_specializationQueued;
+    std::condition_variable m_specializationCompiled;
+    Slang::List<PipelineSpecializationRequest*> m_specializationQueue;
+    Slang::Index m_pendingSpecializationCount = 0;
+    bool m_stopSpecializationWorker = false;
+    std::thread m_specializationWorker;
+
+    struct PregeneratedEntryPointCode
+    {
+        Slang::ComPtr<ISlangBlob> code;
+        Slang::ComPtr<ISlangBlob> diagnostics;
+    };
+    // Entry point code generated by the specialization worker, by entry point hash. Only
+    // accessed with `m_slangSessionMutex` held.
+    Slang::Dictionary<Slang::PersistentCache::Key, PregeneratedEntryPointCode> m_pregeneratedEntryPointCode;
 };
 
 bool isDepthFormat(Format format);
@@ -1439,6 +1586,7 @@ void ShaderObjectBaseImpl<TShaderObjectImpl, TShaderObjectLayoutImpl, TShaderObj
             if (m_structuredBufferSpecializationArgs[i].componentID !=
                 specializationArgs[i].componentID)
             {
+                std::lock_guard<std::recursive_mutex> slangLock(device->m_slangSessionMutex);
                 auto dynamicType = device->slangContext.session->getDynamicType();
                 m_structuredBufferSpecializationArgs.componentIDs[i] =
                     device->shaderCache.getComponentId(dynamicType);
@@ -1457,6 +1605,8 @@ Result ShaderObjectBaseImpl<TShaderObjectImpl, TShaderObjectLayoutImpl, TShaderO
     uint32_t count)
 {
     auto device = getRenderer();
+    // Identifying the types reflects on them.
+    std::lock_guard<std::recursive_mutex> slangLock(device->m_slangSessionMutex);
     for (uint32_t i = 0; i < count; i++)
     {
         gfx::ExtendedShaderObjectType extendedType;
@@ -1574,6 +1724,7 @@ Result ShaderObjectBaseImpl<TShaderObjectImpl, TShaderObjectLayoutImpl, TShaderO
                 {
                     if (args[i + oldArgsCount].componentID != typeArgs[i].componentID)
                     {
+                        std::lock_guard<std::recursive_mutex> slangLock(device->m_slangSessionMutex);
                         auto dynamicType = device->slangContext.session->getDynamicType();
                         args.componentIDs[i + oldArgsCount] =
                             device->shaderCache.getComponentId(dynamicType);
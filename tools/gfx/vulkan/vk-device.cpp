@@ -44,6 +44,8 @@ static bool shouldDumpPipeline()
 
 DeviceImpl::~DeviceImpl()
 {
+    shutdownPipelineSpecialization();
+
     if (shouldDumpPipeline())
     {
         writePipelineDump(toSlice("gfx-vk-pipeline-dump.bin"));
@@ -2382,6 +2384,7 @@ Result DeviceImpl::createInputLayout(IInputLayout::Desc const& desc, IInputLayou
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangSessionMutex);
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
     shaderProgram->init(desc);
 
@@ -275,6 +275,8 @@ Result PipelineStateImpl::createVKGraphicsPipelineState()
 
     if (m_device->m_pipelineCreationAPIDispatcher)
     {
+        // The dispatcher is given the Slang program, which it may call into.
+        std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
         SLANG_RETURN_ON_FAIL(
             m_device->m_pipelineCreationAPIDispatcher->createGraphicsPipelineState(
                 m_device,
@@ -306,6 +308,7 @@ Result PipelineStateImpl::createVKComputePipelineState()
 
     if (m_device->m_pipelineCreationAPIDispatcher)
     {
+        std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
         SLANG_RETURN_ON_FAIL(
             m_device->m_pipelineCreationAPIDispatcher->createComputePipelineState(
                 m_device,
@@ -450,6 +453,7 @@ Result RayTracingPipelineStateImpl::createVKRayTracingPipelineState()
 
     if (m_device->m_pipelineCreationAPIDispatcher)
     {
+        std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
         m_device->m_pipelineCreationAPIDispatcher->beforeCreateRayTracingState(
             m_device, programImpl->linkedProgram.get());
     }
@@ -467,6 +471,7 @@ Result RayTracingPipelineStateImpl::createVKRayTracingPipelineState()
 
     if (m_device->m_pipelineCreationAPIDispatcher)
     {
+        std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangSessionMutex);
         m_device->m_pipelineCreationAPIDispatcher->afterCreateRayTracingState(
             m_device, programImpl->linkedProgram.get());
     }
@@ -1176,6 +1176,9 @@ Result RootShaderObjectImpl::init(IDevice* device, RootShaderObjectLayout* layou
 
 Result RootShaderObjectImpl::_createSpecializedLayout(ShaderObjectLayoutImpl** outLayout)
 {
+    // Specializing the program and reflecting on its layout call into the Slang session.
+    std::lock_guard<std::recursive_mutex> slangLock(getSlangSessionMutex());
+
     ExtendedShaderObjectTypeList specializationArgs;
     SLANG_RETURN_ON_FAIL(collectSpecializationArgs(specializationArgs));
 
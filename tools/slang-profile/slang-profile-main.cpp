@@ -9,12 +9,68 @@
 
 #include "../../source/core/slang-string-util.h"
 
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-name.h"
+
 using namespace Slang;
 
+// Time lexing all of the tokens in each of the files at `paths`
+static SlangResult _profileLexer(const List<String>& paths)
+{
+    const Int kRepeatCount = 32;
+
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    for (const auto& path : paths)
+    {
+        String contents;
+        SLANG_RETURN_ON_FAIL(File::readAllText(path, contents));
+
+        Index tokenCount = 0;
+        const auto startTick = Process::getClockTick();
+
+        for (Int i = 0; i < kRepeatCount; ++i)
+        {
+            SourceManager sourceManager;
+            sourceManager.initialize(nullptr, nullptr);
+            DiagnosticSink sink(&sourceManager, nullptr);
+
+            SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makePath(path), contents);
+            SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+            Lexer lexer;
+            lexer.initialize(sourceView, &sink, &namePool, sourceManager.getMemoryArena());
+            tokenCount = lexer.lexAllMarkupTokens().m_tokens.getCount();
+        }
+
+        const auto endTick = Process::getClockTick();
+        const double seconds = double(endTick - startTick) / Process::getClockFrequency();
+        const double megabytes = double(contents.getLength()) * kRepeatCount / (1024.0 * 1024.0);
+
+        printf("%s: %d tokens, %f s, %f MB/s\n", path.getBuffer(), int(tokenCount), seconds, megabytes / seconds);
+    }
+    return SLANG_OK;
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
 
+    // `-lex <files>` times the lexer on the given source files
+    if (argc >= 2 && UnownedStringSlice(argv[1]) == "-lex")
+    {
+        List<String> paths;
+        for (int i = 2; i < argc; ++i)
+        {
+            paths.add(argv[i]);
+        }
+        return _profileLexer(paths);
+    }
+
     // Time the creation of the session
     {
         const auto startTick = Process::getClockTick();
@@ -0,0 +1,107 @@
+// unit-test-downstream-cache.cpp
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const char kShaderSource[] = R"(
+    RWStructuredBuffer<float> values;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        values[dispatchThreadID.x] = values[dispatchThreadID.x] * VALUE_SCALE;
+    }
+)";
+
+// Compiles the shader to SPIR-V through glslang, using the downstream cache in `cacheDirectory`.
+// `valueScale` is passed as a define, so changing it changes the GLSL given to glslang.
+static void _compile(
+    slang::IGlobalSession* globalSession,
+    const String& cacheDirectory,
+    const char* valueScale,
+    ComPtr<ISlangBlob>& outCode,
+    String& outDiagnostics)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileRequest(request.writeRef())));
+
+    const char* args[] =
+    {
+        "-target", "spirv",
+        "-emit-spirv-via-glsl",
+        "-report-downstream-time",
+        "-downstream-cache", cacheDirectory.getBuffer(),
+    };
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+    request->addPreprocessorDefine("VALUE_SCALE", valueScale);
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "downstream-cache.slang", kShaderSource);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->getEntryPointCodeBlob(0, 0, outCode.writeRef())));
+
+    const char* diagnosticText = request->getDiagnosticOutput();
+    outDiagnostics = diagnosticText ? diagnosticText : "";
+}
+
+static bool _isSameBlob(ISlangBlob* a, ISlangBlob* b)
+{
+    return a->getBufferSize() == b->getBufferSize() &&
+        ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+} // anonymous
+
+SLANG_UNIT_TEST(downstreamCache)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_GLSLANG)))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    // Start from an empty cache
+    String temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::getPrivateTemporaryDirectory(toSlice("slang-unit-test"), temporaryDirectory)));
+    const String cacheDirectory = Path::combine(temporaryDirectory, "downstream-cache");
+    Path::removeRecursive(cacheDirectory);
+
+    const auto missText = toSlice("downstream cache: 0 hits, 1 misses");
+    const auto hitText = toSlice("downstream cache: 1 hits, 0 misses");
+
+    ComPtr<ISlangBlob> firstCode;
+    String firstDiagnostics;
+    _compile(globalSession, cacheDirectory, "2.0", firstCode, firstDiagnostics);
+    SLANG_CHECK(firstDiagnostics.indexOf(missText) >= 0);
+
+    // The same compilation again is a hit, and produces the same code
+    ComPtr<ISlangBlob> secondCode;
+    String secondDiagnostics;
+    _compile(globalSession, cacheDirectory, "2.0", secondCode, secondDiagnostics);
+    SLANG_CHECK(secondDiagnostics.indexOf(hitText) >= 0);
+    SLANG_CHECK(_isSameBlob(firstCode, secondCode));
+
+    // Changing the source passed to the downstream compiler changes the key
+    ComPtr<ISlangBlob> changedCode;
+    String changedDiagnostics;
+    _compile(globalSession, cacheDirectory, "3.0", changedCode, changedDiagnostics);
+    SLANG_CHECK(changedDiagnostics.indexOf(missText) >= 0);
+    SLANG_CHECK(!_isSameBlob(firstCode, changedCode));
+
+    Path::removeRecursive(cacheDirectory);
+}
@@ -0,0 +1,139 @@
+// unit-test-flat-reflection.cpp
+
+#include "slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct FlatReflectionView
+{
+    template<typename T>
+    const T& get(const SlangFlatReflectionTable& table, uint32_t index) const
+    {
+        SLANG_ASSERT(index < table.count);
+        return ((const T*)(data + table.offset))[index];
+    }
+
+    UnownedStringSlice getString(uint32_t offset) const
+    {
+        if (offset == SLANG_FLAT_REFLECTION_INVALID_INDEX)
+            return UnownedStringSlice();
+        return UnownedStringSlice((const char*)data + header->strings.offset + offset);
+    }
+
+    const SlangFlatReflectionVarLayout& getVarLayout(uint32_t index) const { return get<SlangFlatReflectionVarLayout>(header->varLayouts, index); }
+    const SlangFlatReflectionTypeLayout& getTypeLayout(uint32_t index) const { return get<SlangFlatReflectionTypeLayout>(header->typeLayouts, index); }
+
+    const SlangFlatReflectionOffset* findOffset(const SlangFlatReflectionVarLayout& varLayout, SlangParameterCategory category) const
+    {
+        for (uint32_t i = 0; i < varLayout.offsetCount; ++i)
+        {
+            const auto& offset = get<SlangFlatReflectionOffset>(header->offsets, varLayout.firstOffset + i);
+            if (offset.category == uint32_t(category))
+                return &offset;
+        }
+        return nullptr;
+    }
+
+    const uint8_t* data = nullptr;
+    const SlangFlatReflectionHeader* header = nullptr;
+};
+
+} // anonymous
+
+SLANG_UNIT_TEST(flatReflection)
+{
+    const char* userSourceBody = R"(
+        struct Params
+        {
+            float4 color;
+            float scale;
+        };
+        ConstantBuffer<Params> params;
+        RWStructuredBuffer<float> output;
+
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            output[tid.x] = params.color.x * params.scale;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString("m", "m.slang", userSourceBody, diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint("computeMain", SLANG_STAGE_COMPUTE, entryPoint.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK(session->createCompositeComponentType(components, 2, program.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+
+    auto layout = program->getLayout();
+    SLANG_CHECK(layout != nullptr);
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(layout->writeFlatBinary(blob.writeRef()) == SLANG_OK);
+    SLANG_CHECK(blob->getBufferSize() >= sizeof(SlangFlatReflectionHeader));
+
+    FlatReflectionView view;
+    view.data = (const uint8_t*)blob->getBufferPointer();
+    view.header = (const SlangFlatReflectionHeader*)view.data;
+    SLANG_CHECK(view.header->magic == SLANG_FLAT_REFLECTION_MAGIC);
+    SLANG_CHECK(view.header->version == SLANG_FLAT_REFLECTION_VERSION);
+    SLANG_CHECK(view.header->size == blob->getBufferSize());
+
+    // The global parameters match the ones found through the reflection API
+    SLANG_CHECK(view.header->parameterCount == layout->getParameterCount());
+    SLANG_CHECK(view.header->parameterCount == 2);
+
+    const auto& paramsVar = view.getVarLayout(view.header->firstParameter);
+    SLANG_CHECK(view.getString(paramsVar.name) == "params");
+    const auto& paramsType = view.getTypeLayout(paramsVar.typeLayout);
+    SLANG_CHECK(paramsType.kind == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+
+    // Fields of the constant buffer's element type, with their uniform offsets
+    const auto& elementType = view.getTypeLayout(paramsType.elementTypeLayout);
+    SLANG_CHECK(elementType.kind == SLANG_TYPE_KIND_STRUCT);
+    SLANG_CHECK(elementType.fieldCount == 2);
+    const auto& scaleVar = view.getVarLayout(elementType.firstField + 1);
+    SLANG_CHECK(view.getString(scaleVar.name) == "scale");
+    auto scaleOffset = view.findOffset(scaleVar, SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(scaleOffset && scaleOffset->offset == 16);
+
+    const auto& outputVar = view.getVarLayout(view.header->firstParameter + 1);
+    SLANG_CHECK(view.getString(outputVar.name) == "output");
+    auto outputOffset = view.findOffset(outputVar, SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS);
+    SLANG_CHECK(outputOffset && outputOffset->offset == layout->getParameterByIndex(1)->getBindingIndex());
+
+    // The entry point and its thread group size
+    SLANG_CHECK(view.header->entryPoints.count == 1);
+    const auto& entryPointEntry = view.get<SlangFlatReflectionEntryPoint>(view.header->entryPoints, 0);
+    SLANG_CHECK(view.getString(entryPointEntry.name) == "computeMain");
+    SLANG_CHECK(entryPointEntry.stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(entryPointEntry.threadGroupSize[0] == 8 && entryPointEntry.threadGroupSize[1] == 4 && entryPointEntry.threadGroupSize[2] == 1);
+
+    // Writing the same layout again gives an identical blob
+    ComPtr<ISlangBlob> otherBlob;
+    SLANG_CHECK(layout->writeFlatBinary(otherBlob.writeRef()) == SLANG_OK);
+    SLANG_CHECK(otherBlob->getBufferSize() == blob->getBufferSize());
+    SLANG_CHECK(::memcmp(otherBlob->getBufferPointer(), blob->getBufferPointer(), blob->getBufferSize()) == 0);
+}
@@ -0,0 +1,109 @@
+// unit-test-gcc-compiler-util.cpp
+
+#include "../../source/compiler-core/slang-gcc-compiler-util.h"
+#include "../../source/compiler-core/slang-artifact-associated.h"
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-slice-allocator.h"
+
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-io.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static bool _hasArg(const CommandLine& cmdLine, const char* arg)
+{
+    for (const auto& cmdLineArg : cmdLine.m_args)
+    {
+        if (cmdLineArg == arg)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+SLANG_UNIT_TEST(gccCompilerSpecificArguments)
+{
+    // Compiler specific arguments are passed through to gcc and clang, as they are for the
+    // other downstream compilers. The precompiled prelude relies on this to add `-include`.
+    TerminatedCharSlice compilerSpecificArguments[] =
+    {
+        TerminatedCharSlice("-include"),
+        TerminatedCharSlice("prelude.h"),
+    };
+
+    DownstreamCompileOptions options;
+    options.targetType = SLANG_SHADER_SHARED_LIBRARY;
+    options.modulePath = TerminatedCharSlice("module");
+    options.compilerSpecificArguments = makeSlice(compilerSpecificArguments, SLANG_COUNT_OF(compilerSpecificArguments));
+
+    CommandLine cmdLine;
+    SLANG_CHECK(SLANG_SUCCEEDED(GCCDownstreamCompilerUtil::calcArgs(options, cmdLine)));
+    SLANG_CHECK(_hasArg(cmdLine, "-include"));
+    SLANG_CHECK(_hasArg(cmdLine, "prelude.h"));
+}
+
+SLANG_UNIT_TEST(gccPrecompiledPrelude)
+{
+    ComPtr<IDownstreamCompiler> compiler;
+    if (SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(ExecutableLocation("g++"), compiler)))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    // The prelude is 3 lines, so the error in the source is on line 5
+    const char prelude[] =
+        "inline int preludeValue()\n"
+        "{ return 42; }\n"
+        "\n";
+    const String source = String(prelude) +
+        "int sourceValue() { return preludeValue(); }\n"
+        "int brokenValue() { return undefinedValue; }\n";
+
+    String moduleDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::getPrivateTemporaryDirectory(toSlice("slang-unit-test"), moduleDirectory)));
+    const String modulePath = Path::combine(moduleDirectory, "gcc-precompiled-prelude");
+
+    // Compile twice, so the second compilation uses the precompiled header produced by the first
+    for (Index i = 0; i < 2; ++i)
+    {
+        auto sourceArtifact = ArtifactUtil::createArtifact(
+            ArtifactDescUtil::makeDescForSourceLanguage(SLANG_SOURCE_LANGUAGE_CPP), "precompiled-prelude-test.cpp");
+        sourceArtifact->addRepresentationUnknown(StringBlob::create(source));
+
+        DownstreamCompileOptions options;
+        options.targetType = SLANG_OBJECT_CODE;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
+        options.modulePath = SliceUtil::asTerminatedCharSlice(modulePath);
+        options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+        options.sourcePrelude = TerminatedCharSlice(prelude);
+
+        ComPtr<IArtifact> artifact;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(compiler->compile(options, artifact.writeRef())));
+
+        auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
+        SLANG_CHECK_ABORT(diagnostics);
+        SLANG_CHECK(SLANG_FAILED(diagnostics->getResult()));
+
+        // The only error is the undefined value. The prelude must have been seen, and the error is
+        // reported against the name and line it has in the original source. (If the precompiled
+        // header can't be used, the source is compiled as is from a file named after it.)
+        Count errorCount = 0;
+        for (Index j = 0; j < diagnostics->getCount(); ++j)
+        {
+            const auto diagnostic = diagnostics->getAt(j);
+            if (diagnostic->severity != ArtifactDiagnostic::Severity::Error)
+            {
+                continue;
+            }
+            ++errorCount;
+            SLANG_CHECK(asStringSlice(diagnostic->text).indexOf(toSlice("undefinedValue")) >= 0);
+            SLANG_CHECK(asStringSlice(diagnostic->filePath).indexOf(toSlice("precompiled-prelude-test.cpp")) >= 0);
+            SLANG_CHECK(diagnostic->location.line == 5);
+        }
+        SLANG_CHECK(errorCount == 1);
+    }
+}
@@ -0,0 +1,98 @@
+// unit-test-lexer.cpp
+
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/core/slang-memory-arena.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct Element
+{
+    TokenType type;
+    const char* content;
+};
+
+} // anonymous
+
+static bool _checkLex(const char* in, const Element* elements, Index elementCount)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    MemoryArena memoryArena(4096);
+
+    SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), String(in));
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, nullptr, &memoryArena);
+
+    // Comments are kept, whitespace and newlines are not
+    TokenList tokens = lexer.lexAllMarkupTokens();
+
+    // The token list is terminated by an EndOfFile token
+    if (tokens.m_tokens.getCount() != elementCount + 1)
+    {
+        return false;
+    }
+
+    for (Index i = 0; i < elementCount; ++i)
+    {
+        const Token& token = tokens.m_tokens[i];
+        if (token.type != elements[i].type ||
+            token.getContent() != UnownedStringSlice(elements[i].content))
+        {
+            return false;
+        }
+    }
+    return tokens.m_tokens.getLast().type == TokenType::EndOfFile;
+}
+
+SLANG_UNIT_TEST(lexer)
+{
+    {
+        const Element elements[] = { { TokenType::Identifier, "abc_DEF12" }, { TokenType::Identifier, "xyz" } };
+        SLANG_CHECK(_checkLex("abc_DEF12 \t  xyz", elements, SLANG_COUNT_OF(elements)));
+    }
+
+    // Escaped newline in the middle of an identifier
+    {
+        const Element elements[] = { { TokenType::Identifier, "abcd" }, { TokenType::Identifier, "ef" } };
+        SLANG_CHECK(_checkLex("ab\\\ncd ef", elements, SLANG_COUNT_OF(elements)));
+    }
+
+    // Line comment continued onto the next line by an escaped newline
+    {
+        const Element elements[] = {
+            { TokenType::LineComment, "// a comment that is long enough to be scanned in blocks, and continued  onto the next line" },
+            { TokenType::Identifier, "x" } };
+        SLANG_CHECK(_checkLex("// a comment that is long enough to be scanned in blocks, and continued \\\r\n onto the next line\nx", elements, SLANG_COUNT_OF(elements)));
+    }
+
+    // Line comment holding non-ASCII characters
+    {
+        const Element elements[] = { { TokenType::LineComment, "// caf\xC3\xA9 \xE2\x82\xAC" }, { TokenType::Identifier, "w" } };
+        SLANG_CHECK(_checkLex("// caf\xC3\xA9 \xE2\x82\xAC\r\nw", elements, SLANG_COUNT_OF(elements)));
+    }
+
+    // Block comments, including one whose end is split by an escaped newline
+    {
+        const Element elements[] = {
+            { TokenType::BlockComment, "/* a block comment ** with stars\n  spread over more than one line */" },
+            { TokenType::Identifier, "y" },
+            { TokenType::BlockComment, "/* split end */" },
+            { TokenType::Identifier, "z" } };
+        SLANG_CHECK(_checkLex("/* a block comment ** with stars\n  spread over more than one line */y /* split end *\\\n/z", elements, SLANG_COUNT_OF(elements)));
+    }
+
+    // Unterminated block comment runs to the end of the input
+    {
+        const Element elements[] = { { TokenType::BlockComment, "/* this comment is never closed *" } };
+        SLANG_CHECK(_checkLex("/* this comment is never closed *", elements, SLANG_COUNT_OF(elements)));
+    }
+}
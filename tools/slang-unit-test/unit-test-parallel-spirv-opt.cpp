@@ -0,0 +1,254 @@
+// unit-test-parallel-spirv-opt.cpp
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-shared-library.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-downstream-compiler-set.h"
+#include "../../source/compiler-core/slang-glslang-compiler.h"
+
+#include <thread>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const char kShaderSource[] = R"(
+    RWStructuredBuffer<float> values;
+
+    float accumulate(uint count)
+    {
+        float sum = 0.0f;
+        for (uint i = 0; i < count; ++i)
+        {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void sumMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        values[dispatchThreadID.x] = accumulate(dispatchThreadID.x);
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void scaleMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        values[dispatchThreadID.x] = values[dispatchThreadID.x] * 2.0f + 1.0f;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void copyMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        values[dispatchThreadID.x + 4] = values[dispatchThreadID.x];
+    }
+)";
+
+static const char* const kEntryPointNames[] = { "sumMain", "scaleMain", "copyMain" };
+
+// Compiles every entry point to SPIR-V, optionally running spirv-opt for them concurrently, and
+// reporting the time of each spirv-opt pass.
+static void _compile(
+    slang::IGlobalSession* globalSession,
+    bool isParallel,
+    bool reportPassTimes,
+    List<ComPtr<ISlangBlob>>& outCode,
+    String& outDiagnostics)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileRequest(request.writeRef())));
+
+    List<const char*> args;
+    args.add("-target");
+    args.add("spirv");
+    if (isParallel)
+    {
+        args.add("-parallel-spirv-opt");
+    }
+    if (reportPassTimes)
+    {
+        args.add("-report-downstream-pass-time");
+    }
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->processCommandLineArguments(args.getBuffer(), int(args.getCount()))));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "parallel-spirv-opt.slang", kShaderSource);
+    for (auto entryPointName : kEntryPointNames)
+    {
+        request->addEntryPoint(translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+    outCode.clear();
+    for (Index i = 0; i < SLANG_COUNT_OF(kEntryPointNames); ++i)
+    {
+        ComPtr<ISlangBlob> code;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->getEntryPointCodeBlob(int(i), 0, code.writeRef())));
+        outCode.add(code);
+    }
+
+    const char* diagnosticText = request->getDiagnosticOutput();
+    outDiagnostics = diagnosticText ? diagnosticText : "";
+}
+
+static bool _isSameBlob(ISlangBlob* a, ISlangBlob* b)
+{
+    return a->getBufferSize() == b->getBufferSize() &&
+        ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+// The number of spirv-opt passes reported in `diagnostics`
+static Count _countPassTimeReports(const String& diagnostics)
+{
+    const char* passText = "spirv-opt pass ";
+    Count count = 0;
+    for (Index index = diagnostics.indexOf(passText); index >= 0; index = diagnostics.indexOf(passText, index + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+} // anonymous
+
+SLANG_UNIT_TEST(parallelSPIRVOptimization)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_SPIRV_OPT)))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    // Running spirv-opt concurrently produces exactly the same code as running it serially
+    List<ComPtr<ISlangBlob>> serialCode;
+    String serialDiagnostics;
+    _compile(globalSession, false, false, serialCode, serialDiagnostics);
+
+    List<ComPtr<ISlangBlob>> parallelCode;
+    String parallelDiagnostics;
+    _compile(globalSession, true, false, parallelCode, parallelDiagnostics);
+
+    for (Index i = 0; i < serialCode.getCount(); ++i)
+    {
+        SLANG_CHECK(_isSameBlob(serialCode[i], parallelCode[i]));
+    }
+    SLANG_CHECK(serialDiagnostics == parallelDiagnostics);
+
+    // Reporting pass times doesn't change the code, and each entry point's passes are reported
+    // on both paths.
+    List<ComPtr<ISlangBlob>> serialTimedCode;
+    String serialTimedDiagnostics;
+    _compile(globalSession, false, true, serialTimedCode, serialTimedDiagnostics);
+
+    List<ComPtr<ISlangBlob>> parallelTimedCode;
+    String parallelTimedDiagnostics;
+    _compile(globalSession, true, true, parallelTimedCode, parallelTimedDiagnostics);
+
+    for (Index i = 0; i < serialCode.getCount(); ++i)
+    {
+        SLANG_CHECK(_isSameBlob(serialCode[i], serialTimedCode[i]));
+        SLANG_CHECK(_isSameBlob(serialCode[i], parallelTimedCode[i]));
+    }
+
+    const Count passCount = _countPassTimeReports(serialTimedDiagnostics);
+    SLANG_CHECK(passCount > 0);
+    SLANG_CHECK(_countPassTimeReports(parallelTimedDiagnostics) == passCount);
+}
+
+SLANG_UNIT_TEST(spirvOptConcurrentCompile)
+{
+    // The batched optimizations only call spirv-opt from several threads at once because it allows
+    // that (see `_canCompileConcurrently`). Check that calling it concurrently on the same compiler
+    // gives the same results as calling it serially.
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_SPIRV_OPT)))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    RefPtr<DownstreamCompilerSet> compilerSet = new DownstreamCompilerSet;
+    SpirvOptDownstreamCompilerUtil::locateCompilers(
+        unitTestContext->executableDirectory,
+        DefaultSharedLibraryLoader::getSingleton(),
+        compilerSet);
+
+    IDownstreamCompiler* compiler = compilerSet->getCompiler(DownstreamCompilerDesc(SLANG_PASS_THROUGH_SPIRV_OPT));
+    if (!compiler)
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    // The SPIR-V to optimize
+    List<ComPtr<ISlangBlob>> inputCode;
+    String diagnostics;
+    _compile(globalSession, false, false, inputCode, diagnostics);
+
+    auto optimize = [&](ISlangBlob* spirv, ComPtr<ISlangBlob>& outOptimized)
+    {
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+        artifact->addRepresentationUnknown(spirv);
+
+        DownstreamCompileOptions options;
+        options.sourceArtifacts = makeSlice(artifact.readRef(), 1);
+        options.targetType = SLANG_SPIRV;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_SPIRV;
+        options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::High;
+
+        ComPtr<IArtifact> optimizedArtifact;
+        if (SLANG_SUCCEEDED(compiler->compile(options, optimizedArtifact.writeRef())))
+        {
+            optimizedArtifact->loadBlob(ArtifactKeep::No, outOptimized.writeRef());
+        }
+    };
+
+    List<ComPtr<ISlangBlob>> serialCode;
+    for (auto& spirv : inputCode)
+    {
+        ComPtr<ISlangBlob> optimized;
+        optimize(spirv, optimized);
+        SLANG_CHECK_ABORT(optimized);
+        serialCode.add(optimized);
+    }
+
+    // Each thread optimizes every entry point, such that the same inputs are being optimized at the same time
+    const Index threadCount = 4;
+    List<List<ComPtr<ISlangBlob>>> threadCode;
+    threadCode.setCount(threadCount);
+    List<std::thread> threads;
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        threads.add(std::thread([&, i]()
+            {
+                auto& code = threadCode[i];
+                code.setCount(inputCode.getCount());
+                for (Index j = 0; j < inputCode.getCount(); ++j)
+                {
+                    optimize(inputCode[j], code[j]);
+                }
+            }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& code : threadCode)
+    {
+        for (Index i = 0; i < serialCode.getCount(); ++i)
+        {
+            SLANG_CHECK(code[i] && _isSameBlob(serialCode[i], code[i]));
+        }
+    }
+}
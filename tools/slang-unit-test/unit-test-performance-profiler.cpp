@@ -0,0 +1,216 @@
+// unit-test-performance-profiler.cpp
+
+#include "../../source/core/slang-performance-profiler.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace Slang;
+
+static void _profiledInner()
+{
+    SLANG_PROFILE;
+}
+
+static void _profiledOuter()
+{
+    SLANG_PROFILE;
+    _profiledInner();
+    _profiledInner();
+}
+
+static Index _countOccurrences(UnownedStringSlice text, const UnownedStringSlice& find)
+{
+    Index count = 0;
+    for (Index pos = text.indexOf(find); pos >= 0; pos = text.indexOf(find))
+    {
+        count++;
+        text = text.tail(pos + find.getLength());
+    }
+    return count;
+}
+
+SLANG_UNIT_TEST(performanceProfiler)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+    profiler->setTraceEnabled(true);
+
+    _profiledOuter();
+    _profiledInner();
+
+    profiler->setTraceEnabled(false);
+
+    {
+        StringBuilder result;
+        profiler->getResult(result);
+
+        // The inner function is attributed to both the call stack through the outer function, and the top level.
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("Call tree:")) >= 0);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("  _profiledOuter \t1 \t")) >= 0);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("    _profiledInner \t2 \t")) >= 0);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("\n  _profiledInner \t1 \t")) >= 0);
+    }
+
+    {
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+
+        // There should be an event for each invocation
+        SLANG_CHECK(_countOccurrences(trace.getUnownedSlice(), UnownedStringSlice("\"ph\":\"X\"")) == 4);
+        SLANG_CHECK(trace.startsWith("{\"traceEvents\":["));
+    }
+
+    // After clearing nothing should be recorded
+    profiler->clear();
+    {
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+        SLANG_CHECK(trace.indexOf(UnownedStringSlice("_profiledInner")) < 0);
+    }
+}
+
+SLANG_UNIT_TEST(performanceProfilerThreads)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+    profiler->setTraceEnabled(true);
+
+    _profiledOuter();
+
+    // A thread that has exited before the results are read
+    std::thread exitedThread([]() { _profiledOuter(); });
+    exitedThread.join();
+
+    // A thread that is still running when the results are read
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isProfiled = false;
+    bool canExit = false;
+    std::thread runningThread([&]()
+        {
+            _profiledInner();
+            std::unique_lock<std::mutex> lock(mutex);
+            isProfiled = true;
+            condition.notify_all();
+            condition.wait(lock, [&]() { return canExit; });
+        });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return isProfiled; });
+    }
+
+    profiler->setTraceEnabled(false);
+
+    {
+        // The totals should include the invocations on every thread
+        List<FuncProfileTotal> totals;
+        profiler->getFuncTotals(totals);
+
+        int outerCount = 0;
+        int innerCount = 0;
+        for (const auto& total : totals)
+        {
+            if (UnownedStringSlice(total.funcName) == UnownedStringSlice("_profiledOuter"))
+                outerCount = total.info.invocationCount;
+            else if (UnownedStringSlice(total.funcName) == UnownedStringSlice("_profiledInner"))
+                innerCount = total.info.invocationCount;
+        }
+        SLANG_CHECK(outerCount == 2);
+        SLANG_CHECK(innerCount == 5);
+
+        // Call stacks that are the same on different threads are combined
+        StringBuilder result;
+        profiler->getResult(result);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("  _profiledOuter \t2 \t")) >= 0);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("    _profiledInner \t4 \t")) >= 0);
+        SLANG_CHECK(result.indexOf(UnownedStringSlice("\n  _profiledInner \t1 \t")) >= 0);
+    }
+
+    {
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+        SLANG_CHECK(_countOccurrences(trace.getUnownedSlice(), UnownedStringSlice("\"ph\":\"X\"")) == 7);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        canExit = true;
+        condition.notify_all();
+    }
+    runningThread.join();
+
+    // Clearing removes what every thread recorded
+    profiler->clear();
+    {
+        List<FuncProfileTotal> totals;
+        profiler->getFuncTotals(totals);
+        SLANG_CHECK(totals.getCount() == 0);
+    }
+}
+
+SLANG_UNIT_TEST(performanceProfilerConcurrentAccess)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+    profiler->setTraceEnabled(true);
+
+    // Threads keep recording whilst the results are read and cleared, such that reading and clearing
+    // happens in the middle of threads updating their data.
+    const int threadCount = 4;
+    const int callsPerThread = 20000;
+    std::atomic<int> callCount = 0;
+    List<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.add(std::thread([&]()
+            {
+                for (int j = 0; j < callsPerThread; ++j)
+                {
+                    _profiledOuter();
+                    callCount++;
+                }
+            }));
+    }
+
+    for (int i = 0; callCount < threadCount * callsPerThread; ++i)
+    {
+        List<FuncProfileTotal> totals;
+        profiler->getFuncTotals(totals);
+
+        int outerCount = 0;
+        int innerCount = 0;
+        for (const auto& total : totals)
+        {
+            if (UnownedStringSlice(total.funcName) == UnownedStringSlice("_profiledOuter"))
+                outerCount = total.info.invocationCount;
+            else if (UnownedStringSlice(total.funcName) == UnownedStringSlice("_profiledInner"))
+                innerCount = total.info.invocationCount;
+        }
+        // Each call to the outer function calls the inner function twice. The counts can only be off by
+        // the calls that are in progress on each thread, or were in progress when the data was cleared.
+        SLANG_CHECK(innerCount >= 2 * outerCount - 2 * threadCount && innerCount <= 2 * outerCount + 2 * threadCount);
+
+        StringBuilder trace;
+        profiler->getChromeTrace(trace);
+        SLANG_CHECK(trace.startsWith("{\"traceEvents\":["));
+
+        if (i % 10 == 0)
+        {
+            profiler->clear();
+        }
+        std::this_thread::yield();
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    profiler->setTraceEnabled(false);
+    profiler->clear();
+}
@@ -6,6 +6,8 @@
 #include "../../source/core/slang-file-system.h"
 #include "../../source/core/slang-random-generator.h"
 #include "../../source/core/slang-process.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-string-util.h"
 
 #include <chrono>
 #include <thread>
@@ -163,6 +165,33 @@ struct PersistentCacheTest
     {
         return cache->m_indexFileName;
     }
+
+    // Get the number of records in the index file, as seen by the cache.
+    Count getIndexRecordCount()
+    {
+        return cache->m_indexRecordCount;
+    }
+
+    // Checks that the in-memory index maps every entry, and that the LRU list runs through
+    // all of them.
+    bool isIndexConsistent()
+    {
+        if (cache->m_index.getCount() != cache->m_entryMap.getCount())
+            return false;
+        Count listCount = 0;
+        for (Index i = cache->m_leastRecentlyUsed; i >= 0; i = cache->m_index[i].next)
+        {
+            if (listCount++ >= cache->m_index.getCount())
+                return false;
+        }
+        return listCount == cache->m_index.getCount();
+    }
+
+    // Get the size the index file would have with `recordCount` records.
+    static size_t getIndexFileSize(Count recordCount)
+    {
+        return 24 + recordCount * sizeof(PersistentCache::IndexRecord);
+    }
 };
 
 } // namespace Slang
@@ -432,6 +461,147 @@ struct CorruptionTest : public PersistentCacheTest
     }
 };
 
+// Tests that multiple cache instances sharing the same directory see each others changes.
+// Each instance keeps its own in-memory copy of the index, just like separate processes would.
+struct SharedIndexTest : public PersistentCacheTest
+{
+    SharedIndexTest() : PersistentCacheTest(4) {}
+
+    RefPtr<PersistentCache> openCache()
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = 4;
+        return new PersistentCache(desc);
+    }
+
+    static bool readEntryFrom(PersistentCache* otherCache, const Entry& entry)
+    {
+        ComPtr<ISlangBlob> data;
+        SlangResult result = otherCache->readEntry(entry.key, data.writeRef());
+        if (result == SLANG_OK)
+        {
+            SLANG_CHECK(isBlobEqual(data, entry.data));
+        }
+        return result == SLANG_OK;
+    }
+
+    void run()
+    {
+        // Setup a list of entries to store in the cache.
+        List<Entry> entries;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            auto data = createRandomBlob(1024);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{ key, data });
+        }
+
+        auto otherCache = openCache();
+
+        // Entries written by one instance are visible to the other.
+        writeEntry(entries[0]);
+        writeEntry(entries[1]);
+        SLANG_CHECK(readEntryFrom(otherCache, entries[0]) == true);
+        SLANG_CHECK(readEntryFrom(otherCache, entries[1]) == true);
+        SLANG_CHECK(otherCache->writeEntry(entries[2].key, entries[2].data) == SLANG_OK);
+        SLANG_CHECK(readEntry(entries[2]) == true);
+        SLANG_CHECK(cache->getStats().entryCount == 3);
+        SLANG_CHECK(otherCache->getStats().entryCount == 3);
+
+        // Hits recorded by one instance are taken into account when the other one evicts.
+        // Entry 0 is the least recently used one, unless the hit below is lost.
+        SLANG_CHECK(readEntryFrom(otherCache, entries[0]) == true);
+        // Release the other instance, which writes back its pending accesses.
+        otherCache = nullptr;
+        writeEntry(entries[3]);
+        writeEntry(entries[4]);
+        SLANG_CHECK(readEntry(entries[0]) == true);
+        SLANG_CHECK(readEntry(entries[1]) == false);
+
+        // Eviction by one instance is seen by the other.
+        otherCache = openCache();
+        SLANG_CHECK(otherCache->getStats().entryCount == 4);
+        writeEntry(entries[5]);
+        SLANG_CHECK(readEntryFrom(otherCache, entries[2]) == false);
+        SLANG_CHECK(readEntryFrom(otherCache, entries[5]) == true);
+
+        // Clearing through one instance is seen by the other.
+        SLANG_CHECK(cache->clear() == SLANG_OK);
+        SLANG_CHECK(readEntryFrom(otherCache, entries[5]) == false);
+        SLANG_CHECK(otherCache->writeEntry(entries[6].key, entries[6].data) == SLANG_OK);
+        SLANG_CHECK(readEntry(entries[6]) == true);
+        SLANG_CHECK(readEntry(entries[5]) == false);
+    }
+};
+
+// Tests that the index file is appended to, and compacted once it grows too large.
+struct IndexJournalTest : public PersistentCacheTest
+{
+    IndexJournalTest() : PersistentCacheTest(4) {}
+
+    size_t getIndexFileSizeOnDisk()
+    {
+        FileStream fs;
+        SLANG_CHECK(fs.init(getIndexFilename(), FileMode::Open) == SLANG_OK);
+        fs.seek(SeekOrigin::End, 0);
+        return (size_t)fs.getPosition();
+    }
+
+    void run()
+    {
+        List<Entry> entries;
+        for (size_t i = 0; i < 6; ++i)
+        {
+            auto data = createRandomBlob(256);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{ key, data });
+        }
+
+        // Every write appends one record, and an eviction appends one more.
+        for (Index i = 0; i < 4; ++i)
+        {
+            writeEntry(entries[i]);
+            SLANG_CHECK(getIndexRecordCount() == i + 1);
+            SLANG_CHECK(getIndexFileSizeOnDisk() == getIndexFileSize(i + 1));
+        }
+        writeEntry(entries[4]);
+        SLANG_CHECK(getIndexRecordCount() == 6);
+
+        // Hits are only appended with the next write.
+        SLANG_CHECK(readEntry(entries[1]) == true);
+        SLANG_CHECK(getIndexRecordCount() == 6);
+        writeEntry(entries[5]);
+        SLANG_CHECK(getIndexRecordCount() == 9);
+        SLANG_CHECK(getIndexFileSizeOnDisk() == getIndexFileSize(9));
+
+        // Rewriting the same entries keeps appending, until the index is compacted down to
+        // one record per entry. The LRU order survives the compaction.
+        Count maxRecordCount = 0;
+        for (Index i = 0; i < 400; ++i)
+        {
+            writeEntry(entries[2 + i % 4]);
+            SLANG_CHECK(getIndexRecordCount() <= 2 * 4 + 256);
+            if (getIndexRecordCount() > maxRecordCount)
+                maxRecordCount = getIndexRecordCount();
+        }
+        SLANG_CHECK(maxRecordCount > 200);
+        SLANG_CHECK(getIndexRecordCount() < maxRecordCount);
+        writeEntry(entries[0]);
+        SLANG_CHECK(readEntry(entries[2]) == false);
+        SLANG_CHECK(readEntry(entries[3]) == true);
+        SLANG_CHECK(readEntry(entries[4]) == true);
+        SLANG_CHECK(readEntry(entries[5]) == true);
+
+        // Another instance reads the compacted index.
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = 4;
+        RefPtr<PersistentCache> otherCache = new PersistentCache(desc);
+        SLANG_CHECK(otherCache->getStats().entryCount == 4);
+    }
+};
+
 #undef ENABLE_LOGGING 
 #undef ENABLE_WRITE_TEST
 
@@ -586,6 +756,103 @@ struct StressTest : public PersistentCacheTest
     }
 };
 
+// Multi-process stress testing.
+// This test spawns a number of `test-process persistent-cache` processes, which read a shared
+// pool of entries from one cache directory concurrently, and write the entries they miss. The
+// cache holds fewer entries than the pool, so the processes keep evicting each other's entries,
+// and the index journal is compacted several times while they run. Each process checks the data
+// of every hit against its key. Afterwards, the index must still be consistent and hold no more
+// entries than the limit.
+struct MultiProcessStressTest : public PersistentCacheTest
+{
+    // Number of concurrent processes.
+    static const int kProcessCount = 8;
+    // Number of entries in the pool the processes share. Must match how `test-process`
+    // generates them.
+    static const int kEntryCount = 200;
+    // Number of entries the cache can hold.
+    static const int kMaxEntryCount = 100;
+    // Number of reads (and writes on misses) per process.
+    static const int kOperationCount = 500;
+
+    MultiProcessStressTest() : PersistentCacheTest(kMaxEntryCount) {}
+
+    static Entry createEntry(int32_t entryIndex)
+    {
+        RefPtr<RandomGenerator> entryRand = RandomGenerator::create(entryIndex);
+        List<Byte> data;
+        data.setCount(entryRand->nextInt32InRange(64, 4096));
+        entryRand->nextData(data.getBuffer(), size_t(data.getCount()));
+        auto key = SHA1::compute(data.getBuffer(), size_t(data.getCount()));
+        return Entry{ key, RawBlob::create(data.getBuffer(), size_t(data.getCount())) };
+    }
+
+    void run(UnitTestContext* context)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        List<RefPtr<Process>> processes;
+        for (int processIndex = 0; processIndex < kProcessCount; ++processIndex)
+        {
+            CommandLine cmdLine;
+            cmdLine.setExecutableLocation(ExecutableLocation(context->executableDirectory, "test-process"));
+            cmdLine.addArg("persistent-cache");
+            cmdLine.addArg(cacheDirectory);
+            cmdLine.addArg(String(kMaxEntryCount));
+            cmdLine.addArg(String(processIndex));
+            cmdLine.addArg(String(kEntryCount));
+            cmdLine.addArg(String(kOperationCount));
+
+            RefPtr<Process> process;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Process::create(cmdLine, 0, process)));
+            processes.add(process);
+        }
+
+        Index hitCount = 0;
+        Index missCount = 0;
+        for (auto& process : processes)
+        {
+            ExecuteResult exeRes;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(ProcessUtil::readUntilTermination(process, exeRes)));
+            SLANG_CHECK(exeRes.resultCode == 0);
+
+            List<UnownedStringSlice> counts;
+            StringUtil::splitOnWhitespace(exeRes.standardOutput.getUnownedSlice(), counts);
+            SLANG_CHECK_ABORT(counts.getCount() == 2);
+            Index processHitCount = 0;
+            Index processMissCount = 0;
+            SLANG_CHECK(SLANG_SUCCEEDED(StringUtil::parseInt(counts[0], processHitCount)));
+            SLANG_CHECK(SLANG_SUCCEEDED(StringUtil::parseInt(counts[1], processMissCount)));
+            SLANG_CHECK(processHitCount + processMissCount == kOperationCount);
+            hitCount += processHitCount;
+            missCount += processMissCount;
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto seconds = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0;
+        LOG("Total time: %.3fs\n", seconds);
+        LOG("Operations per second: %.0f\n", (kProcessCount * kOperationCount) / seconds);
+        LOG("Hits: %d, misses: %d\n", int(hitCount), int(missCount));
+
+        // Both hits and evictions must have happened for the test to have stressed anything.
+        SLANG_CHECK(hitCount > 0);
+        SLANG_CHECK(missCount > kMaxEntryCount);
+
+        // The index this instance reads back is consistent, within the limit, and only
+        // refers to entries with intact data.
+        Count foundCount = 0;
+        for (int32_t entryIndex = 0; entryIndex < kEntryCount; ++entryIndex)
+        {
+            if (readEntry(createEntry(entryIndex)))
+                foundCount++;
+        }
+        SLANG_CHECK(foundCount > 0);
+        SLANG_CHECK(foundCount <= kMaxEntryCount);
+        SLANG_CHECK(cache->getStats().entryCount <= kMaxEntryCount);
+        SLANG_CHECK(isIndexConsistent());
+    }
+};
+
 SLANG_UNIT_TEST(persistentCacheBasic)
 {
     BasicTest test;
@@ -604,6 +871,18 @@ SLANG_UNIT_TEST(persistentCacheCorruption)
     test.run();
 }
 
+SLANG_UNIT_TEST(persistentCacheSharedIndex)
+{
+    SharedIndexTest test;
+    test.run();
+}
+
+SLANG_UNIT_TEST(persistentCacheIndexJournal)
+{
+    IndexJournalTest test;
+    test.run();
+}
+
 SLANG_UNIT_TEST(persistentCacheStress)
 {
     // aarch64 builds currently fail to run multi-threaded tests within the test-server.
@@ -614,3 +893,9 @@ SLANG_UNIT_TEST(persistentCacheStress)
     StressTest test;
     test.run();
 }
+
+SLANG_UNIT_TEST(persistentCacheMultiProcessStress)
+{
+    MultiProcessStressTest test;
+    test.run(unitTestContext);
+}
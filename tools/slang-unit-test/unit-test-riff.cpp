@@ -6,6 +6,9 @@
 
 #include "tools/unit-test/slang-unit-test.h"
 
+#include "slang.h"
+#include "slang-com-ptr.h"
+
 using namespace Slang;
 
 static void _writeRandom(RandomGenerator* rand, size_t maxSize, RiffContainer& ioContainer, List<uint8_t>& ioData)
@@ -33,6 +36,39 @@ static void _writeRandom(RandomGenerator* rand, size_t maxSize, RiffContainer& i
     SLANG_ASSERT(dataChunk);
 }
 
+struct PayloadOwnershipCounts
+{
+    Index notOwnedCount = 0;
+    Index copiedCount = 0;
+};
+
+static SlangResult _countPayloadOwnership(RiffContainer::Chunk* chunk, void* data)
+{
+    auto counts = (PayloadOwnershipCounts*)data;
+    if (auto dataChunk = as<RiffContainer::DataChunk>(chunk))
+    {
+        for (auto payload = dataChunk->m_dataList; payload; payload = payload->m_next)
+        {
+            if (payload->getOwnership() == RiffContainer::Ownership::NotOwned)
+                counts->notOwnedCount++;
+            else
+                counts->copiedCount++;
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// Read `stream` in place (from 8 byte aligned memory), and count how payloads are held
+static SlangResult _readBufferInPlace(OwnedMemoryStream& stream, List<uint64_t>& outBuffer, RiffContainer& outContainer, PayloadOwnershipCounts& outCounts)
+{
+    const size_t size = size_t(stream.getContents().getCount());
+    outBuffer.setCount(Index((size + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+    ::memcpy(outBuffer.getBuffer(), stream.getContents().getBuffer(), size);
+
+    SLANG_RETURN_ON_FAIL(RiffUtil::readBuffer(outBuffer.getBuffer(), size, outContainer));
+    return outContainer.getRoot()->visitPreOrder(_countPayloadOwnership, &outCounts);
+}
+
 SLANG_UNIT_TEST(riff)
 {
     typedef RiffContainer::ScopeChunk ScopeChunk;
@@ -107,6 +143,34 @@ SLANG_UNIT_TEST(riff)
                 // They should be the same
                 SLANG_CHECK(readBuilder == builder);
             }
+
+            // Reading in place from memory should produce the same structure
+            {
+                OwnedMemoryStream stream(FileAccess::ReadWrite);
+                SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(container.getRoot(), true, &stream)));
+
+                const size_t size = size_t(stream.getContents().getCount());
+
+                List<uint64_t> buffer;
+                RiffContainer readContainer;
+                PayloadOwnershipCounts counts;
+                SLANG_CHECK(SLANG_SUCCEEDED(_readBufferInPlace(stream, buffer, readContainer, counts)));
+
+                // The writer aligns every payload, so none of them should have been copied
+                SLANG_CHECK(counts.notOwnedCount == 3);
+                SLANG_CHECK(counts.copiedCount == 0);
+
+                StringBuilder readBuilder;
+                {
+                    StringWriter writer(&readBuilder, 0);
+                    RiffUtil::dump(readContainer.getRoot(), &writer);
+                }
+                SLANG_CHECK(readBuilder == builder);
+
+                // A truncated buffer must fail
+                RiffContainer truncatedContainer;
+                SLANG_CHECK(SLANG_FAILED(RiffUtil::readBuffer(buffer.getBuffer(), size - 1, truncatedContainer)));
+            }
         }
 
     }
@@ -177,3 +241,41 @@ SLANG_UNIT_TEST(riff)
 #endif
 }
 
+// Serialized modules are read in place, so check none of the payloads of a real module are copied
+SLANG_UNIT_TEST(riffModuleInPlace)
+{
+    const char* moduleSource = R"(
+        struct Thing
+        {
+            float4 value;
+            int count;
+        };
+
+        float4 scale(Thing thing, float s)
+        {
+            return thing.value * s + float(thing.count);
+        }
+        )";
+
+    ComPtr<slang::ISession> session;
+    slang::SessionDesc sessionDesc = {};
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(unitTestContext->slangGlobalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSourceString("thing", "thing.slang", moduleSource, diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<ISlangBlob> moduleBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+
+    OwnedMemoryStream stream(FileAccess::ReadWrite);
+    stream.write(moduleBlob->getBufferPointer(), moduleBlob->getBufferSize());
+
+    List<uint64_t> buffer;
+    RiffContainer container;
+    PayloadOwnershipCounts counts;
+    SLANG_CHECK(SLANG_SUCCEEDED(_readBufferInPlace(stream, buffer, container, counts)));
+
+    SLANG_CHECK(counts.notOwnedCount > 0);
+    SLANG_CHECK(counts.copiedCount == 0);
+}
@@ -14,6 +14,8 @@
 
 #include "../../source/core/slang-test-tool-util.h"
 #include "../../source/core/slang-http.h"
+#include "../../source/core/slang-persistent-cache.h"
+#include "../../source/core/slang-random-generator.h"
 
 namespace TestProcess
 {
@@ -157,6 +159,74 @@ static SlangResult _httpReflect(int argc, const char* const* argv)
     return SLANG_OK;
 }
 
+// Reads and writes random entries of a pool shared with other processes in the same
+// persistent cache. Used to stress the cache index across processes.
+//
+// persistent-cache <directory> <max entry count> <process index> <entry count> <operation count>
+//
+// Entry `i` of the pool holds data generated from the seed `i`, and its key is the hash of
+// the data, so that any process can check what it reads. Outputs the number of hits and
+// misses.
+static SlangResult _persistentCache(int argc, const char* const* argv)
+{
+    if (argc < 7)
+    {
+        return SLANG_FAIL;
+    }
+    PersistentCache::Desc desc;
+    desc.directory = argv[2];
+    desc.maxEntryCount = stringToInt(argv[3]);
+    const int32_t processIndex = int32_t(stringToInt(argv[4]));
+    const int32_t entryCount = int32_t(stringToInt(argv[5]));
+    const Index operationCount = stringToInt(argv[6]);
+    if (entryCount <= 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    RefPtr<PersistentCache> cache = new PersistentCache(desc);
+    RefPtr<RandomGenerator> rand = RandomGenerator::create(processIndex + 1);
+
+    Index hitCount = 0;
+    Index missCount = 0;
+    for (Index i = 0; i < operationCount; ++i)
+    {
+        const int32_t entryIndex = rand->nextInt32UpTo(entryCount);
+
+        RefPtr<RandomGenerator> entryRand = RandomGenerator::create(entryIndex);
+        List<Byte> data;
+        data.setCount(entryRand->nextInt32InRange(64, 4096));
+        entryRand->nextData(data.getBuffer(), size_t(data.getCount()));
+        const auto key = SHA1::compute(data.getBuffer(), size_t(data.getCount()));
+
+        ComPtr<ISlangBlob> readData;
+        const SlangResult readResult = cache->readEntry(key, readData.writeRef());
+        if (readResult == SLANG_OK)
+        {
+            // The entry must not have been torn by a concurrent write or eviction.
+            if (SHA1::compute(readData->getBufferPointer(), readData->getBufferSize()) != key)
+            {
+                return SLANG_FAIL;
+            }
+            hitCount++;
+        }
+        else if (readResult == SLANG_E_NOT_FOUND)
+        {
+            SLANG_RETURN_ON_FAIL(cache->writeEntry(key, RawBlob::create(data.getBuffer(), size_t(data.getCount()))));
+            missCount++;
+        }
+        else
+        {
+            return readResult;
+        }
+    }
+
+    StringBuilder buf;
+    buf << hitCount << " " << missCount << "\n";
+    fwrite(buf.getBuffer(), 1, buf.getLength(), stdout);
+    return SLANG_OK;
+}
+
 static SlangResult execute(int argc, const char*const* argv)
 {
     if (argc < 2)
@@ -178,6 +248,10 @@ static SlangResult execute(int argc, const char*const* argv)
     {
         return _httpReflect(argc, argv);
     }
+    else if (toolName == "persistent-cache")
+    {
+        return _persistentCache(argc, argv);
+    }
     return SLANG_E_NOT_AVAILABLE;
 }
 